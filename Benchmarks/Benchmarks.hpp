@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Core/Time.hpp"
+#include "Core/Logger.hpp"
+
+/// <summary>
+/// Timings for the engine's hot paths, run once from the first frame with every system up, results are written to the log.
+/// Every benchmark also checks its output against a plain reference, a faster path that changes the results counts as a failure
+/// </summary>
+class Benchmarks
+{
+public:
+	static void Run();
+	static U32 Failures();
+
+private:
+	/// <summary>
+	/// Calls function repeats times
+	/// </summary>
+	/// <returns>The fastest call in milliseconds</returns>
+	template<class Function>
+	static F64 Measure(U32 repeats, Function&& function);
+
+	/// <summary>
+	/// Logs what and counts a failure if passed is false
+	/// </summary>
+	static bool Check(bool passed, const C8* what);
+
+	static void Events();
+	static void Query();
+	static void Commands();
+	static void Spawn();
+	static void Transforms();
+	static void Uploads();
+	static void Projectiles();
+	static void ParticlePools();
+	static void TileUploads();
+	static void Broadphase();
+	static void ColliderScan();
+	static void CollisionFilters();
+	static void ContactEvents();
+	static void Bodies();
+	static void BodyThreads();
+	static void TileCollision();
+	static void Contours();
+	static void Raycasts();
+	static void Sweeps();
+	static void TilemapFiles();
+	static void Paths();
+	static void FlowFields();
+	static void Sight();
+
+	static U32 failures;
+
+	STATIC_CLASS(Benchmarks);
+};
+
+template<class Function>
+inline F64 Benchmarks::Measure(U32 repeats, Function&& function)
+{
+	F64 best = F64_MAX;
+
+	for (U32 i = 0; i < repeats; ++i)
+	{
+		F64 start = Time::AbsoluteTime();
+		function();
+		F64 elapsed = Time::AbsoluteTime() - start;
+
+		best = elapsed < best ? elapsed : best;
+	}
+
+	return best * 1000.0;
+}
\ No newline at end of file
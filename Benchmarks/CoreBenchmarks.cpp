@@ -0,0 +1,132 @@
+#include "Benchmarks.hpp"
+
+#include "Core/Events.hpp"
+#include "Containers/Pair.hpp"
+
+#include <functional>
+
+void Benchmarks::Events()
+{
+	constexpr U32 Subscribers = 8;
+	constexpr U32 Invocations = 1000000;
+	constexpr U32 Churn = 64;
+	constexpr U32 ChurnRounds = 10000;
+
+	//Removing subscribers, the first one included, has to leave the rest firing in the order they were added
+	{
+		Vector<U64> fired;
+		Event<U32> event;
+		EventHandle handles[10];
+
+		//One closure type for every subscriber, operator-= matches on the function and the captured state
+		auto record = [&fired](U64 id)
+		{
+			Vector<U64>* out = &fired;
+			return [out, id](U32) { out->Push(id); return false; };
+		};
+
+		for (U64 i = 0; i < 10; ++i) { handles[i] = event.Subscribe(record(i)); }
+
+		event -= record(7);
+		event.Unsubscribe(handles[0]);
+		event.Unsubscribe(handles[4]);
+		event(0);
+
+		constexpr U64 Expected[]{ 1, 2, 3, 5, 6, 8, 9 };
+
+		bool ordered = fired.Size() == CountOf(Expected);
+		for (U64 i = 0; ordered && i < CountOf(Expected); ++i) { ordered = fired[i] == Expected[i]; }
+
+		Check(ordered, "Unsubscribing keeps the remaining subscribers in the order they were added");
+	}
+
+	U64 total = 0;
+	U64* sum = &total;
+
+	//Every subscriber adds its own multiple of the argument so a skipped or repeated call changes the sum
+	Event<U32> event;
+	Vector<std::function<bool(U32)>> functions(Subscribers);
+	for (U64 i = 0; i < Subscribers; ++i)
+	{
+		event += [sum, i](U32 value) { *sum += value * (i + 1); return false; };
+		functions.Push([sum, i](U32 value) { *sum += value * (i + 1); return false; });
+	}
+
+	F64 eventTime = Measure(5, [&]
+	{
+		*sum = 0;
+		for (U32 i = 0; i < Invocations; ++i) { event(i); }
+	});
+
+	U64 eventSum = *sum;
+
+	F64 functionTime = Measure(5, [&]
+	{
+		*sum = 0;
+		for (U32 i = 0; i < Invocations; ++i)
+		{
+			for (const std::function<bool(U32)>& function : functions)
+			{
+				if (function(i)) { break; }
+			}
+		}
+	});
+
+	Check(eventSum == *sum, "An event calls every subscriber exactly as a std::function list does");
+
+	//A single subscriber is stored inline in the event
+	Event<U32> single;
+	single += [sum](U32 value) { *sum += value; return false; };
+	std::function<bool(U32)> singleFunction = [sum](U32 value) { *sum += value; return false; };
+
+	F64 singleTime = Measure(5, [&] { for (U32 i = 0; i < Invocations; ++i) { single(i); } });
+	F64 singleFunctionTime = Measure(5, [&] { for (U32 i = 0; i < Invocations; ++i) { singleFunction(i); } });
+
+	//Subscribe a batch then unsubscribe it oldest first, like listeners registered on load and dropped on unload
+	Event<U32> churned;
+	Vector<EventHandle> handles(Churn);
+	U64 remaining = 0;
+
+	F64 subscribeTime = Measure(1, [&]
+	{
+		for (U32 round = 0; round < ChurnRounds; ++round)
+		{
+			handles.Clear();
+			for (U64 i = 0; i < Churn; ++i) { handles.Push(churned.Subscribe([sum, i](U32 value) { *sum += value * i; return false; })); }
+			for (EventHandle handle : handles) { churned.Unsubscribe(handle); }
+		}
+
+		remaining += churned.InvocationSize();
+	});
+
+	Vector<Pair<EventHandle, std::function<bool(U32)>>> churnedFunctions(Churn);
+	EventHandle nextHandle = 0;
+
+	F64 subscribeFunctionTime = Measure(1, [&]
+	{
+		for (U32 round = 0; round < ChurnRounds; ++round)
+		{
+			handles.Clear();
+			for (U64 i = 0; i < Churn; ++i)
+			{
+				handles.Push(++nextHandle);
+				churnedFunctions.Push({ nextHandle, [sum, i](U32 value) { *sum += value * i; return false; } });
+			}
+
+			for (EventHandle handle : handles)
+			{
+				for (U64 i = 0; i < churnedFunctions.Size(); ++i)
+				{
+					if (churnedFunctions[i].a == handle) { churnedFunctions.Remove(i); break; }
+				}
+			}
+		}
+
+		remaining += churnedFunctions.Size();
+	});
+
+	Check(remaining == 0, "Every subscription is removed by its handle");
+
+	Logger::Info("Event<U32>, ", Subscribers, " Subscribers, ", Invocations, " Invocations: Event ", eventTime, "ms, std::function Vector ", functionTime, "ms, One Subscriber ",
+		singleTime, "ms vs ", singleFunctionTime, "ms, ", ChurnRounds, " Rounds Of ", Churn, " Subscribe And Unsubscribe ", subscribeTime, "ms vs ", subscribeFunctionTime, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Benchmarks.hpp"
+
+#include "Engine.hpp"
+
+#include "Resources/World.hpp"
+#include "Resources/SpriteComponent.hpp"
+#include "Resources/ProjectileComponent.hpp"
+#include "Resources/TilemapComponent.hpp"
+#include "Resources/TilemapColliderComponent.hpp"
+
+U32 Benchmarks::failures = 0;
+
+void Benchmarks::Run()
+{
+	Logger::Info("Running Benchmarks...");
+
+	Events();
+	Query();
+	Commands();
+	Spawn();
+	Transforms();
+	Uploads();
+	Projectiles();
+	ParticlePools();
+	TileUploads();
+	Broadphase();
+	ColliderScan();
+	CollisionFilters();
+	ContactEvents();
+	Bodies();
+	BodyThreads();
+	TileCollision();
+	Contours();
+	Raycasts();
+	Sweeps();
+	TilemapFiles();
+	Paths();
+	FlowFields();
+	Sight();
+
+	if (failures) { Logger::Error(failures, " Benchmark Checks Failed!"); }
+	else { Logger::Info("All Benchmark Checks Passed"); }
+}
+
+U32 Benchmarks::Failures()
+{
+	return failures;
+}
+
+bool Benchmarks::Check(bool passed, const C8* what)
+{
+	if (!passed)
+	{
+		Logger::Error("Benchmark Check Failed: ", what);
+		++failures;
+	}
+
+	return passed;
+}
+
+void ComponentsInit()
+{
+	World::RegisterComponent<Projectile>();
+	World::RegisterComponent<Sprite>();
+	World::RegisterComponent<Tilemap>();
+	World::RegisterComponent<TilemapCollider>();
+}
+
+bool Initialize()
+{
+	return true;
+}
+
+void Shutdown()
+{
+
+}
+
+void Update()
+{
+	Benchmarks::Run();
+	Engine::Quit();
+}
+
+int main()
+{
+	GameInfo game{
+		.name = "Nihility Benchmarks",
+		.version = MakeVersionNumber(0, 1, 0),
+		.componentsInit = ComponentsInit,
+		.initialize = Initialize,
+		.shutdown = Shutdown,
+		.update = Update,
+	};
+
+	Engine::Initialize(game);
+
+	return Benchmarks::Failures() ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,833 @@
+#include "Benchmarks.hpp"
+
+#include "Resources/TileGrid.hpp"
+#include "Math/Pathfinding.hpp"
+#include "Math/FlowField.hpp"
+#include "Math/Visibility.hpp"
+#include "Math/Random.hpp"
+#include "Multithreading/Jobs.hpp"
+#include "Containers/Pair.hpp"
+
+static constexpr F32 DiagonalCost = 1.41421356f;
+
+//Round blobs of rock with long walls through them, the same map every run for a seed
+static void AddObstacles(TileGrid& tiles, I32 width, I32 height, U32 seed, F32 density)
+{
+	tiles.Create({ width, height });
+	Random::SeedRandom(seed);
+
+	U64 blobs = (U64)((F64)width * height * density / 40.0);
+	for (U64 i = 0; i < blobs; ++i)
+	{
+		I32 centerX = (I32)(Random::RandomUniform() * width);
+		I32 centerY = (I32)(Random::RandomUniform() * height);
+		I32 radius = 1 + (I32)(Random::RandomUniform() * 4);
+
+		for (I32 y = centerY - radius; y <= centerY + radius; ++y)
+		{
+			for (I32 x = centerX - radius; x <= centerX + radius; ++x)
+			{
+				if ((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY) <= radius * radius) { tiles.Set(x, y, TileType::Full); }
+			}
+		}
+	}
+
+	U64 walls = (U64)width * height / 4000;
+	for (U64 i = 0; i < walls; ++i)
+	{
+		I32 x = (I32)(Random::RandomUniform() * width);
+		I32 y = (I32)(Random::RandomUniform() * height);
+		I32 length = 20 + (I32)(Random::RandomUniform() * 200);
+		bool horizontal = Random::RandomUniform() < 0.5;
+
+		for (I32 j = 0; j < length; ++j) { tiles.Set(horizontal ? x + j : x, horizontal ? y : y + j, TileType::Full); }
+	}
+
+	tiles.CleanChunks();
+}
+
+static Vector2Int RandomAir(const TileGrid& tiles)
+{
+	const Vector2Int& dimensions = tiles.Dimensions();
+
+	while (true)
+	{
+		Vector2Int tile{ (I32)(Random::RandomUniform() * dimensions.x), (I32)(Random::RandomUniform() * dimensions.y) };
+		if (tiles.Get(tile.x, tile.y) == TileType::Air) { return tile; }
+	}
+}
+
+static bool Blocked(const TileGrid& tiles, I32 x, I32 y)
+{
+	const Vector2Int& dimensions = tiles.Dimensions();
+	return (U32)x >= (U32)dimensions.x || (U32)y >= (U32)dimensions.y || tiles.Get(x, y) != TileType::Air;
+}
+
+//Reference, Dijkstra from source over every tile with a binary heap, eight directions without cutting the corners of solid tiles
+static void ReferenceDistances(const TileGrid& tiles, const Vector2Int& source, Vector<F32>& distances, Vector<Pair<F32, U32>>& heap)
+{
+	const Vector2Int& dimensions = tiles.Dimensions();
+	U64 count = (U64)dimensions.x * dimensions.y;
+
+	distances.Resize(count, Traits<F32>::Infinity);
+	heap.Clear();
+
+	auto push = [&](F32 distance, U32 tile)
+	{
+		U64 i = heap.Size();
+		heap.Push({ distance, tile });
+
+		while (i && heap[(i - 1) / 2].a > heap[i].a)
+		{
+			Swap(heap[(i - 1) / 2], heap[i]);
+			i = (i - 1) / 2;
+		}
+	};
+
+	auto pop = [&]
+	{
+		Pair<F32, U32> top = heap[0];
+		Pair<F32, U32> last;
+		heap.Pop(last);
+
+		if (heap.Size())
+		{
+			heap[0] = last;
+
+			U64 i = 0;
+			while (true)
+			{
+				U64 smallest = i;
+				U64 left = i * 2 + 1;
+				U64 right = left + 1;
+				if (left < heap.Size() && heap[left].a < heap[smallest].a) { smallest = left; }
+				if (right < heap.Size() && heap[right].a < heap[smallest].a) { smallest = right; }
+				if (smallest == i) { break; }
+
+				Swap(heap[i], heap[smallest]);
+				i = smallest;
+			}
+		}
+
+		return top;
+	};
+
+	if (Blocked(tiles, source.x, source.y)) { return; }
+
+	U32 first = (U32)(source.x + source.y * dimensions.x);
+	distances[first] = 0.0f;
+	push(0.0f, first);
+
+	while (heap.Size())
+	{
+		Pair<F32, U32> entry = pop();
+		if (entry.a > distances[entry.b]) { continue; }
+
+		I32 x = (I32)(entry.b % dimensions.x);
+		I32 y = (I32)(entry.b / dimensions.x);
+
+		for (I32 dy = -1; dy <= 1; ++dy)
+		{
+			for (I32 dx = -1; dx <= 1; ++dx)
+			{
+				if ((!dx && !dy) || Blocked(tiles, x + dx, y + dy)) { continue; }
+				if (dx && dy && (Blocked(tiles, x + dx, y) || Blocked(tiles, x, y + dy))) { continue; }
+
+				F32 distance = entry.a + (dx && dy ? DiagonalCost : 1.0f);
+				U32 next = (U32)(x + dx + (y + dy) * dimensions.x);
+
+				if (distance < distances[next])
+				{
+					distances[next] = distance;
+					push(distance, next);
+				}
+			}
+		}
+	}
+}
+
+//Cost of walking path tile by tile, negative if it doesn't run from start to goal, leaves a straight or diagonal line, enters a solid tile or cuts a corner
+static F32 PathCost(const TileGrid& tiles, const Vector<Vector2Int>& path, const Vector2Int& start, const Vector2Int& goal)
+{
+	if (path.Empty() || path[0] != start || path[path.Size() - 1] != goal) { return -1.0f; }
+
+	F32 cost = 0.0f;
+	for (U64 i = 1; i < path.Size(); ++i)
+	{
+		Vector2Int delta = path[i] - path[i - 1];
+		I32 steps = Math::Max(Math::Abs(delta.x), Math::Abs(delta.y));
+		if (!steps || (delta.x && delta.y && Math::Abs(delta.x) != Math::Abs(delta.y))) { return -1.0f; }
+
+		I32 stepX = (delta.x > 0) - (delta.x < 0);
+		I32 stepY = (delta.y > 0) - (delta.y < 0);
+		Vector2Int tile = path[i - 1];
+
+		for (I32 j = 0; j < steps; ++j)
+		{
+			if (stepX && stepY && (Blocked(tiles, tile.x + stepX, tile.y) || Blocked(tiles, tile.x, tile.y + stepY))) { return -1.0f; }
+
+			tile.x += stepX;
+			tile.y += stepY;
+			if (Blocked(tiles, tile.x, tile.y)) { return -1.0f; }
+
+			cost += stepX && stepY ? DiagonalCost : 1.0f;
+		}
+	}
+
+	return cost;
+}
+
+//Reference, symmetric shadowcasting written out a tile at a time, marks what a viewer sees in a square reaching radius tiles around it
+struct ReferenceSight
+{
+	const TileGrid* tiles;
+	Vector2Int origin;
+	I32 radius;
+	U8 quadrant;
+	Vector<U8> visible;
+};
+
+static I32 FloorDivide(I32 numerator, I32 denominator)
+{
+	return numerator / denominator - (numerator % denominator != 0 && (numerator < 0) != (denominator < 0));
+}
+
+static Vector2Int QuadrantTile(const ReferenceSight& sight, I32 depth, I32 column)
+{
+	switch (sight.quadrant)
+	{
+	case 0: return { sight.origin.x + column, sight.origin.y + depth };
+	case 1: return { sight.origin.x + column, sight.origin.y - depth };
+	case 2: return { sight.origin.x + depth, sight.origin.y + column };
+	default: return { sight.origin.x - depth, sight.origin.y + column };
+	}
+}
+
+static void ReferenceScan(ReferenceSight& sight, I32 depth, Pair<I32, I32> start, Pair<I32, I32> end)
+{
+	if (depth > sight.radius) { return; }
+
+	const Vector2Int& dimensions = sight.tiles->Dimensions();
+	I32 size = sight.radius * 2 + 1;
+	I32 first = FloorDivide(2 * depth * start.a + start.b, 2 * start.b);
+	I32 last = -FloorDivide(-(2 * depth * end.a - end.b), 2 * end.b);
+	I32 previous = -1;
+
+	for (I32 column = first; column <= last; ++column)
+	{
+		Vector2Int tile = QuadrantTile(sight, depth, column);
+		I32 wall = Blocked(*sight.tiles, tile.x, tile.y);
+		bool symmetric = column * start.b >= depth * start.a && column * end.b <= depth * end.a;
+
+		bool inside = (U32)tile.x < (U32)dimensions.x && (U32)tile.y < (U32)dimensions.y;
+
+		if (inside && (wall || symmetric) && column * column + depth * depth <= sight.radius * sight.radius)
+		{
+			sight.visible[(tile.x - sight.origin.x + sight.radius) + (tile.y - sight.origin.y + sight.radius) * size] = 1;
+		}
+
+		if (previous == 1 && !wall) { start = { 2 * column - 1, 2 * depth }; }
+		if (previous == 0 && wall) { ReferenceScan(sight, depth + 1, start, { 2 * column - 1, 2 * depth }); }
+		previous = wall;
+	}
+
+	if (previous == 0) { ReferenceScan(sight, depth + 1, start, end); }
+}
+
+static void ReferenceCast(ReferenceSight& sight)
+{
+	I32 size = sight.radius * 2 + 1;
+	sight.visible.Resize((U64)size * size, 0);
+	sight.visible[sight.radius + sight.radius * size] = 1;
+
+	for (U8 quadrant = 0; quadrant < 4; ++quadrant)
+	{
+		sight.quadrant = quadrant;
+		ReferenceScan(sight, 1, { -1, 1 }, { 1, 1 });
+	}
+}
+
+//Tiles in the square around the reference viewer that the two casts disagree on
+static U32 SightMismatches(const ReferenceSight& sight, const Visibility& visibility, U32 viewer)
+{
+	const Vector2Int& dimensions = sight.tiles->Dimensions();
+	I32 size = sight.radius * 2 + 1;
+	U32 count = 0;
+
+	for (I32 y = 0; y < size; ++y)
+	{
+		for (I32 x = 0; x < size; ++x)
+		{
+			Vector2Int tile{ sight.origin.x - sight.radius + x, sight.origin.y - sight.radius + y };
+			if ((U32)tile.x >= (U32)dimensions.x || (U32)tile.y >= (U32)dimensions.y) { continue; }
+
+			count += (sight.visible[x + y * size] != 0) != visibility.Sees(viewer, tile);
+		}
+	}
+
+	return count;
+}
+
+void Benchmarks::Paths()
+{
+	constexpr I32 CheckedSize = 512;
+	constexpr U32 Sources = 24;
+	constexpr U32 GoalsPerSource = 24;
+	constexpr I32 ShortRoute = 64;
+	constexpr I32 Sizes[] = { 1024, 8192 };
+	constexpr U32 PathCounts[] = { 2000, 200 };
+
+	Vector<F32> distances;
+	Vector<Pair<F32, U32>> heap;
+	Vector<Vector2Int> path;
+
+	//Every path is walked and costed against the reference, before and after explosions are repaired
+	{
+		TileGrid tiles;
+		AddObstacles(tiles, CheckedSize, CheckedSize, CheckedSize, 0.3f);
+		U32 grid = Pathfinding::AddGrid(&tiles);
+
+		U32 wrong = 0;
+		U32 invalid = 0;
+		U32 jumpNonOptimal = 0;
+		U32 shortRoutes = 0;
+		U32 optimalShort = 0;
+		U32 longRoutes = 0;
+		F64 longRatio = 0.0;
+		F64 worstRatio = 1.0;
+
+		Pathfinding::SearchScratch scratch;
+
+		auto check = [&]
+		{
+			for (U32 i = 0; i < Sources; ++i)
+			{
+				Vector2Int start = RandomAir(tiles);
+				ReferenceDistances(tiles, start, distances, heap);
+
+				for (U32 j = 0; j < GoalsPerSource; ++j)
+				{
+					Vector2Int goal = RandomAir(tiles);
+					F32 expected = distances[goal.x + goal.y * CheckedSize];
+
+					bool found = Pathfinding::FindPath(grid, start, goal, path);
+					if (found != (expected != Traits<F32>::Infinity)) { ++wrong; continue; }
+					if (!found) { continue; }
+
+					F32 cost = PathCost(tiles, path, start, goal);
+					if (cost < 0.0f) { ++invalid; continue; }
+
+					//Short routes past JumpPointLimit are handed to HPA*, so JPS is checked on its own without the limit
+					if (Math::Max(Math::Abs(goal.x - start.x), Math::Abs(goal.y - start.y)) <= Pathfinding::LongRouteDistance)
+					{
+						++shortRoutes;
+						optimalShort += cost <= expected + 0.001f * expected;
+
+						bool jumped = Pathfinding::JumpSearch(Pathfinding::grids[grid], start, goal, U32_MAX, scratch, path);
+						F32 jumpCost = jumped ? PathCost(tiles, path, start, goal) : -1.0f;
+						jumpNonOptimal += jumpCost < 0.0f || jumpCost > expected + 0.001f * expected;
+					}
+					else if (expected > 0.0f)
+					{
+						F64 ratio = cost / expected;
+						++longRoutes;
+						longRatio += ratio;
+						worstRatio = Math::Max(worstRatio, ratio);
+					}
+				}
+			}
+		};
+
+		check();
+
+		//Explosions clear or fill squares, only the clusters they touch are repaired
+		for (U32 i = 0; i < 40; ++i)
+		{
+			I32 centerX = (I32)(Random::RandomUniform() * CheckedSize);
+			I32 centerY = (I32)(Random::RandomUniform() * CheckedSize);
+			I32 radius = 2 + (I32)(Random::RandomUniform() * 6);
+			TileType type = i % 2 ? TileType::Air : TileType::Full;
+
+			for (I32 y = centerY - radius; y <= centerY + radius; ++y)
+			{
+				for (I32 x = centerX - radius; x <= centerX + radius; ++x) { tiles.Set(x, y, type); }
+			}
+
+			Pathfinding::UpdateGrid(grid, { centerX - radius, centerY - radius }, { centerX + radius, centerY + radius });
+		}
+
+		tiles.CleanChunks();
+		check();
+
+		Pathfinding::RemoveGrid(grid);
+
+		Check(wrong == 0, "A path is found exactly when the reference reaches the goal");
+		Check(invalid == 0, "Paths run from start to goal along straight or diagonal lines without entering solid tiles or cutting corners");
+		Check(jumpNonOptimal == 0, "Jump Point Search finds the shortest path");
+
+		Logger::Info("Paths, ", CheckedSize, "x", CheckedSize, " Tiles, ", Sources * GoalsPerSource * 2, " Checked Against Dijkstra: ", optimalShort, " Of ", shortRoutes,
+			" Short Routes Optimal, HPA* Routes ", longRatio / Math::Max(longRoutes, 1u), "x Optimal On Average (Worst ", worstRatio, "x)");
+	}
+
+	for (U32 s = 0; s < CountOf(Sizes); ++s)
+	{
+		I32 size = Sizes[s];
+		U32 pathCount = PathCounts[s];
+
+		TileGrid tiles;
+		AddObstacles(tiles, size, size, size, 0.3f);
+
+		U32 grid = U32_MAX;
+		F64 buildTime = Measure(1, [&] { grid = Pathfinding::AddGrid(&tiles); });
+
+		Random::SeedRandom(pathCount);
+
+		Vector<Vector2Int> shortStarts(pathCount);
+		Vector<Vector2Int> shortGoals(pathCount);
+		Vector<Vector2Int> starts(pathCount);
+		Vector<Vector2Int> goals(pathCount);
+
+		for (U32 i = 0; i < pathCount; ++i)
+		{
+			Vector2Int start = RandomAir(tiles);
+			Vector2Int goal;
+			do
+			{
+				goal = start + Vector2Int{ (I32)(Random::RandomUniform() * (ShortRoute * 2 + 1)) - ShortRoute, (I32)(Random::RandomUniform() * (ShortRoute * 2 + 1)) - ShortRoute };
+			} while (Blocked(tiles, goal.x, goal.y));
+
+			shortStarts.Push(start);
+			shortGoals.Push(goal);
+			starts.Push(RandomAir(tiles));
+			goals.Push(RandomAir(tiles));
+		}
+
+		U32 shortFound = 0;
+		F64 shortTime = Measure(1, [&]
+		{
+			for (U32 i = 0; i < pathCount; ++i) { shortFound += Pathfinding::FindPath(grid, shortStarts[i], shortGoals[i], path); }
+		});
+
+		U32 longFound = 0;
+		F64 longTime = Measure(1, [&]
+		{
+			for (U32 i = 0; i < pathCount; ++i) { longFound += Pathfinding::FindPath(grid, starts[i], goals[i], path); }
+		});
+
+		//The same long routes as requests, solved by Update on the worker threads without a budget
+		Vector<U32> requests(pathCount);
+		for (U32 i = 0; i < pathCount; ++i) { requests.Push(Pathfinding::RequestPath(grid, starts[i], goals[i])); }
+
+		Pathfinding::SetFrameBudget(F64_MAX);
+		F64 batchTime = Measure(1, [&] { Pathfinding::Update(); });
+		Pathfinding::SetFrameBudget(Pathfinding::DefaultFrameBudget);
+
+		U32 batchFound = 0;
+		for (U32 request : requests)
+		{
+			batchFound += Pathfinding::Status(request) == PathStatus::Found;
+			Pathfinding::ReleasePath(request);
+		}
+
+		Check(batchFound == longFound, "Requests find the same paths FindPath does");
+
+		Pathfinding::RemoveGrid(grid);
+
+		Logger::Info("Paths, ", size, "x", size, " Tiles: Build ", buildTime, "ms, Short Routes ", pathCount / shortTime * 1000.0, " Paths/s (", shortFound, " Of ", pathCount,
+			" Found), Long Routes ", pathCount / longTime * 1000.0, " Paths/s (", longFound, " Found), Requests On ", Jobs::ThreadCount(), " Threads ", pathCount / batchTime * 1000.0, " Paths/s");
+	}
+}
+
+void Benchmarks::FlowFields()
+{
+	constexpr I32 CheckedWidth = 300;
+	constexpr I32 CheckedHeight = 230;
+	constexpr I32 Size = 1024;
+	constexpr U32 GoalMoves = 60;
+	constexpr U32 AgentCount = 10000;
+	constexpr U32 Frames = 100;
+
+	Vector<F32> distances;
+	Vector<Pair<F32, U32>> heap;
+
+	//Every tile's distance has to match the reference, and its direction has to step onto a neighbour exactly one step closer
+	auto mismatches = [&](const TileGrid& tiles, const FlowField& field)
+	{
+		const Vector2Int& dimensions = tiles.Dimensions();
+		ReferenceDistances(tiles, field.Goal(), distances, heap);
+
+		U32 count = 0;
+		for (I32 y = 0; y < dimensions.y; ++y)
+		{
+			for (I32 x = 0; x < dimensions.x; ++x)
+			{
+				F32 expected = distances[x + y * dimensions.x];
+				F32 distance = field.Distance({ x, y });
+				F32 tolerance = 0.001f * Math::Max(1.0f, expected);
+
+				if ((expected == Traits<F32>::Infinity) != (distance == Traits<F32>::Infinity) ||
+					(expected != Traits<F32>::Infinity && Math::Abs(distance - expected) > tolerance))
+				{
+					++count;
+					continue;
+				}
+
+				Vector2 direction = field.Direction({ x, y });
+				I32 dx = (direction.x > 0.5f) - (direction.x < -0.5f);
+				I32 dy = (direction.y > 0.5f) - (direction.y < -0.5f);
+
+				if (expected == Traits<F32>::Infinity || expected == 0.0f)
+				{
+					count += dx || dy;
+					continue;
+				}
+
+				bool diagonal = dx && dy;
+				if ((!dx && !dy) || Blocked(tiles, x + dx, y + dy) || (diagonal && (Blocked(tiles, x + dx, y) || Blocked(tiles, x, y + dy))))
+				{
+					++count;
+					continue;
+				}
+
+				count += Math::Abs(distances[x + dx + (y + dy) * dimensions.x] + (diagonal ? DiagonalCost : 1.0f) - expected) > tolerance;
+			}
+		}
+
+		return count;
+	};
+
+	//A map that isn't a whole number of chunks, checked after every way the field can change
+	{
+		TileGrid tiles;
+		AddObstacles(tiles, CheckedWidth, CheckedHeight, CheckedWidth, 0.25f);
+
+		FlowField field;
+		field.Create(&tiles);
+
+		Vector2Int goal = RandomAir(tiles);
+		field.SetGoal(goal);
+		field.Build();
+
+		U32 fresh = mismatches(tiles, field);
+
+		U32 moved = 0;
+		for (U32 i = 0; i < 5; ++i)
+		{
+			Vector2Int next = goal + Vector2Int{ (I32)(Random::RandomUniform() * 9) - 4, (I32)(Random::RandomUniform() * 9) - 4 };
+			if (Blocked(tiles, next.x, next.y)) { continue; }
+
+			goal = next;
+			field.SetGoal(goal);
+			field.Build();
+			moved += mismatches(tiles, field);
+		}
+
+		for (I32 y = 100; y < 110; ++y)
+		{
+			for (I32 x = 60; x < 140; ++x) { tiles.Set(x, y, TileType::Air); }
+		}
+
+		field.UpdateTiles({ 60, 100 }, { 139, 109 });
+		field.Build();
+		U32 opened = mismatches(tiles, field);
+
+		for (I32 y = 50; y < 52; ++y)
+		{
+			for (I32 x = 0; x < 250; ++x) { tiles.Set(x, y, TileType::Full); }
+		}
+
+		field.UpdateTiles({ 0, 50 }, { 249, 51 });
+		field.Build();
+		U32 closed = mismatches(tiles, field);
+
+		//No time at all still sweeps once per call, so the field settles over several calls
+		field.SetGoal(RandomAir(tiles));
+		U32 calls = 1;
+		while (!field.Build(0.0)) { ++calls; }
+		U32 budgeted = mismatches(tiles, field);
+
+		Check(fresh == 0, "A flow field matches Dijkstra from the goal");
+		Check(moved == 0, "Moving the goal matches Dijkstra from the new goal");
+		Check(opened == 0 && closed == 0, "Edited tiles match Dijkstra over the new tiles");
+		Check(budgeted == 0 && calls > 1, "A field built across several calls settles to the same distances");
+	}
+
+	TileGrid tiles;
+	AddObstacles(tiles, Size, Size, Size, 0.25f);
+
+	FlowField field;
+	F64 createTime = Measure(1, [&] { field.Create(&tiles); });
+
+	Vector2Int goal = RandomAir(tiles);
+	field.SetGoal(goal);
+	F64 buildTime = Measure(1, [&] { field.Build(); });
+
+	//The goal walks to the right a tile at a time, like a player being chased
+	F64 moveTime = 0.0;
+	U32 moves = 0;
+	for (U32 i = 0; i < GoalMoves; ++i)
+	{
+		Vector2Int next{ Math::Min(goal.x + 1, Size - 1), goal.y };
+		if (Blocked(tiles, next.x, next.y)) { continue; }
+
+		goal = next;
+		field.SetGoal(goal);
+		moveTime += Measure(1, [&] { field.Build(); });
+		++moves;
+	}
+
+	Check(mismatches(tiles, field) == 0, "A field rebuilt as the goal walks matches Dijkstra");
+
+	Vector<Vector2> agents(AgentCount);
+	for (U32 i = 0; i < AgentCount; ++i)
+	{
+		Vector2Int tile = RandomAir(tiles);
+		agents.Push({ tile.x + 0.5f, tile.y + 0.5f });
+	}
+
+	F64 agentTime = Measure(Frames, [&]
+	{
+		for (Vector2& agent : agents)
+		{
+			Vector2 direction = field.Direction({ (I32)agent.x, (I32)agent.y });
+			agent += direction * 0.1f;
+		}
+	});
+
+	Logger::Info("Flow Field, ", Size, "x", Size, " Tiles: Create ", createTime, "ms, Full Build On ", Jobs::ThreadCount(), " Threads ", buildTime, "ms, Goal Moved One Tile ",
+		moveTime / Math::Max(moves, 1u), "ms, ", AgentCount, " Agents Sampling And Moving ", agentTime, "ms/Frame");
+}
+
+void Benchmarks::Sight()
+{
+	constexpr I32 Size = 1024;
+	constexpr U32 ViewerCount = 10000;
+	constexpr U32 ReferenceViewers = 500;
+	constexpr U32 Frames = 20;
+	constexpr I32 Radii[]{ 8, 16, 32 };
+
+	//An empty room, a viewer sees exactly the disc around it
+	{
+		TileGrid tiles;
+		tiles.Create({ 100, 100 });
+		tiles.CleanChunks();
+
+		Visibility visibility;
+		visibility.Create(&tiles);
+		U32 viewer = visibility.AddViewer({ 50, 50 }, 10);
+		visibility.Update();
+
+		U32 wrong = 0;
+		for (I32 y = 0; y < 100; ++y)
+		{
+			for (I32 x = 0; x < 100; ++x)
+			{
+				bool inside = (x - 50) * (x - 50) + (y - 50) * (y - 50) <= 100;
+				wrong += visibility.Sees(viewer, { x, y }) != inside || visibility.Visible({ x, y }) != inside;
+			}
+		}
+
+		Check(wrong == 0, "A viewer in an open room sees every tile within its radius");
+	}
+
+	//Many viewers on a cluttered map, some against the edge, then edits and moves compared with a fresh instance
+	{
+		constexpr I32 Width = 200;
+		constexpr I32 Height = 150;
+		constexpr U32 Count = 300;
+
+		TileGrid tiles;
+		AddObstacles(tiles, Width, Height, Width, 0.3f);
+
+		Visibility visibility;
+		visibility.Create(&tiles);
+
+		Vector<U32> ids(Count);
+		Vector<Vector2Int> positions(Count);
+		for (U32 i = 0; i < Count; ++i)
+		{
+			Vector2Int position{ (I32)(Random::RandomUniform() * 3), (I32)(Random::RandomUniform() * Height) };
+			if (i >= 20 || Blocked(tiles, position.x, position.y)) { position = RandomAir(tiles); }
+
+			positions.Push(position);
+			ids.Push(visibility.AddViewer(position, 12));
+		}
+
+		visibility.Update();
+
+		U32 mutual = 0;
+		U32 asymmetric = 0;
+		for (U32 i = 0; i < Count; ++i)
+		{
+			for (U32 j = 0; j < Count; ++j)
+			{
+				if (i == j) { continue; }
+
+				bool sees = visibility.Sees(ids[i], positions[j]);
+				mutual += sees;
+				asymmetric += sees != visibility.Sees(ids[j], positions[i]);
+			}
+		}
+
+		U32 merged = 0;
+		for (I32 y = 0; y < Height; ++y)
+		{
+			for (I32 x = 0; x < Width; ++x)
+			{
+				bool any = false;
+				for (U32 id : ids) { any |= visibility.Sees(id, { x, y }); }
+				merged += any != visibility.Visible({ x, y });
+			}
+		}
+
+		U32 blind = 0;
+		for (U32 i = 0; i < Count; ++i) { blind += !visibility.Sees(ids[i], positions[i]); }
+
+		Check(mutual > 0 && asymmetric == 0, "Viewers see each other both ways");
+		Check(merged == 0, "The shared bitmap is every viewer's bitmap merged");
+		Check(blind == 0, "Viewers see their own tile");
+
+		for (I32 y = 60; y < 70; ++y)
+		{
+			for (I32 x = 80; x < 120; ++x) { tiles.Set(x, y, (x + y) % 3 ? TileType::Air : TileType::Full); }
+		}
+
+		visibility.UpdateTiles({ 80, 60 }, { 119, 69 });
+
+		for (U32 i = 0; i < 30; ++i)
+		{
+			positions[i] = RandomAir(tiles);
+			visibility.MoveViewer(ids[i], positions[i]);
+		}
+
+		visibility.RemoveViewer(ids[50]);
+		visibility.AddViewer(positions[51], 5);
+		visibility.Update();
+
+		Visibility fresh;
+		fresh.Create(&tiles);
+		for (U32 i = 0; i < Count; ++i)
+		{
+			if (i != 50) { fresh.AddViewer(positions[i], 12); }
+		}
+
+		fresh.AddViewer(positions[51], 5);
+		fresh.Update();
+
+		U32 differences = 0;
+		for (I32 y = 0; y < Height; ++y)
+		{
+			for (I32 x = 0; x < Width; ++x) { differences += visibility.Visible({ x, y }) != fresh.Visible({ x, y }); }
+		}
+
+		Check(differences == 0, "Edited tiles and moved viewers match a fresh cast");
+	}
+
+	//Every radius up to a wide one, viewers on the edge of the map included, against the reference
+	{
+		constexpr I32 Width = 300;
+		constexpr I32 Height = 200;
+
+		TileGrid tiles;
+		AddObstacles(tiles, Width, Height, Width, 0.35f);
+
+		Visibility visibility;
+		visibility.Create(&tiles);
+
+		ReferenceSight sight{};
+		sight.tiles = &tiles;
+
+		U32 differences = 0;
+		for (U32 i = 0; i < 200; ++i)
+		{
+			Vector2Int position{ Width - 1, (I32)(Random::RandomUniform() * Height) };
+			if (i >= 10 || Blocked(tiles, position.x, position.y)) { position = RandomAir(tiles); }
+
+			sight.origin = position;
+			sight.radius = 1 + (I32)(Random::RandomUniform() * 70);
+			ReferenceCast(sight);
+
+			U32 viewer = visibility.AddViewer(position, sight.radius);
+			visibility.Update();
+			differences += SightMismatches(sight, visibility, viewer);
+			visibility.RemoveViewer(viewer);
+		}
+
+		Check(differences == 0, "Visibility matches the reference shadowcast");
+	}
+
+	TileGrid tiles;
+	AddObstacles(tiles, Size, Size, Size, 0.25f);
+
+	for (I32 radius : Radii)
+	{
+		Visibility visibility;
+		visibility.Create(&tiles);
+
+		Vector<U32> ids(ViewerCount);
+		Vector<Vector2Int> positions(ViewerCount);
+		for (U32 i = 0; i < ViewerCount; ++i)
+		{
+			positions.Push(RandomAir(tiles));
+			ids.Push(visibility.AddViewer(positions[i], radius));
+		}
+
+		F64 fullTime = Measure(1, [&] { visibility.Update(); });
+
+		ReferenceSight sight{};
+		sight.tiles = &tiles;
+		sight.radius = radius;
+
+		F64 referenceTime = Measure(1, [&]
+		{
+			for (U32 i = 0; i < ReferenceViewers; ++i)
+			{
+				sight.origin = positions[i];
+				ReferenceCast(sight);
+			}
+		});
+
+		U32 differences = 0;
+		for (U32 i = 0; i < ReferenceViewers; ++i)
+		{
+			sight.origin = positions[i];
+			ReferenceCast(sight);
+			differences += SightMismatches(sight, visibility, ids[i]);
+		}
+
+		Check(differences == 0, "Visibility matches the reference shadowcast on a large map");
+
+		//A tenth of the viewers step to a neighbouring tile each frame
+		F64 moveTime = 0.0;
+		for (U32 frame = 0; frame < Frames; ++frame)
+		{
+			for (U32 i = 0; i < ViewerCount / 10; ++i)
+			{
+				U32 index = (U32)(Random::RandomUniform() * ViewerCount);
+				Vector2Int next = positions[index] + Vector2Int{ (I32)(Random::RandomUniform() * 3) - 1, (I32)(Random::RandomUniform() * 3) - 1 };
+				if (Blocked(tiles, next.x, next.y)) { continue; }
+
+				positions[index] = next;
+				visibility.MoveViewer(ids[index], next);
+			}
+
+			moveTime += Measure(1, [&] { visibility.Update(); });
+		}
+
+		Vector2Int center{ Size / 2, Size / 2 };
+		TileType previous = tiles.Get(center.x, center.y);
+		tiles.Set(center.x, center.y, previous == TileType::Air ? TileType::Full : TileType::Air);
+
+		F64 editTime = Measure(1, [&]
+		{
+			visibility.UpdateTiles(center, center);
+			visibility.Update();
+		});
+
+		tiles.Set(center.x, center.y, previous);
+
+		Logger::Info("Visibility, ", Size, "x", Size, " Tiles, Radius ", radius, ": ", ViewerCount, " Viewers Cast And Merged On ", Jobs::ThreadCount(), " Threads ", fullTime, "ms (",
+			ViewerCount / fullTime, " Viewers/ms, Reference ", ReferenceViewers / referenceTime, " Viewers/ms On One Thread), ", ViewerCount / 10, " Moved ",
+			moveTime / Frames, "ms/Frame, One Tile Edited ", editTime, "ms");
+	}
+}
\ No newline at end of file
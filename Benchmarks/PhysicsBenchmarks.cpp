@@ -0,0 +1,690 @@
+#include "Benchmarks.hpp"
+
+#include "Resources/World.hpp"
+#include "Resources/ProjectileComponent.hpp"
+#include "Math/Physics.hpp"
+#include "Math/SpatialHash.hpp"
+#include "Math/DynamicTree.hpp"
+#include "Math/Random.hpp"
+#include "Containers/Hashmap.hpp"
+#include "Multithreading/Jobs.hpp"
+
+//A floor along y = 0 and a wall on each side, halfWidth out from x = centerX
+static void AddContainer(F32 centerX, F32 halfWidth, F32 height, Vector<U32>& colliderIds)
+{
+	colliderIds.Push(Physics::AddCollider({ { centerX + halfWidth + 1.0f, 0.0f }, { centerX - halfWidth - 1.0f, -1.0f } }));
+	colliderIds.Push(Physics::AddCollider({ { centerX - halfWidth, height }, { centerX - halfWidth - 1.0f, 0.0f } }));
+	colliderIds.Push(Physics::AddCollider({ { centerX + halfWidth + 1.0f, height }, { centerX + halfWidth, 0.0f } }));
+}
+
+//Rows of boxes with every fourth body a circle, spaced a little apart and offset every other row so the pile settles unevenly,
+//nothing touches until the pile has fallen for a few steps
+static void AddPile(U32 count, F32 centerX, F32 halfWidth, Vector<U32>& bodyIds)
+{
+	U32 columns = (U32)((halfWidth * 2.0f - 1.5f) / 1.1f) + 1;
+
+	for (U32 i = 0; i < count; ++i)
+	{
+		U32 row = i / columns;
+		U32 column = i % columns;
+
+		BodyInfo info{};
+		info.shape = i % 4 == 3 ? ShapeType::Circle : ShapeType::Box;
+		info.halfExtents = { 0.4f + (i % 3) * 0.05f, 0.4f + (i % 5) * 0.02f };
+		info.radius = 0.45f;
+		info.position = { centerX - halfWidth + 0.6f + column * 1.1f + (row % 2) * 0.3f, 0.6f + row * 1.1f };
+
+		bodyIds.Push(Physics::CreateBody(info));
+	}
+}
+
+void Benchmarks::Projectiles()
+{
+	constexpr U32 ProjectileCount = Projectile::MaxProjectiles;
+	constexpr U32 Frames = 10;
+
+	//Reference, the per-entity layout projectiles used before they were split into arrays
+	struct Body
+	{
+		Vector2 position;
+		Vector2 velocity;
+		F32 acceleration;
+		F32 gravity;
+	};
+
+	Vector<Body> bodies(ProjectileCount);
+	Vector<U32> entityIds(ProjectileCount);
+	World::CreateEntities(ProjectileCount, entityIds.Data());
+
+	for (U32 i = 0; i < ProjectileCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		entity->position = Vector2{ (F32)(i % 512) * 4.0f, (F32)(i / 512) * 4.0f };
+		entity->scale = Vector2{ 0.25f };
+
+		Body body{ entity->position, Vector2{ (F32)(i % 17) - 8.0f, (F32)(i % 13) - 6.0f }, (F32)(i % 5), (i % 3) * 9.8f };
+		if (body.velocity == Vector2::Zero) { body.velocity.x = 1.0f; }
+
+		Projectile::AddTo(entity, body.velocity, 0.0f, body.acceleration, body.gravity);
+		bodies.Push(body);
+	}
+
+	F32 dt = (F32)Time::DeltaTimeStable();
+
+	F64 referenceTime = Measure(Frames, [&]
+	{
+		for (Body& body : bodies)
+		{
+			body.velocity += body.velocity.Normalized() * body.acceleration * dt - Vector2{ 0.0f, body.gravity * dt };
+			body.position += body.velocity * dt;
+		}
+	});
+
+	Vector<Entity>& entities = World::entities;
+
+	F64 updateTime = Measure(Frames, [&] { Projectile::Update(World::camera, entities); });
+
+	U32 mismatches = 0;
+	for (U32 i = 0; i < ProjectileCount; ++i)
+	{
+		Vector2 difference = World::GetEntity(entityIds[i]).position - bodies[i].position;
+		mismatches += Math::Abs(difference.x) > 0.01f || Math::Abs(difference.y) > 0.01f;
+	}
+
+	Check(mismatches == 0, "Projectile positions match integrating each body on its own");
+
+	//Integration alone, comparable with the reference, the state it leaves behind is no longer checked
+	F64 integrateTime = Measure(Frames, [&] { Projectile::Integrate(0, Projectile::SlotCount(), dt); });
+
+	Logger::Info("Projectiles, ", ProjectileCount, " Moving: Update ", updateTime, "ms, Integrate ", integrateTime, "ms, Per Entity Integrate Reference ", referenceTime, "ms");
+
+	EntityCommandBuffer& commands = World::Commands();
+	for (U32 i = 0; i < ProjectileCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		commands.RemoveComponent<Projectile>(entity);
+		commands.DestroyEntity(entity);
+	}
+
+	World::FlushCommands();
+}
+
+void Benchmarks::Broadphase()
+{
+	constexpr U32 Sizes[] = { 100, 1000, 10000, 100000, 1000000 };
+	constexpr U32 QueryCount = 1000;
+	constexpr U32 CheckedQueries = 64;
+	constexpr U32 MovingCount = 10000;
+	constexpr U32 MovingFrames = 60;
+	constexpr U32 CheckedFrames = 10;
+
+	for (U32 count : Sizes)
+	{
+		//Density stays the same at every size, about one collider per 16 square units
+		Random::SeedRandom(count);
+		F32 side = Math::Sqrt((F32)count) * 4.0f;
+
+		auto randomBox = [&](F32 minSize, F32 maxSize)
+		{
+			Vector2 position{ (F32)Random::RandomUniform() * side, (F32)Random::RandomUniform() * side };
+			Vector2 size{ minSize + (F32)Random::RandomUniform() * (maxSize - minSize), minSize + (F32)Random::RandomUniform() * (maxSize - minSize) };
+
+			return AABB{ position + size, position };
+		};
+
+		Vector<AABB> boxes(count);
+		for (U32 i = 0; i < count; ++i) { boxes.Push(randomBox(0.5f, 2.0f)); }
+
+		Vector<AABB> queries(QueryCount);
+		for (U32 i = 0; i < QueryCount; ++i) { queries.Push(randomBox(2.0f, 8.0f)); }
+
+		SpatialHash hash;
+		DynamicTree tree;
+		Vector<U32> hashProxies(count);
+		Vector<U32> treeProxies(count);
+
+		F64 hashInsertTime = Measure(1, [&] { for (U32 i = 0; i < count; ++i) { hashProxies.Push(hash.Insert(boxes[i], i)); } });
+		F64 treeInsertTime = Measure(1, [&] { for (U32 i = 0; i < count; ++i) { treeProxies.Push(tree.Insert(boxes[i], i)); } });
+
+		//Tree leaves are fattened, so its hits are narrowed down to the exact bounds to be comparable
+		auto queryHash = [&](U32 first, U32 last)
+		{
+			U64 found = 0;
+			for (U32 q = first; q < last; ++q) { hash.Query(queries[q], [&](U32) { ++found; return true; }); }
+			return found;
+		};
+
+		auto queryTree = [&](U32 first, U32 last)
+		{
+			U64 found = 0;
+			for (U32 q = first; q < last; ++q)
+			{
+				tree.Query(queries[q], [&](U32 proxy) { found += boxes[tree.UserData(proxy)].Overlaps(queries[q]); return true; });
+			}
+
+			return found;
+		};
+
+		U64 hashFound = 0;
+		U64 treeFound = 0;
+		F64 hashQueryTime = Measure(3, [&] { hashFound = queryHash(0, QueryCount); });
+		F64 treeQueryTime = Measure(3, [&] { treeFound = queryTree(0, QueryCount); });
+
+		//Reference, every query tested against every collider, only a few queries since it grows with the collider count
+		U64 expected = 0;
+		F64 bruteTime = Measure(1, [&]
+		{
+			expected = 0;
+			for (U32 q = 0; q < CheckedQueries; ++q)
+			{
+				for (const AABB& box : boxes) { expected += box.Overlaps(queries[q]); }
+			}
+		});
+
+		Check(queryHash(0, CheckedQueries) == expected && queryTree(0, CheckedQueries) == expected, "Broadphase queries find exactly what brute force finds");
+		Check(hashFound == treeFound, "SpatialHash and DynamicTree agree on every query");
+
+		I32 height = tree.Height();
+
+		for (U32 proxy : hashProxies) { hash.Remove(proxy); }
+		for (U32 proxy : treeProxies) { tree.Remove(proxy); }
+
+		Check(hash.Count() == 0 && hash.usedCells == 0, "Removing every proxy frees every SpatialHash cell");
+		Check(tree.Count() == 0, "Removing every proxy empties the DynamicTree");
+
+		Logger::Info("Broadphase, ", count, " Colliders, ", QueryCount, " Queries Finding ", hashFound, ": SpatialHash Insert ", hashInsertTime, "ms Query ", hashQueryTime,
+			"ms, DynamicTree Insert ", treeInsertTime, "ms Query ", treeQueryTime, "ms (Height ", height, "), Brute Force ", bruteTime * QueryCount / CheckedQueries, "ms");
+	}
+
+	//Proxies drifting up to a quarter unit a frame and bouncing off the sides of the area, every pair found each frame is checked against testing every pair
+	Random::SeedRandom(MovingCount);
+	F32 side = Math::Sqrt((F32)MovingCount) * 4.0f;
+
+	DynamicTree tree;
+	Vector<AABB> boxes(MovingCount);
+	Vector<Vector2> velocities(MovingCount);
+	Vector<U32> proxies(MovingCount);
+
+	for (U32 i = 0; i < MovingCount; ++i)
+	{
+		Vector2 position{ (F32)Random::RandomUniform() * side, (F32)Random::RandomUniform() * side };
+		Vector2 size{ 0.5f + (F32)Random::RandomUniform() * 1.5f, 0.5f + (F32)Random::RandomUniform() * 1.5f };
+
+		boxes.Push(AABB{ position + size, position });
+		velocities.Push(Vector2{ (F32)Random::RandomUniform() * 0.5f - 0.25f, (F32)Random::RandomUniform() * 0.5f - 0.25f });
+		proxies.Push(tree.Insert(boxes[i], i));
+	}
+
+	U64 pairs = 0;
+	U64 candidates = 0;
+	U64 expected = 0;
+	U32 reinserted = 0;
+	U32 wrongFrames = 0;
+	F64 moveTime = 0.0;
+	F64 pairTime = 0.0;
+	F64 bruteTime = 0.0;
+
+	for (U32 frame = 0; frame < MovingFrames; ++frame)
+	{
+		for (U32 i = 0; i < MovingCount; ++i)
+		{
+			AABB& box = boxes[i];
+			Vector2& velocity = velocities[i];
+
+			if (box.lowerBound.x + velocity.x < 0.0f || box.upperBound.x + velocity.x > side) { velocity.x = -velocity.x; }
+			if (box.lowerBound.y + velocity.y < 0.0f || box.upperBound.y + velocity.y > side) { velocity.y = -velocity.y; }
+
+			box = box + velocity;
+		}
+
+		moveTime += Measure(1, [&]
+		{
+			for (U32 i = 0; i < MovingCount; ++i) { reinserted += tree.Move(proxies[i], boxes[i], velocities[i]); }
+		});
+
+		//Fat bounds are narrowed down to the exact bounds, the same as Physics::QueryPairs
+		pairTime += Measure(1, [&]
+		{
+			pairs = 0;
+			candidates = 0;
+
+			tree.QueryPairs([&](U32 proxyA, U32 proxyB)
+			{
+				++candidates;
+				pairs += boxes[tree.UserData(proxyA)].Overlaps(boxes[tree.UserData(proxyB)]);
+			});
+		});
+
+		if (frame % CheckedFrames) { continue; }
+
+		//Reference, every pair tested, each one once
+		bruteTime += Measure(1, [&]
+		{
+			expected = 0;
+			for (U32 i = 0; i < MovingCount; ++i)
+			{
+				for (U32 j = i + 1; j < MovingCount; ++j) { expected += boxes[i].Overlaps(boxes[j]); }
+			}
+		});
+
+		//QueryPairs reports each pair once and only exact overlaps are counted, so the same count means the same pairs
+		wrongFrames += pairs != expected;
+	}
+
+	Check(wrongFrames == 0, "Moving DynamicTree pairs match testing every pair");
+
+	U32 checkedFrames = (MovingFrames + CheckedFrames - 1) / CheckedFrames;
+
+	Logger::Info("Broadphase, ", MovingCount, " Moving Proxies Over ", MovingFrames, " Frames: Move ", moveTime / MovingFrames, "ms/Frame (", reinserted / MovingFrames,
+		" Re-Inserted), QueryPairs ", pairTime / MovingFrames, "ms/Frame (", candidates, " Fat Pairs, ", pairs, " Overlapping), Brute Force ", bruteTime / checkedFrames, "ms/Frame");
+}
+
+void Benchmarks::ColliderScan()
+{
+	constexpr U32 Sizes[] = { 16, 32, 64, 128, 256 };
+	constexpr U32 QueryCount = 100000;
+
+	auto randomBox = [](F32 area, F32 size)
+	{
+		Vector2 position{ (F32)Random::RandomUniform() * area, (F32)Random::RandomUniform() * area };
+		return AABB{ position + Vector2{ size }, position };
+	};
+
+	for (U32 colliderCount : Sizes)
+	{
+		Random::SeedRandom(colliderCount);
+
+		//Colliders are spread at the same density at every size, small queries mostly miss and have to test every collider
+		F32 area = Math::Sqrt((F32)colliderCount) * 16.0f;
+
+		Vector<U32> colliderIds(colliderCount);
+		for (U32 i = 0; i < colliderCount; ++i) { colliderIds.Push(Physics::AddCollider(randomBox(area, 1.0f))); }
+
+		Vector<AABB> queries(QueryCount);
+		for (U32 i = 0; i < QueryCount; ++i) { queries.Push(randomBox(area, 0.5f)); }
+
+		Vector<U32> results(QueryCount);
+		Vector<U32> expected(QueryCount);
+		results.Resize(QueryCount);
+		expected.Resize(QueryCount);
+
+		F64 scanTime = Measure(5, [&]
+		{
+			for (U32 i = 0; i < QueryCount; ++i) { results[i] = Physics::ScanColliders(queries[i], Physics::AllCategories); }
+		});
+
+		//Reference, the same first-hit scan one collider struct at a time
+		F64 scalarTime = Measure(5, [&]
+		{
+			for (U32 i = 0; i < QueryCount; ++i)
+			{
+				expected[i] = U32_MAX;
+
+				for (U32 j = 0; j < Physics::colliders.Size(); ++j)
+				{
+					const Physics::ColliderProxy& proxy = Physics::colliders[j];
+					if (proxy.alive && proxy.bounds.Overlaps(queries[i])) { expected[i] = j; break; }
+				}
+			}
+		});
+
+		U32 broadphaseHits = 0;
+		F64 broadphaseTime = Measure(5, [&]
+		{
+			broadphaseHits = 0;
+
+			U32 proxy;
+			for (U32 i = 0; i < QueryCount; ++i) { broadphaseHits += Physics::staticColliders.QueryAny(queries[i], proxy, Physics::AllCategories); }
+		});
+
+		U32 mismatches = 0;
+		U32 hits = 0;
+		for (U32 i = 0; i < QueryCount; ++i)
+		{
+			mismatches += results[i] != expected[i];
+			hits += results[i] != U32_MAX;
+		}
+
+		Check(mismatches == 0, "The vectorized collider scan finds the same first hit as a scalar scan");
+		Check(hits == broadphaseHits, "The collider scan and the broadphase agree on which queries hit");
+
+		for (U32 id : colliderIds) { Physics::RemoveCollider(id); }
+
+		Logger::Info("Collider Scan, ", colliderCount, " Colliders, ", QueryCount, " Queries, ", hits, " Hits: Vectorized ", scanTime, "ms, Scalar Reference ", scalarTime, "ms, SpatialHash ", broadphaseTime, "ms");
+	}
+}
+
+void Benchmarks::CollisionFilters()
+{
+	constexpr U32 World = 1 << 0;
+	constexpr U32 Pickup = 1 << 1;
+	constexpr U32 Player = 1 << 2;
+	constexpr U32 Enemy = 1 << 3;
+	constexpr U32 Shot = 1 << 4;
+
+	//A game-like mix, most moving colliders only care about one or two other kinds
+	struct Kind
+	{
+		U32 count;
+		F32 size;
+		BodyType type;
+		CollisionFilter filter;
+	};
+
+	constexpr Kind Kinds[]{
+		{ 2000, 4.0f, BodyType::Static, { World, Player | Enemy | Shot } },
+		{ 10000, 0.5f, BodyType::Kinematic, { Pickup, Player } },
+		{ 200, 1.0f, BodyType::Kinematic, { Player, World | Pickup | Enemy } },
+		{ 2000, 1.0f, BodyType::Kinematic, { Enemy, World | Player | Shot } },
+		{ 6000, 0.25f, BodyType::Kinematic, { Shot, World | Enemy } }
+	};
+
+	constexpr F32 Area = 400.0f;
+
+	Random::SeedRandom((U64)Area);
+
+	Vector<U32> colliderIds;
+	Vector<CollisionFilter> filters;
+	for (const Kind& kind : Kinds)
+	{
+		for (U32 i = 0; i < kind.count; ++i)
+		{
+			Vector2 position{ (F32)Random::RandomUniform() * Area, (F32)Random::RandomUniform() * Area };
+			colliderIds.Push(Physics::AddCollider({ position + Vector2{ kind.size }, position }, kind.type, kind.filter));
+			filters.Push(kind.filter);
+		}
+	}
+
+	//Candidates are the pairs the broadphases hand to QueryPairs' bounds test, filtered ones never get that far
+	auto countCandidates = []
+	{
+		U32 candidates = 0;
+		Physics::movingColliders.QueryPairs([&](U32, U32) { ++candidates; });
+
+		for (const Physics::ColliderProxy& proxy : Physics::colliders)
+		{
+			if (!proxy.alive || proxy.type == BodyType::Static) { continue; }
+
+			Physics::staticColliders.Query(proxy.bounds, [&](U32 other)
+			{
+				candidates += (Physics::staticColliders.Mask(other) & proxy.filter.category) != 0;
+				return true;
+			}, proxy.filter.mask);
+		}
+
+		return candidates;
+	};
+
+	//Reference, every pair with at least one moving collider tested one by one
+	auto countReference = []
+	{
+		U32 count = 0;
+		for (U32 i = 0; i < Physics::colliders.Size(); ++i)
+		{
+			const Physics::ColliderProxy& a = Physics::colliders[i];
+			if (!a.alive) { continue; }
+
+			for (U32 j = i + 1; j < Physics::colliders.Size(); ++j)
+			{
+				const Physics::ColliderProxy& b = Physics::colliders[j];
+				if (!b.alive || (a.type == BodyType::Static && b.type == BodyType::Static)) { continue; }
+
+				count += (a.filter.mask & b.filter.category) && (b.filter.mask & a.filter.category) && a.bounds.Overlaps(b.bounds);
+			}
+		}
+
+		return count;
+	};
+
+	Vector<ColliderPair> pairs;
+	U32 candidates[2];
+	U32 found[2];
+	F64 times[2];
+
+	//The first pass lets every category collide with every other, the second uses the masks above
+	for (U32 masked = 0; masked < 2; ++masked)
+	{
+		for (U64 i = 0; i < colliderIds.Size(); ++i)
+		{
+			Physics::SetColliderFilter(colliderIds[i], { filters[i].category, masked ? filters[i].mask : Physics::AllCategories });
+		}
+
+		candidates[masked] = countCandidates();
+		times[masked] = Measure(5, [&]
+		{
+			pairs.Clear();
+			found[masked] = Physics::QueryPairs(pairs);
+		});
+
+		Check(found[masked] == countReference(), "QueryPairs finds every overlapping pair both filters let through");
+	}
+
+	for (U32 id : colliderIds) { Physics::RemoveCollider(id); }
+
+	Logger::Info("Collision Filters, ", colliderIds.Size(), " Colliders: Without Masks ", candidates[0], " Pairs Tested, ", found[0], " Pairs, QueryPairs ", times[0], "ms, With Masks ",
+		candidates[1], " Pairs Tested, ", found[1], " Pairs Pass The Filter, QueryPairs ", times[1], "ms");
+}
+
+void Benchmarks::ContactEvents()
+{
+	constexpr U32 ColliderCount = 40000;
+	constexpr U32 Steps = 60;
+	constexpr U32 PairCapacity = 262144;
+
+	//Crowded enough for about 50k touching pairs, every seventh collider is nudged each step so pairs begin and end
+	Random::SeedRandom(ColliderCount);
+
+	Vector<AABB> boxes(ColliderCount);
+	Vector<U32> colliderIds(ColliderCount);
+	for (U32 i = 0; i < ColliderCount; ++i)
+	{
+		Vector2 position{ (F32)Random::RandomUniform() * 300.0f, (F32)Random::RandomUniform() * 300.0f };
+		boxes.Push({ position + Vector2{ 1.2f }, position });
+		colliderIds.Push(Physics::AddCollider(boxes[i], BodyType::Kinematic));
+	}
+
+	//Reference, the pairs of the last step kept in a Hashmap and compared against every step's pairs
+	Hashmap<U64, U32> previous(PairCapacity);
+	Hashmap<U64, U32> current(PairCapacity);
+	Vector<U64> previousKeys;
+	Vector<ColliderPair> pairs;
+
+	auto key = [](const ColliderPair& pair) { return ((U64)pair.a << 32) | pair.b; };
+
+	F64 eventTime = 0.0;
+	F64 queryTime = 0.0;
+	F64 referenceTime = 0.0;
+	U64 events = 0;
+	U32 mismatches = 0;
+
+	for (U32 step = 0; step < Steps; ++step)
+	{
+		for (U32 i = 0; i < ColliderCount; i += 7)
+		{
+			Vector2 nudge{ (F32)Random::RandomUniform() * 0.6f - 0.3f, (F32)Random::RandomUniform() * 0.6f - 0.3f };
+			boxes[i] = boxes[i] + nudge;
+			Physics::UpdateCollider(colliderIds[i], boxes[i]);
+		}
+
+		Physics::beginContacts.Clear();
+		Physics::stayContacts.Clear();
+		Physics::endContacts.Clear();
+
+		eventTime += Measure(1, [&] { Physics::UpdateContactEvents(); });
+		queryTime += Measure(1, [&]
+		{
+			pairs.Clear();
+			Physics::QueryPairs(pairs);
+		});
+
+		U32 begins = 0;
+		U32 ends = 0;
+		referenceTime += Measure(1, [&]
+		{
+			current.Clear();
+			begins = 0;
+			ends = 0;
+
+			for (const ColliderPair& pair : pairs)
+			{
+				current.Insert(key(pair), 0);
+				begins += !previous.Get(key(pair));
+			}
+
+			for (U64 pairKey : previousKeys) { ends += !current.Get(pairKey); }
+		});
+
+		const Vector<ColliderPair>& begin = Physics::BeginContacts();
+		const Vector<ColliderPair>& stay = Physics::StayContacts();
+		const Vector<ColliderPair>& end = Physics::EndContacts();
+
+		mismatches += begin.Size() != begins || end.Size() != ends || begin.Size() + stay.Size() != pairs.Size();
+		for (const ColliderPair& pair : begin) { mismatches += previous.Get(key(pair)) || !current.Get(key(pair)); }
+		for (const ColliderPair& pair : stay) { mismatches += !previous.Get(key(pair)); }
+		for (const ColliderPair& pair : end) { mismatches += !previous.Get(key(pair)) || current.Get(key(pair)); }
+
+		events += begin.Size() + stay.Size() + end.Size();
+
+		Swap(previous, current);
+		previousKeys.Clear();
+		for (const ColliderPair& pair : pairs) { previousKeys.Push(key(pair)); }
+	}
+
+	Check(mismatches == 0, "Begin, stay and end contacts match comparing each step's pairs against the last step's");
+
+	for (U32 id : colliderIds) { Physics::RemoveCollider(id); }
+
+	Logger::Info("Contact Events, ", ColliderCount, " Colliders, ", pairs.Size(), " Pairs: Update ", eventTime / Steps, "ms/step (", events / eventTime / 1000.0, " Mevents/s), QueryPairs Alone ",
+		queryTime / Steps, "ms/step, Hashmap Reference ", referenceTime / Steps, "ms/step On Top Of QueryPairs");
+}
+
+void Benchmarks::Bodies()
+{
+	constexpr U32 StackHeight = 10;
+	constexpr U32 StackSteps = 600;
+	constexpr U32 PileCount = 1000;
+	constexpr F32 PileHalfWidth = 40.0f;
+	constexpr U32 PileSteps = 1200;
+
+	Vector<U32> colliderIds;
+	Vector<U32> bodyIds;
+
+	//A column of equal boxes resting on the floor, it must neither sink, drift sideways nor stay awake
+	AddContainer(0.0f, 10.0f, 20.0f, colliderIds);
+
+	for (U32 i = 0; i < StackHeight; ++i)
+	{
+		BodyInfo info{};
+		info.position = { 0.0f, 0.5f + i };
+		bodyIds.Push(Physics::CreateBody(info));
+	}
+
+	U32 stackSleepStep = U32_MAX;
+	for (U32 step = 0; step < StackSteps; ++step)
+	{
+		Physics::Step(Physics::TimeStep);
+		if (stackSleepStep == U32_MAX && Physics::AwakeBodyCount() == 0) { stackSleepStep = step + 1; }
+	}
+
+	F32 drift = 0.0f;
+	F32 sink = 0.0f;
+	for (U32 i = 0; i < StackHeight; ++i)
+	{
+		const Vector2& position = Physics::BodyPosition(bodyIds[i]);
+		drift = Math::Max(drift, Math::Abs(position.x));
+		sink = Math::Max(sink, Math::Abs(position.y - (0.5f + i)));
+	}
+
+	//Every resting contact keeps up to Slop of penetration, so the top box sits up to one Slop per box lower
+	Check(drift < 0.01f && sink < (StackHeight + 1) * Physics::Slop, "A stack of boxes stays upright where it was placed");
+	Check(stackSleepStep != U32_MAX, "A resting stack of boxes falls asleep");
+
+	for (U32 body : bodyIds) { Physics::DestroyBody(body); }
+	for (U32 collider : colliderIds) { Physics::RemoveCollider(collider); }
+	bodyIds.Clear();
+	colliderIds.Clear();
+
+	//A thousand boxes and circles dropped into a container, timed until they all sleep
+	AddContainer(0.0f, PileHalfWidth, 200.0f, colliderIds);
+	AddPile(PileCount, 0.0f, PileHalfWidth, bodyIds);
+
+	U32 steps = 0;
+	F64 stepTime = 0.0;
+	F64 slowestStep = 0.0;
+	U32 asleepAtOneSecond = 0;
+
+	while (steps < PileSteps && Physics::AwakeBodyCount() + (steps == 0) > 0)
+	{
+		F64 elapsed = Measure(1, [] { Physics::Step(Physics::TimeStep); });
+		stepTime += elapsed;
+		slowestStep = Math::Max(slowestStep, elapsed);
+
+		if (++steps == 60) { asleepAtOneSecond = PileCount - Physics::AwakeBodyCount(); }
+	}
+
+	U32 escaped = 0;
+	for (U32 body : bodyIds)
+	{
+		const Vector2& position = Physics::BodyPosition(body);
+		escaped += position.y < 0.0f || position.x < -PileHalfWidth || position.x > PileHalfWidth;
+	}
+
+	U32 asleep = PileCount - Physics::AwakeBodyCount();
+
+	Check(escaped == 0, "No body of a pile falls through the floor or the walls");
+	Check(asleep == PileCount, "Every body of a settled pile falls asleep");
+
+	for (U32 body : bodyIds) { Physics::DestroyBody(body); }
+	for (U32 collider : colliderIds) { Physics::RemoveCollider(collider); }
+
+	Logger::Info("Rigid Bodies, Stack Of ", StackHeight, " Asleep After ", stackSleepStep, " Steps, Pile Of ", PileCount, ": ", steps, " Steps On ", Jobs::ThreadCount(), " Threads, ",
+		steps / (stepTime / 1000.0), " Steps/s (Slowest ", slowestStep, "ms), ", asleepAtOneSecond, " Asleep After 60 Steps, ", asleep, " At The End");
+}
+
+void Benchmarks::BodyThreads()
+{
+	constexpr U32 PileCount = 100;
+	constexpr U32 PileSize = 200;
+	constexpr F32 PileHalfWidth = 10.0f;
+	constexpr U32 Steps = 120;
+	constexpr U32 ThreadCounts[]{ 1, 2, 4, 8, 16 };
+
+	//Separate piles so there are many islands to spread across threads, not one giant one
+	Vector<U32> colliderIds;
+	for (U32 i = 0; i < PileCount; ++i) { AddContainer(i * (PileHalfWidth * 2.0f + 4.0f), PileHalfWidth, 40.0f, colliderIds); }
+
+	U32 threads = Jobs::ThreadCount();
+	Vector<U32> bodyIds(PileCount * PileSize);
+	Vector<Vector2> reference(PileCount * PileSize);
+	F64 times[CountOf(ThreadCounts)];
+	bool deterministic = true;
+
+	for (U32 run = 0; run < CountOf(ThreadCounts); ++run)
+	{
+		Jobs::SetThreadCount(ThreadCounts[run]);
+
+		//Every run starts from the same bodies with the same ids, freed last to first so they're handed out again in order
+		for (U64 i = bodyIds.Size(); i > 0; --i) { Physics::DestroyBody(bodyIds[i - 1]); }
+		bodyIds.Clear();
+		for (U32 i = 0; i < PileCount; ++i) { AddPile(PileSize, i * (PileHalfWidth * 2.0f + 4.0f), PileHalfWidth, bodyIds); }
+
+		times[run] = Measure(1, [] { for (U32 step = 0; step < Steps; ++step) { Physics::Step(Physics::TimeStep); } });
+
+		for (U64 i = 0; i < bodyIds.Size(); ++i)
+		{
+			const Vector2& position = Physics::BodyPosition(bodyIds[i]);
+			if (run == 0) { reference.Push(position); }
+			else { deterministic &= position.x == reference[i].x && position.y == reference[i].y; }
+		}
+	}
+
+	Check(deterministic, "Bodies end up at exactly the same positions no matter how many threads step them");
+
+	for (U64 i = bodyIds.Size(); i > 0; --i) { Physics::DestroyBody(bodyIds[i - 1]); }
+	for (U32 collider : colliderIds) { Physics::RemoveCollider(collider); }
+	Jobs::SetThreadCount(threads);
+
+	//Speedups against one thread, 1 2 4 8 16 threads
+	Logger::Info("Rigid Bodies, ", PileCount, " Piles Of ", PileSize, ", ", Steps, " Steps: ", Steps / (times[0] / 1000.0), " Steps/s On 1 Thread, Speedup On 2/4/8/16 Threads ",
+		times[0] / times[1], "x, ", times[0] / times[2], "x, ", times[0] / times[3], "x, ", times[0] / times[4], "x");
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "Benchmarks.hpp"
+
+#include "Resources/World.hpp"
+#include "Resources/SpriteComponent.hpp"
+#include "Resources/Particles.hpp"
+#include "Resources/TilemapComponent.hpp"
+#include "Containers/DirtyRects.hpp"
+#include "Math/Random.hpp"
+#include "Rendering/Buffer.hpp"
+
+void Benchmarks::Uploads()
+{
+	constexpr U32 SpriteCount = 8192;
+	constexpr U32 MovingEvery[]{ 100, 20, 3 };
+
+	Vector<U32> entityIds(SpriteCount);
+	World::CreateEntities(SpriteCount, entityIds.Data());
+
+	for (U32 i = 0; i < SpriteCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		entity->position = Vector2{ (F32)(i % 128), (F32)(i / 128) };
+		Sprite::AddTo(entity);
+	}
+
+	Vector<Entity>& entities = World::entities;
+
+	//Bytes are read straight from the frame counter so the renderer's own per-frame total is left alone
+	U64 bytes = 0;
+	auto frame = [&]
+	{
+		U64 before = Buffer::frameUploadBytes;
+		Sprite::Update(World::camera, entities);
+		bytes = Buffer::frameUploadBytes - before;
+	};
+
+	frame();
+	U64 firstBytes = bytes;
+
+	F64 staticTime = Measure(20, frame);
+	Check(bytes == 0, "A frame where nothing moved uploads nothing");
+
+	U64 fullBytes = Sprite::spriteInstances.Size() * sizeof(SpriteInstance);
+
+	//Scattered edits, a few stay as separate copies, once they cover most of the buffer it goes up whole
+	for (U32 every : MovingEvery)
+	{
+		F64 movingTime = Measure(20, [&]
+		{
+			for (U32 i = 0; i < SpriteCount; i += every) { World::GetEntity(entityIds[i]).position.y += 0.01f; }
+			frame();
+		});
+
+		U64 movingBytes = bytes;
+		U32 moved = (SpriteCount + every - 1) / every;
+
+		Check(movingBytes >= moved * sizeof(SpriteInstance) && movingBytes <= fullBytes, "Moving sprites uploads at least them and never more than every instance");
+		if (every == MovingEvery[0]) { Check(movingBytes == moved * sizeof(SpriteInstance), "A few scattered sprites upload only themselves"); }
+
+		U32 stale = 0;
+		for (U32 i = 0; i < SpriteCount; ++i)
+		{
+			const SpriteInstance& instance = Sprite::spriteInstances[Sprite::GetRef(EntityRef{ entityIds[i] })->instanceIndex];
+			stale += !(instance.position == World::GetEntity(entityIds[i]).position);
+		}
+
+		Check(stale == 0, "Every instance matches its entity after the upload");
+
+		Logger::Info("Sprite Uploads, ", SpriteCount, " Sprites, 1 In ", every, " Moving: First Frame ", firstBytes, "B, Static Frame ", staticTime, "ms 0B, Moving Frame ", movingTime, "ms ", movingBytes,
+			"B, Full Upload ", fullBytes, "B (", movingBytes * 100.0 / fullBytes, "% Of It)");
+	}
+
+	EntityCommandBuffer& commands = World::Commands();
+	for (U32 i = 0; i < SpriteCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		commands.RemoveComponent<Sprite>(entity);
+		commands.DestroyEntity(entity);
+	}
+
+	World::FlushCommands();
+	frame();
+}
+
+void Benchmarks::ParticlePools()
+{
+	constexpr U32 ParticleCount = 200000;
+	constexpr U32 Frames = 10;
+
+	ParticleEmitterInfo info{};
+	info.lifetime = 60.0f;
+	info.minSpeed = 1.0f;
+	info.maxSpeed = 4.0f;
+	info.gravity = 9.8f;
+	info.capacity = ParticleCount;
+
+	U32 id = Particles::CreateEmitter(info);
+	Particles::Emit(id, Vector2{ 10.0f, 20.0f }, ParticleCount);
+
+	const ParticleEmitter& emitter = Particles::emitters[id];
+	Check(emitter.count == ParticleCount, "Emit fills the emitter");
+
+	//Reference, one struct per particle written out to its own instance, close to the entity per particle layout this replaced
+	struct Particle
+	{
+		Vector2 position;
+		Vector2 velocity;
+		Quaternion2 rotation;
+		F32 age;
+	};
+
+	Vector<Particle> particles(ParticleCount);
+	Vector<SpriteInstance> referenceInstances(ParticleCount);
+	referenceInstances.Resize(ParticleCount);
+
+	U32 rotations = 0;
+	for (U32 i = 0; i < ParticleCount; ++i)
+	{
+		particles.Push({ { emitter.positionX[i], emitter.positionY[i] }, { emitter.velocityX[i], emitter.velocityY[i] },
+			{ emitter.rotationX[i], emitter.rotationY[i] }, emitter.age[i] });
+
+		rotations += emitter.rotationX[i] != emitter.rotationX[0] || emitter.rotationY[i] != emitter.rotationY[0];
+	}
+
+	Check(rotations > ParticleCount / 2, "Particles are emitted with random rotations");
+
+	F32 dt = (F32)Time::DeltaTimeStable();
+	F32 inverseLifetime = 1.0f / info.lifetime;
+
+	F64 referenceTime = Measure(Frames, [&]
+	{
+		for (U32 i = 0; i < ParticleCount; ++i)
+		{
+			Particle& particle = particles[i];
+			particle.velocity.y -= info.gravity * dt;
+			particle.age += dt;
+			particle.position += particle.velocity * dt;
+
+			SpriteInstance& instance = referenceInstances[i];
+			instance.position = particle.position;
+			instance.scale = info.scale;
+			instance.rotation = particle.rotation;
+			instance.instColor = info.startColor + (info.endColor - info.startColor) * (particle.age * inverseLifetime);
+			instance.instTexcoord = Vector2::Zero;
+			instance.instTexcoordScale = Vector2::One;
+			instance.textureIndex = info.texture.Handle();
+			instance.spriteIndex = i;
+		}
+	});
+
+	F64 updateTime = Measure(Frames, [&] { Particles::Update(); });
+
+	U32 mismatches = 0;
+	for (U32 i = 0; i < ParticleCount; ++i)
+	{
+		const SpriteInstance& instance = Particles::instances[i];
+		const SpriteInstance& expected = referenceInstances[i];
+
+		Vector2 difference = instance.position - expected.position;
+		mismatches += Math::Abs(difference.x) > 0.001f || Math::Abs(difference.y) > 0.001f ||
+			instance.rotation.x != expected.rotation.x || instance.rotation.y != expected.rotation.y ||
+			Math::Abs(instance.instColor.w - expected.instColor.w) > 0.001f;
+	}
+
+	Check(Particles::LiveCount() == ParticleCount && mismatches == 0, "Particle instances match simulating each particle on its own");
+
+	Logger::Info("Particles, ", ParticleCount, " Live: Update ", updateTime, "ms, Per Particle Reference ", referenceTime, "ms");
+
+	Particles::DestroyEmitter(id);
+	Particles::Update();
+}
+
+void Benchmarks::TileUploads()
+{
+	constexpr I32 Width = 4096;
+	constexpr I32 Height = 1024;
+	constexpr U32 Frames = 200;
+	constexpr U32 ExplosionCounts[] = { 1, 4, 16 };
+
+	{
+		DirtyRects rects;
+		rects.Mark({ 0, 0 });
+		rects.Mark({ 1, 1 });
+		Check(rects.Count() == 2, "Rects that only meet at a corner aren't merged");
+
+		rects.Mark({ 1, 0 });
+		Check(rects.Count() == 1 && rects.Cells() == 4, "Rects sharing an edge are merged");
+	}
+
+	EntityRef entity = World::CreateEntity();
+	ComponentRef<Tilemap> tilemap = Tilemap::AddTo(entity, Width, Height);
+	ResourceRef<Texture> texture;
+	Vector<Entity>& entities = World::entities;
+
+	//Bytes are read straight from the frame counter so the renderer's own per-frame total is left alone
+	U64 before = Buffer::frameUploadBytes;
+	Tilemap::Update(World::camera, entities);
+	U64 firstBytes = Buffer::frameUploadBytes - before;
+
+	//Every edited tile is marked in a bitmap next to the tilemap's own rects, the ranges have to cover each one exactly once
+	Vector<U8> edited(Width * Height);
+	Vector<U8> covered(Width * Height);
+	edited.Resize(Width * Height, 0);
+	covered.Resize(Width * Height, 0);
+
+	Vector<U32> editedCells;
+	Vector<DirtyRange> ranges;
+
+	for (U32 explosions : ExplosionCounts)
+	{
+		Random::SeedRandom(explosions);
+
+		U64 editedTiles = 0;
+		U64 uploadedBytes = 0;
+		U64 rangeBytes = 0;
+		U32 missing = 0;
+		U32 overlapping = 0;
+		F64 markTime = 0.0;
+
+		for (U32 frame = 0; frame < Frames; ++frame)
+		{
+			DirtyRects rects;
+
+			//Circular explosions that flip every tile they cover, edited tile by tile the way destructible terrain is
+			markTime += Measure(1, [&]
+			{
+				for (U32 i = 0; i < explosions; ++i)
+				{
+					I32 centerX = (I32)(Random::RandomUniform() * Width);
+					I32 centerY = (I32)(Random::RandomUniform() * Height);
+					I32 radius = 4 + (I32)(Random::RandomUniform() * 8);
+
+					for (I32 y = Math::Max(centerY - radius, 0); y <= Math::Min(centerY + radius, Height - 1); ++y)
+					{
+						for (I32 x = Math::Max(centerX - radius, 0); x <= Math::Min(centerX + radius, Width - 1); ++x)
+						{
+							if ((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY) > radius * radius) { continue; }
+
+							U32 cell = x + y * Width;
+							if (edited[cell]) { continue; }
+
+							edited[cell] = 1;
+							editedCells.Push(cell);
+							rects.Mark({ x, y });
+
+							TileType type = tilemap->GetTiles().Get(x, y) == TileType::Air ? TileType::Full : TileType::Air;
+							tilemap->SetTile(texture, { x, y }, type);
+						}
+					}
+				}
+			});
+
+			ranges.Clear();
+			rects.Ranges(Width, 0, ranges);
+
+			for (const DirtyRange& range : ranges)
+			{
+				for (U32 cell = range.start; cell < range.end; ++cell)
+				{
+					overlapping += covered[cell];
+					covered[cell] = 1;
+				}
+
+				rangeBytes += (range.end - range.start) * sizeof(U16);
+			}
+
+			for (U32 cell : editedCells) { missing += !covered[cell]; }
+
+			before = Buffer::frameUploadBytes;
+			Tilemap::Update(World::camera, entities);
+			uploadedBytes += Buffer::frameUploadBytes - before;
+
+			for (const DirtyRange& range : ranges)
+			{
+				for (U32 cell = range.start; cell < range.end; ++cell) { covered[cell] = 0; }
+			}
+
+			for (U32 cell : editedCells) { edited[cell] = 0; }
+
+			editedTiles += editedCells.Size();
+			editedCells.Clear();
+		}
+
+		Check(missing == 0 && overlapping == 0, "Upload ranges cover every edited tile exactly once");
+		Check(uploadedBytes == rangeBytes, "A tilemap uploads exactly its dirty ranges");
+
+		Logger::Info("Tile Uploads, ", Width, "x", Height, " Tiles, ", explosions, " Explosions/Frame: ", editedTiles / Frames, " Tiles Edited, ", uploadedBytes / Frames,
+			"B Uploaded/Frame (", (F64)uploadedBytes / (editedTiles * sizeof(U16)), "x The Edited Tiles), Mark ", markTime / Frames, "ms/Frame");
+	}
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.DestroyEntity(entity);
+	World::FlushCommands();
+
+	Logger::Info("Tile Uploads, ", Width, "x", Height, " Tiles: First Frame ", firstBytes, "B, Whole Map ", (U64)Width * Height * sizeof(U16), "B");
+}
\ No newline at end of file
@@ -0,0 +1,740 @@
+#include "Benchmarks.hpp"
+
+#include "Resources/World.hpp"
+#include "Resources/TilemapComponent.hpp"
+#include "Resources/TilemapColliderComponent.hpp"
+#include "Math/Physics.hpp"
+#include "Math/Random.hpp"
+#include "Multithreading/Jobs.hpp"
+#include "Core/File.hpp"
+
+//Rolling ground over the bottom half of the map with caves cut into it, the same map every run
+static ComponentRef<Tilemap> AddTerrain(const EntityRef& entity, I32 width, I32 height)
+{
+	ComponentRef<Tilemap> tilemap = Tilemap::AddTo(entity, width, height);
+	ResourceRef<Texture> texture;
+
+	for (I32 x = 0; x < width; ++x)
+	{
+		I32 ground = height / 2 - (I32)(height / 8 * Math::Sin(x * 0.003f) + height / 64 * Math::Sin(x * 0.021f));
+
+		for (I32 y = ground; y < height; ++y)
+		{
+			bool cave = y > ground + 30 && Math::Sin(x * 0.05f) * Math::Cos(y * 0.07f) > 0.7f;
+			if (!cave) { tilemap->SetTile(texture, { x, y }); }
+		}
+	}
+
+	tilemap->Clean();
+
+	return tilemap;
+}
+
+//Where tile x, y of a tilemap collider is in the world, rows run down from offset
+static AABB TileBounds(const Vector2& offset, const Vector2& tileSize, I32 x, I32 y)
+{
+	return { { (x + 1) * tileSize.x + offset.x, -y * tileSize.y + offset.y + tileSize.y }, { x * tileSize.x + offset.x, -y * tileSize.y + offset.y } };
+}
+
+void Benchmarks::TileCollision()
+{
+	constexpr I32 Size = 4096;
+	constexpr U32 QueryCount = 100000;
+	constexpr I32 QuerySizes[] = { 1, 3, 8 };
+
+	EntityRef entity = World::CreateEntity();
+
+	ComponentRef<Tilemap> tilemap;
+	F64 fillTime = Measure(1, [&] { tilemap = AddTerrain(entity, Size, Size); });
+
+	ComponentRef<TilemapCollider> collider;
+	F64 buildTime = Measure(1, [&] { collider = TilemapCollider::AddTo(entity, tilemap); });
+
+	const TileGrid& tiles = tilemap->GetTiles();
+	Vector2 tileSize = collider->tileSize;
+	Vector2 offset = collider->offset;
+
+	//Reference, a box for every solid tile in the window a query covers, what grids were queried with before tiles were merged
+	auto tileCollision = [&](const AABB& bounds)
+	{
+		I32 minX = Math::Max((I32)Math::Floor((bounds.lowerBound.x - offset.x) / tileSize.x), 0);
+		I32 maxX = Math::Min((I32)Math::Floor((bounds.upperBound.x - offset.x) / tileSize.x), Size - 1);
+		I32 minY = Math::Max((I32)Math::Floor((offset.y - bounds.upperBound.y) / tileSize.y), 0);
+		I32 maxY = Math::Min((I32)Math::Ceiling((offset.y - bounds.lowerBound.y) / tileSize.y), Size - 1);
+
+		for (I32 y = minY; y <= maxY; ++y)
+		{
+			for (I32 x = minX; x <= maxX; ++x)
+			{
+				if (tiles.Get(x, y) != TileType::Full) { continue; }
+
+				if (TileBounds(offset, tileSize, x, y).Overlaps(bounds)) { return true; }
+			}
+		}
+
+		return false;
+	};
+
+	for (I32 querySize : QuerySizes)
+	{
+		//Queries are kept near the ground, where characters are
+		Random::SeedRandom(querySize);
+
+		Vector<AABB> queries(QueryCount);
+		for (U32 i = 0; i < QueryCount; ++i)
+		{
+			Vector2 tile{ (F32)Random::RandomUniform() * Size, Size * 0.25f + (F32)Random::RandomUniform() * Size * 0.5f };
+			Vector2 position{ offset.x + tile.x * tileSize.x, offset.y - tile.y * tileSize.y };
+			queries.Push(AABB{ position + tileSize * (F32)querySize, position });
+		}
+
+		Vector<U8> results(QueryCount);
+		Vector<U8> expected(QueryCount);
+		results.Resize(QueryCount);
+		expected.Resize(QueryCount);
+
+		F64 queryTime = Measure(5, [&]
+		{
+			for (U32 i = 0; i < QueryCount; ++i) { results[i] = Physics::CheckCollision(queries[i]).valid; }
+		});
+
+		F64 referenceTime = Measure(5, [&]
+		{
+			for (U32 i = 0; i < QueryCount; ++i) { expected[i] = tileCollision(queries[i]); }
+		});
+
+		U32 hits = 0;
+		U32 mismatches = 0;
+		for (U32 i = 0; i < QueryCount; ++i)
+		{
+			hits += results[i];
+			mismatches += results[i] != expected[i];
+		}
+
+		Check(mismatches == 0, "Merged tile rectangles hit exactly the queries that overlap a solid tile");
+
+		Logger::Info("Tile Collision, ", Size, "x", Size, " Tiles, ", QueryCount, " ", querySize, "x", querySize, " Queries, ", hits, " Hits: Merged Rects ", queryTime,
+			"ms, Per Tile Reference ", referenceTime, "ms");
+	}
+
+	//Carve a shaft through the ground one tile at a time, each edit only rebuilds the band the tile is in
+	I32 column = Size / 3;
+	I32 edits = 0;
+	F64 editTime = 0.0;
+
+	for (I32 y = 0; y < Size; y += 7)
+	{
+		tilemap->SetTile({}, { column, y }, TileType::Air);
+		editTime += Measure(1, [&] { Physics::UpdateTilemapCollider(collider->gridIndex, { column, y }, { column, y }); });
+		++edits;
+	}
+
+	tilemap->Clean();
+
+	U32 mismatches = 0;
+	for (I32 y = 0; y < Size; ++y)
+	{
+		Vector2 position{ offset.x + (column + 0.5f) * tileSize.x, offset.y - (y - 0.5f) * tileSize.y };
+		AABB query{ position + tileSize * 0.25f, position - tileSize * 0.25f };
+		mismatches += Physics::CheckCollision(query).valid != tileCollision(query);
+	}
+
+	Check(mismatches == 0, "Rebuilt bands match the edited tiles");
+
+	Vector2 solidPoint = Vector2::Zero;
+	for (I32 x = 0; x < Size; ++x)
+	{
+		if (tiles.Get(x, Size - 1) == TileType::Full)
+		{
+			solidPoint = { offset.x + (x + 0.5f) * tileSize.x, offset.y - (Size - 1.5f) * tileSize.y };
+			break;
+		}
+	}
+
+	Check(Physics::CheckTile(solidPoint), "Solid tiles are hit before the tilemap is removed");
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<TilemapCollider>(entity);
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.DestroyEntity(entity);
+	World::FlushCommands();
+
+	Check(!Physics::CheckTile(solidPoint), "A removed tilemap is never hit");
+
+	Logger::Info("Tile Collision, ", Size, "x", Size, " Tiles: Fill ", fillTime, "ms, Build Rects ", buildTime, "ms, Single Tile Edit ", editTime / edits, "ms");
+}
+
+void Benchmarks::Contours()
+{
+	constexpr I32 Size = 4096;
+	constexpr U32 EditCount = 256;
+
+	EntityRef entity = World::CreateEntity();
+	ComponentRef<Tilemap> tilemap = AddTerrain(entity, Size, Size);
+	ComponentRef<TilemapCollider> collider = TilemapCollider::AddTo(entity, tilemap);
+
+	auto generate = [&]
+	{
+		for (U32 chunk : collider->dirtyChunks) { collider->GenerateChunk(chunk); }
+		collider->dirtyChunks.Clear();
+	};
+
+	F64 fullTime = Measure(1, generate);
+
+	const TileGrid& tiles = tilemap->GetTiles();
+	Vector2 tileSize = collider->tileSize;
+	Vector2 offset = collider->offset;
+
+	//Reference, every unit edge between a solid and a non-solid tile, each one has to be covered by exactly one segment
+	Vector<U8> horizontal(Size * (Size + 1));
+	Vector<U8> vertical((Size + 1) * Size);
+	horizontal.Resize(Size * (Size + 1));
+	vertical.Resize((Size + 1) * Size);
+
+	auto mismatches = [&]
+	{
+		auto solid = [&](I32 x, I32 y) { return tiles.Get(x, y) == TileType::Full; };
+
+		for (I32 y = 0; y <= Size; ++y)
+		{
+			for (I32 x = 0; x < Size; ++x) { horizontal[x + y * Size] = solid(x, y) != solid(x, y - 1); }
+		}
+
+		for (I32 y = 0; y < Size; ++y)
+		{
+			for (I32 x = 0; x <= Size; ++x) { vertical[x + y * (Size + 1)] = solid(x, y) != solid(x - 1, y); }
+		}
+
+		//Top of row y is at offset.y - (y - 1) * tileSize.y
+		U32 count = 0;
+		for (U32 chunk = 0; chunk < collider->ChunkCount(); ++chunk)
+		{
+			const Vector<Vector2>& edges = collider->ChunkEdges(chunk);
+
+			for (U64 i = 0; i + 1 < edges.Size(); i += 2)
+			{
+				I32 x0 = (I32)Math::Floor((edges[i].x - offset.x) / tileSize.x + 0.5f);
+				I32 x1 = (I32)Math::Floor((edges[i + 1].x - offset.x) / tileSize.x + 0.5f);
+				I32 y0 = (I32)Math::Floor((offset.y - edges[i].y) / tileSize.y + 0.5f) + 1;
+				I32 y1 = (I32)Math::Floor((offset.y - edges[i + 1].y) / tileSize.y + 0.5f) + 1;
+
+				if (y0 == y1)
+				{
+					for (I32 x = x0; x < x1; ++x) { count += horizontal[x + y0 * Size]-- != 1; }
+				}
+				else
+				{
+					for (I32 y = y0; y < y1; ++y) { count += vertical[x0 + y * (Size + 1)]-- != 1; }
+				}
+			}
+		}
+
+		for (U8 edge : horizontal) { count += edge != 0; }
+		for (U8 edge : vertical) { count += edge != 0; }
+
+		return count;
+	};
+
+	Check(mismatches() == 0, "Chunk outlines cover every solid edge of the tilemap exactly once");
+
+	//Dig out and fill back single tiles near the surface, where the outline is
+	Random::SeedRandom(EditCount);
+	F64 editTime = 0.0;
+	F64 slowestEdit = 0.0;
+	U64 regenerated = 0;
+
+	for (U32 i = 0; i < EditCount; ++i)
+	{
+		Vector2Int tile{ (I32)(Random::RandomUniform() * Size), Size / 4 + (I32)(Random::RandomUniform() * Size / 2) };
+		tilemap->SetTile({}, tile, tiles.Get(tile.x, tile.y) == TileType::Full ? TileType::Air : TileType::Full);
+
+		Vector2Int min, max;
+		tilemap->GetDirtyRegion(min, max);
+		tilemap->Clean();
+
+		F64 time = Measure(1, [&]
+		{
+			collider->MarkDirty(min, max);
+			regenerated += collider->dirtyChunks.Size();
+			generate();
+		});
+
+		editTime += time;
+		slowestEdit = Math::Max(slowestEdit, time);
+	}
+
+	Check(mismatches() == 0, "Outlines regenerated after edits match the edited tiles");
+
+	U32 chunkCount = collider->ChunkCount();
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<TilemapCollider>(entity);
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.DestroyEntity(entity);
+	World::FlushCommands();
+
+	Logger::Info("Tilemap Contours, ", Size, "x", Size, " Tiles, ", chunkCount, " Chunks: Full Outline ", fullTime, "ms, Single Tile Edit ", editTime / EditCount,
+		"ms (Slowest ", slowestEdit, "ms, ", (F64)regenerated / EditCount, " Chunks)");
+}
+
+void Benchmarks::Raycasts()
+{
+	constexpr I32 Size = 2048;
+	constexpr U32 ColliderCount = 5000;
+	constexpr U32 RayCount = 200000;
+	constexpr U32 CheckedRays = 5000;
+
+	EntityRef entity = World::CreateEntity();
+	ComponentRef<Tilemap> tilemap = AddTerrain(entity, Size, Size);
+	ComponentRef<TilemapCollider> collider = TilemapCollider::AddTo(entity, tilemap);
+
+	const TileGrid& tiles = tilemap->GetTiles();
+	Vector2 tileSize = collider->tileSize;
+	Vector2 offset = collider->offset;
+	Vector2 worldMin{ offset.x, offset.y - (Size - 1) * tileSize.y };
+	Vector2 worldSize = tileSize * (F32)Size;
+
+	Random::SeedRandom(RayCount);
+
+	auto randomPoint = [&] { return worldMin + Vector2{ (F32)Random::RandomUniform() * worldSize.x, (F32)Random::RandomUniform() * worldSize.y }; };
+
+	//A third of the colliders move so both broadphases are walked
+	Vector<U32> colliderIds(ColliderCount);
+	for (U32 i = 0; i < ColliderCount; ++i)
+	{
+		Vector2 position = randomPoint();
+		F32 size = 0.5f + (F32)Random::RandomUniform() * 3.5f;
+		colliderIds.Push(Physics::AddCollider({ position + Vector2{ size }, position }, i % 3 ? BodyType::Static : BodyType::Kinematic));
+	}
+
+	Vector<Ray> rays(RayCount);
+	for (U32 i = 0; i < RayCount; ++i)
+	{
+		Vector2 start = randomPoint();
+		F32 angle = (F32)Random::RandomUniform() * TwoPi;
+		F32 length = 1.0f + (F32)Random::RandomUniform() * 63.0f;
+		rays.Push({ start, start + Vector2{ Math::Cos(angle), Math::Sin(angle) } * length });
+	}
+
+	Vector<RaycastHit> results(RayCount);
+	results.Resize(RayCount);
+
+	F64 singleTime = Measure(3, [&]
+	{
+		for (U32 i = 0; i < RayCount; ++i) { results[i] = Physics::Raycast(rays[i].start, rays[i].end); }
+	});
+
+	F64 batchTime = Measure(3, [&] { Physics::Raycasts(rays.Data(), RayCount, results.Data()); });
+
+	//Reference, every solid tile around the ray and every collider tested on its own
+	Vector<RaycastHit> expected(CheckedRays);
+	expected.Resize(CheckedRays);
+
+	F64 referenceTime = Measure(1, [&]
+	{
+		for (U32 i = 0; i < CheckedRays; ++i)
+		{
+			const Ray& ray = rays[i];
+			Vector2 delta = ray.end - ray.start;
+			RaycastHit& hit = expected[i];
+			hit = { ray.end, Vector2::Zero, 1.0f, U32_MAX, U32_MAX, false };
+
+			auto test = [&](const AABB& bounds)
+			{
+				F32 fraction;
+				Vector2 normal;
+				if (bounds.RayCast(ray.start, delta, hit.fraction, fraction, normal) && (!hit.valid || fraction < hit.fraction))
+				{
+					hit.fraction = fraction;
+					hit.valid = true;
+				}
+			};
+
+			I32 minX = Math::Max((I32)Math::Floor((Math::Min(ray.start.x, ray.end.x) - offset.x) / tileSize.x) - 1, 0);
+			I32 maxX = Math::Min((I32)Math::Floor((Math::Max(ray.start.x, ray.end.x) - offset.x) / tileSize.x) + 1, Size - 1);
+			I32 minY = Math::Max((I32)Math::Floor((offset.y - Math::Max(ray.start.y, ray.end.y)) / tileSize.y) - 1, 0);
+			I32 maxY = Math::Min((I32)Math::Ceiling((offset.y - Math::Min(ray.start.y, ray.end.y)) / tileSize.y) + 1, Size - 1);
+
+			for (I32 y = minY; y <= maxY; ++y)
+			{
+				for (I32 x = minX; x <= maxX; ++x)
+				{
+					if (tiles.Get(x, y) == TileType::Full) { test(TileBounds(offset, tileSize, x, y)); }
+				}
+			}
+
+			for (U32 id : colliderIds) { test(Physics::ColliderBounds(id)); }
+		}
+	});
+
+	U32 hits = 0;
+	U32 mismatches = 0;
+	for (U32 i = 0; i < CheckedRays; ++i)
+	{
+		hits += expected[i].valid;
+		mismatches += results[i].valid != expected[i].valid || (expected[i].valid && Math::Abs(results[i].fraction - expected[i].fraction) > 0.001f);
+	}
+
+	Check(mismatches == 0, "Raycasts hit what testing every tile and collider on its own hits, at the same distance");
+
+	for (U32 id : colliderIds) { Physics::RemoveCollider(id); }
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<TilemapCollider>(entity);
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.DestroyEntity(entity);
+	World::FlushCommands();
+
+	Logger::Info("Raycasts, ", RayCount, " Rays, ", Size, "x", Size, " Tiles, ", ColliderCount, " Colliders: Raycast ", RayCount / singleTime / 1000.0, " Mrays/s, Raycasts On ",
+		Jobs::ThreadCount(), " Threads ", RayCount / batchTime / 1000.0, " Mrays/s, Brute Force Reference ", CheckedRays / referenceTime / 1000.0, " Mrays/s (", hits, " Of ", CheckedRays, " Hit)");
+}
+
+void Benchmarks::Sweeps()
+{
+	constexpr I32 Size = 512;
+	constexpr I32 WallSpacing = 32;
+	constexpr U32 ColliderCount = 300;
+	constexpr U32 CheckedCasts = 20000;
+	constexpr U32 ShotCount = 2000;
+	constexpr U32 ShotFrames = 40;
+	constexpr F32 Speeds[] = { 0.5f, 1.5f, 4.0f, 12.0f };
+	constexpr U32 ProjectileCount = 100000;
+
+	//One tile thick walls hang from the top of the map every WallSpacing columns, with a floor along the bottom
+	EntityRef entity = World::CreateEntity();
+	ComponentRef<Tilemap> tilemap = Tilemap::AddTo(entity, Size, Size);
+	ResourceRef<Texture> texture;
+
+	for (I32 y = 0; y < Size; ++y)
+	{
+		for (I32 x = 0; x < Size; ++x)
+		{
+			if (y >= Size - 4 || (x % WallSpacing == WallSpacing / 2 && y < Size / 2)) { tilemap->SetTile(texture, { x, y }); }
+		}
+	}
+
+	tilemap->Clean();
+
+	ComponentRef<TilemapCollider> collider = TilemapCollider::AddTo(entity, tilemap);
+
+	const TileGrid& tiles = tilemap->GetTiles();
+	Vector2 tileSize = collider->tileSize;
+	Vector2 offset = collider->offset;
+
+	//Center of tile x, y in the world, fractions of a tile are kept
+	auto tileCenter = [&](F32 x, F32 y) { return Vector2{ offset.x + (x + 0.5f) * tileSize.x, offset.y - (y - 0.5f) * tileSize.y }; };
+
+	Random::SeedRandom(CheckedCasts);
+
+	//Thin posts in the lower half, narrower than a tile
+	Vector<U32> colliderIds(ColliderCount);
+	for (U32 i = 0; i < ColliderCount; ++i)
+	{
+		Vector2 position = tileCenter((F32)Random::RandomUniform() * Size, Size * 0.5f + (F32)Random::RandomUniform() * Size * 0.45f);
+		F32 width = 0.05f + (F32)Random::RandomUniform() * 0.25f;
+		colliderIds.Push(Physics::AddCollider({ position + Vector2{ width, 4.0f }, position }, BodyType::Static));
+	}
+
+	Vector<AABB> shapes(CheckedCasts);
+	Vector<Vector2> displacements(CheckedCasts);
+	for (U32 i = 0; i < CheckedCasts; ++i)
+	{
+		Vector2 center = tileCenter((F32)Random::RandomUniform() * Size, (F32)Random::RandomUniform() * Size);
+		Vector2 extents = tileSize * (0.05f + (F32)Random::RandomUniform() * 1.45f);
+		shapes.Push({ center + extents, center - extents });
+		displacements.Push(Vector2{ (F32)Random::RandomUniform() * 40.0f - 20.0f, (F32)Random::RandomUniform() * 40.0f - 20.0f } * tileSize);
+	}
+
+	Vector<RaycastHit> results(CheckedCasts);
+	results.Resize(CheckedCasts);
+
+	F64 castTime = Measure(3, [&]
+	{
+		for (U32 i = 0; i < CheckedCasts; ++i) { results[i] = Physics::ShapeCast(shapes[i], displacements[i]); }
+	});
+
+	//Reference, every solid tile around the swept shape and every collider swept against on its own
+	Vector<RaycastHit> expected(CheckedCasts);
+	expected.Resize(CheckedCasts);
+
+	F64 referenceTime = Measure(1, [&]
+	{
+		for (U32 i = 0; i < CheckedCasts; ++i)
+		{
+			const AABB& shape = shapes[i];
+			const Vector2& displacement = displacements[i];
+			RaycastHit& hit = expected[i];
+			hit = { shape.Center() + displacement, Vector2::Zero, 1.0f, U32_MAX, U32_MAX, false };
+
+			auto test = [&](const AABB& bounds)
+			{
+				F32 fraction;
+				Vector2 normal;
+				if (bounds.Sweep(shape, displacement, hit.fraction, fraction, normal) && (!hit.valid || fraction < hit.fraction))
+				{
+					hit.fraction = fraction;
+					hit.valid = true;
+				}
+			};
+
+			AABB swept = shape.Merged(shape + displacement);
+			I32 minX = Math::Max((I32)Math::Floor((swept.lowerBound.x - offset.x) / tileSize.x) - 1, 0);
+			I32 maxX = Math::Min((I32)Math::Floor((swept.upperBound.x - offset.x) / tileSize.x) + 1, Size - 1);
+			I32 minY = Math::Max((I32)Math::Floor((offset.y - swept.upperBound.y) / tileSize.y) - 1, 0);
+			I32 maxY = Math::Min((I32)Math::Ceiling((offset.y - swept.lowerBound.y) / tileSize.y) + 1, Size - 1);
+
+			for (I32 y = minY; y <= maxY; ++y)
+			{
+				for (I32 x = minX; x <= maxX; ++x)
+				{
+					if (tiles.Get(x, y) == TileType::Full) { test(TileBounds(offset, tileSize, x, y)); }
+				}
+			}
+
+			for (U32 id : colliderIds) { test(Physics::ColliderBounds(id)); }
+		}
+	});
+
+	U32 hits = 0;
+	U32 mismatches = 0;
+	for (U32 i = 0; i < CheckedCasts; ++i)
+	{
+		hits += expected[i].valid;
+		mismatches += results[i].valid != expected[i].valid || (expected[i].valid && Math::Abs(results[i].fraction - expected[i].fraction) > 0.0001f);
+	}
+
+	Check(mismatches == 0, "Shape casts hit what sweeping against every tile and collider on its own hits, at the same time of impact");
+
+	Logger::Info("Shape Casts, ", CheckedCasts, " Casts, ", Size, "x", Size, " Tiles, ", ColliderCount, " Colliders, ", hits, " Hits: ShapeCast ", castTime, "ms, Brute Force Reference ", referenceTime, "ms");
+
+	//Shots fired sideways at a wall, stepped a frame at a time the way projectiles and characters used to move: the target is tested for overlap on x, then on y
+	for (F32 speed : Speeds)
+	{
+		Random::SeedRandom((U32)(speed * 16.0f));
+
+		U32 tunnelledOld = 0;
+		U32 tunnelledNew = 0;
+		U64 queriesOld = 0;
+		U64 queriesNew = 0;
+
+		Vector2 extents = tileSize * 0.1f;
+		Vector2 velocity{ speed * tileSize.x, 0.0f };
+
+		for (U32 i = 0; i < ShotCount; ++i)
+		{
+			I32 wall = (I32)(Random::RandomUniform() * (Size / WallSpacing)) * WallSpacing + WallSpacing / 2;
+			Vector2 start = tileCenter(wall - 14.0f + (F32)Random::RandomUniform() * 12.0f, Size * 0.1f + (F32)Random::RandomUniform() * Size * 0.35f);
+			F32 behindWall = offset.x + (wall + 1) * tileSize.x;
+
+			Vector2 position = start;
+			for (U32 frame = 0; frame < ShotFrames; ++frame)
+			{
+				queriesOld += 2;
+				AABB moved = AABB{ position + extents, position - extents } + Vector2{ velocity.x, 0.0f };
+				if (Physics::CheckCollision(moved)) { break; }
+				position.x += velocity.x;
+
+				moved = AABB{ position + extents, position - extents } + Vector2{ 0.0f, velocity.y };
+				if (Physics::CheckCollision(moved)) { break; }
+				position.y += velocity.y;
+			}
+
+			tunnelledOld += position.x > behindWall;
+
+			position = start;
+			for (U32 frame = 0; frame < ShotFrames; ++frame)
+			{
+				++queriesNew;
+				RaycastHit hit = Physics::ShapeCast({ position + extents, position - extents }, velocity);
+				if (hit) { position = hit.point; break; }
+				position += velocity;
+			}
+
+			tunnelledNew += position.x > behindWall;
+		}
+
+		Check(tunnelledNew == 0, "Swept shots never pass through a wall");
+
+		Logger::Info("Tunnelling, ", ShotCount, " Shots At ", speed, " Tiles/Frame: Two Axis Overlap ", tunnelledOld, " Tunnelled (", queriesOld, " Queries), ShapeCast ", tunnelledNew,
+			" Tunnelled (", queriesNew, " Queries)");
+	}
+
+	//A frame of projectiles, one batched sweep against the two batched overlap passes it replaces
+	Random::SeedRandom(ProjectileCount);
+
+	Vector<AABB> projectiles(ProjectileCount);
+	Vector<Vector2> steps(ProjectileCount);
+	Vector<AABB> movedX(ProjectileCount);
+	Vector<AABB> movedY(ProjectileCount);
+	for (U32 i = 0; i < ProjectileCount; ++i)
+	{
+		Vector2 center = tileCenter((F32)Random::RandomUniform() * Size, (F32)Random::RandomUniform() * (Size - 5));
+		Vector2 step = Vector2{ (F32)Random::RandomUniform() - 0.5f, (F32)Random::RandomUniform() - 0.5f } * tileSize;
+		AABB projectile{ center + tileSize * 0.1f, center - tileSize * 0.1f };
+
+		projectiles.Push(projectile);
+		steps.Push(step);
+		movedX.Push(projectile + Vector2{ step.x, 0.0f });
+		movedY.Push(projectile + Vector2{ 0.0f, step.y });
+	}
+
+	Vector<RaycastHit> sweepResults(ProjectileCount);
+	Vector<Collision> overlapResults(ProjectileCount);
+	sweepResults.Resize(ProjectileCount);
+	overlapResults.Resize(ProjectileCount);
+
+	F64 sweepTime = Measure(3, [&] { Physics::ShapeCasts(projectiles.Data(), steps.Data(), ProjectileCount, sweepResults.Data()); });
+	F64 overlapTime = Measure(3, [&]
+	{
+		Physics::CheckCollisions(movedX.Data(), ProjectileCount, overlapResults.Data());
+		Physics::CheckCollisions(movedY.Data(), ProjectileCount, overlapResults.Data());
+	});
+
+	for (U32 id : colliderIds) { Physics::RemoveCollider(id); }
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<TilemapCollider>(entity);
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.DestroyEntity(entity);
+	World::FlushCommands();
+
+	Logger::Info("Projectile Moves, ", ProjectileCount, " Projectiles: ShapeCasts ", sweepTime, "ms (1 Query Each), Two CheckCollisions Passes ", overlapTime, "ms (2 Queries Each)");
+}
+
+void Benchmarks::TilemapFiles()
+{
+	constexpr I32 Size = 4096;
+	constexpr I32 RegionSize = 256;
+	const String path = "benchmark.nhtm";
+
+	EntityRef entity = World::CreateEntity();
+	ComponentRef<Tilemap> tilemap = AddTerrain(entity, Size, Size);
+	const TileGrid& tiles = tilemap->GetTiles();
+
+	bool saved = false;
+	F64 saveTime = Measure(1, [&] { saved = tilemap->Save(path); });
+
+	Check(saved, "A tilemap saves to a .nhtm file");
+
+	I64 fileSize;
+	{
+		File file(path, FILE_OPEN_RESOURCE_READ);
+		fileSize = file.Size();
+	}
+
+	TileGrid loaded;
+	bool read = false;
+	F64 loadTime = Measure(3, [&] { read = loaded.Load(path); });
+
+	U32 mismatches = 0;
+	for (I32 y = 0; y < Size; ++y)
+	{
+		for (I32 x = 0; x < Size; ++x) { mismatches += loaded.Get(x, y) != tiles.Get(x, y); }
+	}
+
+	Check(read && loaded.Dimensions() == tiles.Dimensions() && mismatches == 0, "Loading a saved tilemap gives back every tile");
+
+	//A window across the surface, tiles outside of it have to stay untouched
+	Vector2Int min{ Size / 3, Size / 2 - RegionSize / 2 };
+	Vector2Int max = min + Vector2Int{ RegionSize - 1, RegionSize - 1 };
+
+	TileGrid region;
+	region.Create({ Size, Size });
+	read = false;
+	F64 regionTime = Measure(1, [&] { read = region.LoadRegion(path, min, max); });
+
+	//Whole chunks are read, so the region is rounded out to chunk edges
+	Vector2Int chunkMin{ min.x & ~(TileGrid::ChunkSize - 1), min.y & ~(TileGrid::ChunkSize - 1) };
+	Vector2Int chunkMax{ max.x | (TileGrid::ChunkSize - 1), max.y | (TileGrid::ChunkSize - 1) };
+
+	mismatches = 0;
+	U32 outside = 0;
+	for (I32 y = 0; y < Size; ++y)
+	{
+		for (I32 x = 0; x < Size; ++x)
+		{
+			bool inside = x >= chunkMin.x && x <= chunkMax.x && y >= chunkMin.y && y <= chunkMax.y;
+			if (inside) { mismatches += region.Get(x, y) != tiles.Get(x, y); }
+			else { outside += region.Get(x, y) != TileType::Air; }
+		}
+	}
+
+	Check(read && mismatches == 0, "A loaded region matches the saved tiles");
+	Check(outside == 0, "Loading a region leaves the rest of the grid empty");
+
+	//Through the component the loaded tiles are also drawn
+	EntityRef copyEntity = World::CreateEntity();
+	ComponentRef<Tilemap> copy = Tilemap::AddTo(copyEntity, Size, Size);
+	read = false;
+	F64 componentTime = Measure(1, [&] { read = copy->Load(path, {}); });
+
+	mismatches = 0;
+	const TileGrid& copyTiles = copy->GetTiles();
+	for (I32 y = 0; y < Size; ++y)
+	{
+		for (I32 x = 0; x < Size; ++x) { mismatches += copyTiles.Get(x, y) != tiles.Get(x, y); }
+	}
+
+	Check(read && mismatches == 0, "Tilemap::Load gives back every tile");
+
+	U64 memory = loaded.MemoryUsage();
+
+	File::Delete(path);
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<Tilemap>(entity);
+	commands.RemoveComponent<Tilemap>(copyEntity);
+	commands.DestroyEntity(entity);
+	commands.DestroyEntity(copyEntity);
+	World::FlushCommands();
+
+	Logger::Info("Tilemap Files, ", Size, "x", Size, " Tiles: File ", fileSize / 1024, "KB (", (U64)Size * Size / 1024, "KB As One Byte Per Tile, ", memory / 1024, "KB Once Loaded), Save ", saveTime,
+		"ms, Load ", loadTime, "ms, Tilemap::Load ", componentTime, "ms, ", RegionSize, "x", RegionSize, " Region ", regionTime, "ms");
+
+	//A wide world that's nearly all sky over a thin band of ground, only chunks along the surface should need a block
+	constexpr I32 SkyWidth = 65536;
+	constexpr I32 SkyHeight = 4096;
+	constexpr I32 CheckedColumn = 61;
+
+	auto surface = [](I32 x) { return SkyHeight - 192 - (I32)(48.0f * Math::Sin(x * 0.003f) + 16.0f * Math::Sin(x * 0.021f)); };
+
+	TileGrid sky;
+	F64 fillTime = Measure(1, [&]
+	{
+		sky.Create({ SkyWidth, SkyHeight });
+		for (I32 x = 0; x < SkyWidth; ++x)
+		{
+			for (I32 y = surface(x); y < SkyHeight; ++y) { sky.Set(x, y, TileType::Full); }
+		}
+
+		sky.CleanChunks();
+	});
+
+	//Filling tile by tile gives every chunk under the surface a block on the way, CleanChunks frees them for reuse but keeps their capacity,
+	//a loaded map only ever allocates the blocks it keeps
+	U64 filledMemory = sky.MemoryUsage();
+	bool skySaved = sky.Save(path);
+	sky.Destroy();
+
+	TileGrid loadedSky;
+	read = loadedSky.Load(path);
+	File::Delete(path);
+
+	mismatches = 0;
+	for (I32 x = 0; x < SkyWidth; x += CheckedColumn)
+	{
+		I32 ground = surface(x);
+		for (I32 y = 0; y < SkyHeight; ++y) { mismatches += loadedSky.Get(x, y) != (y < ground ? TileType::Air : TileType::Full); }
+	}
+
+	U64 skyMemory = loadedSky.MemoryUsage();
+	U64 denseMemory = (U64)SkyWidth * SkyHeight * sizeof(TileType);
+
+	Check(skySaved && read && mismatches == 0, "A mostly empty map saves and loads every tile it was given");
+	Check(skyMemory < denseMemory / 16, "A mostly empty map takes a small fraction of one byte per tile");
+
+	loadedSky.Destroy();
+
+	Logger::Info("Sparse Tilemap, ", SkyWidth, "x", SkyHeight, " Tiles Mostly Sky: MemoryUsage ", skyMemory / 1024, "KB Once Loaded (", filledMemory / 1024, "KB Right After Filling), Dense Width x Height ",
+		denseMemory / 1024, "KB, Filled In ", fillTime, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include "Benchmarks.hpp"
+
+#include "Resources/World.hpp"
+#include "Resources/SpriteComponent.hpp"
+#include "Resources/ProjectileComponent.hpp"
+#include "Resources/Hierarchy.hpp"
+
+//Counts live copies so captures that are never destroyed show up
+struct TrackedCapture
+{
+	TrackedCapture() { ++alive; }
+	TrackedCapture(const TrackedCapture&) { ++alive; }
+	TrackedCapture(TrackedCapture&&) noexcept { ++alive; }
+	~TrackedCapture() { --alive; }
+
+	static I32 alive;
+};
+
+I32 TrackedCapture::alive = 0;
+
+void Benchmarks::Query()
+{
+	constexpr U32 EntityCount = 8192;
+	constexpr U32 DoubleSprites = 64;
+
+	Vector<U32> entityIds(EntityCount);
+	World::CreateEntities(EntityCount, entityIds.Data());
+
+	for (U32 i = 0; i < EntityCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+
+		Sprite::AddTo(entity);
+		if (i < DoubleSprites) { Sprite::AddTo(entity); }
+		if (i % 8 == 0) { Projectile::AddTo(entity, Vector2::Zero); }
+	}
+
+	U32 secondSprites = 0;
+	for (U32 i = 0; i < DoubleSprites; ++i)
+	{
+		U32 first = Sprite::IndexOf(entityIds[i]);
+		secondSprites += first != U32_MAX && Sprite::NextOf(first) != U32_MAX;
+	}
+
+	Check(secondSprites == DoubleSprites, "Every sprite of an entity is reachable from its lookup");
+
+	//Reference, join every sprite slot with a lookup into the projectile pool
+	U64 expected = 0;
+	U32 expectedRows = 0;
+	F64 joinTime = Measure(50, [&]
+	{
+		expected = 0;
+		expectedRows = 0;
+
+		for (U32 i = 0; i < Sprite::SlotCount(); ++i)
+		{
+			U32 entityId = Sprite::Get(i)->EntityIndex();
+			if (entityId == U32_MAX) { continue; }
+
+			U32 projectile = Projectile::IndexOf(entityId);
+			if (projectile == U32_MAX) { continue; }
+
+			expected += entityId;
+			expectedRows += Projectile::Get(projectile)->EntityIndex() == entityId;
+		}
+	});
+
+	F64 buildTime = Measure(50, [&]
+	{
+		ComponentQuery<Sprite, Projectile> query;
+		query.Refresh();
+	});
+
+	ComponentQuery<Sprite, Projectile>& query = World::Query<Sprite, Projectile>();
+
+	U64 sum = 0;
+	U32 rows = 0;
+	F64 iterateTime = Measure(50, [&]
+	{
+		sum = 0;
+		rows = 0;
+
+		query.ForEach([&](const EntityRef& entity, Sprite& sprite, Projectile& projectile)
+		{
+			sum += entity.EntityId();
+			rows += projectile.EntityIndex() == sprite.EntityIndex();
+		});
+	});
+
+	Check(rows == expectedRows && sum == expected, "Query<Sprite, Projectile> matches a lookup join");
+	Check(expectedRows == EntityCount / 8 + DoubleSprites / 8, "Query has a row for every sprite on an entity with a projectile");
+
+	Logger::Info("Query<Sprite, Projectile>, ", query.Size(), " Rows: Build ", buildTime, "ms, ForEach ", iterateTime, "ms, Lookup Join ", joinTime, "ms");
+
+	EntityCommandBuffer& commands = World::Commands();
+	for (U32 i = 0; i < EntityCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+
+		commands.RemoveComponent<Sprite>(entity);
+		if (i < DoubleSprites) { commands.RemoveComponent<Sprite>(entity); }
+		if (i % 8 == 0) { commands.RemoveComponent<Projectile>(entity); }
+		commands.DestroyEntity(entity);
+	}
+
+	World::FlushCommands();
+
+	Check(World::Query<Sprite, Projectile>().Size() == 0, "Removing the components empties the query");
+}
+
+void Benchmarks::Commands()
+{
+	constexpr U32 EntityCount = 65536;
+
+	EntityCommandBuffer& commands = World::Commands();
+	Vector<U32> entityIds(EntityCount);
+	U32 created = 0;
+
+	F64 recordTime = Measure(1, [&]
+	{
+		TrackedCapture capture;
+		String name = "A capture too long to be stored inline";
+
+		for (U32 i = 0; i < EntityCount; ++i)
+		{
+			commands.CreateEntity(Vector2{ (F32)i, 0.0f }, Vector2::One, Quaternion2::Identity, [&created, &entityIds, capture, name](const EntityRef& entity)
+			{
+				entityIds[created++] = entity.EntityId();
+			});
+		}
+	});
+
+	F64 playbackTime = Measure(1, [&] { World::FlushCommands(); });
+
+	Check(created == EntityCount, "Every recorded entity is created");
+	Check(TrackedCapture::alive == 0, "Captures are destroyed once they run");
+
+	for (U32 i = 0; i < EntityCount; ++i) { commands.DestroyEntity({ entityIds[i] }); }
+
+	F64 destroyTime = Measure(1, [&] { World::FlushCommands(); });
+
+	{
+		TrackedCapture capture;
+		for (U32 i = 0; i < 1024; ++i) { commands.CreateEntity(Vector2::Zero, Vector2::One, Quaternion2::Identity, [capture](const EntityRef&) {}); }
+	}
+
+	commands.Clear();
+	Check(TrackedCapture::alive == 0, "Clear destroys the captures of pending commands");
+
+	Logger::Info("EntityCommandBuffer, ", EntityCount, " Entities: Record ", recordTime, "ms, Create Playback ", playbackTime, "ms, Destroy Playback ", destroyTime, "ms");
+}
+
+void Benchmarks::Spawn()
+{
+	constexpr U32 EntityCount = Projectile::MaxProjectiles;
+
+	Prefab prefab{ Vector2{ 3.0f, -2.0f }, Vector2{ 0.5f, 0.5f } };
+	prefab.Add<Projectile>({ .velocity = Vector2{ 0.0f, -10.0f }, .duration = 5.0f });
+
+	Vector<U32> entityIds(EntityCount);
+	EntityCommandBuffer& commands = World::Commands();
+
+	//Reference, one entity and one component at a time
+	F64 singleTime = Measure(1, [&]
+	{
+		for (U32 i = 0; i < EntityCount; ++i)
+		{
+			EntityRef entity = World::CreateEntity(prefab.position, prefab.scale);
+			Projectile::AddTo(entity, Vector2{ 0.0f, -10.0f }, 5.0f);
+			entityIds[i] = entity.EntityId();
+		}
+	});
+
+	for (U32 i = 0; i < EntityCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		commands.RemoveComponent<Projectile>(entity);
+		commands.DestroyEntity(entity);
+	}
+
+	World::FlushCommands();
+
+	U32 spawned = 0;
+	F64 batchTime = Measure(1, [&]
+	{
+		spawned = World::Instantiate(prefab, EntityCount, [&](const EntityRef& entity, U32 i) { entityIds[i] = entity.EntityId(); });
+	});
+
+	Check(spawned == EntityCount, "Instantiate spawns every entity while there is room");
+
+	U32 matching = 0;
+	for (U32 i = 0; i < spawned; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		ComponentRef<Projectile> projectile = Projectile::GetRef(entity);
+
+		matching += projectile && projectile->Position() == prefab.position && projectile->Velocity() == Vector2{ 0.0f, -10.0f } &&
+			entity->position == prefab.position && entity->scale == prefab.scale;
+	}
+
+	Check(matching == EntityCount, "Instantiated entities match the prefab");
+	Check(World::Instantiate(prefab, 1) == 0, "Instantiate stops at component capacity");
+
+	for (U32 i = 0; i < spawned; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+		commands.RemoveComponent<Projectile>(entity);
+		commands.DestroyEntity(entity);
+	}
+
+	World::FlushCommands();
+
+	Check(Projectile::FreeCount() == EntityCount, "Every projectile is released");
+
+	Logger::Info("Prefab Instantiate, ", EntityCount, " Entities: Instantiate ", batchTime, "ms (", EntityCount / batchTime, " Per ms), One By One ", singleTime, "ms");
+}
+
+void Benchmarks::Transforms()
+{
+	constexpr U32 NodeCount = 100000;
+	constexpr U32 Branching = 4;
+
+	Vector<U32> entityIds(NodeCount);
+	World::CreateEntities(NodeCount, entityIds.Data());
+
+	for (U32 i = 0; i < NodeCount; ++i)
+	{
+		EntityRef entity{ entityIds[i] };
+
+		if (i) { Hierarchy::SetParent(entity, EntityRef{ entityIds[(i - 1) / Branching] }); }
+		Hierarchy::SetLocalTransform(entity, Vector2{ 1.0f, (i % 3) * 0.25f }, Vector2{ 1.0f + (i % 2) * 0.01f }, Quaternion2{ (i % 7) * 3.0f });
+	}
+
+	//Reference, composes the local transforms up each node's chain of parents, uniform scales and 2D rotations commute
+	auto mismatches = [&]
+	{
+		U32 count = 0;
+
+		for (U32 i = 0; i < NodeCount; ++i)
+		{
+			const HierarchyNode& node = *Hierarchy::Node(entityIds[i]);
+			Vector2 position = node.localPosition;
+
+			for (U32 j = i; j != 0;)
+			{
+				j = (j - 1) / Branching;
+				const HierarchyNode& parent = *Hierarchy::Node(entityIds[j]);
+				position = parent.localPosition + (position * parent.localScale) * parent.localRotation;
+			}
+
+			Vector2 difference = World::GetEntity(entityIds[i]).position - position;
+			count += Math::Abs(difference.x) > 0.001f || Math::Abs(difference.y) > 0.001f;
+		}
+
+		return count;
+	};
+
+	Vector<Entity>& entities = World::entities;
+
+	F64 buildTime = Measure(1, [&] { Hierarchy::Update(entities); });
+
+	Check(Hierarchy::NodeCount() == NodeCount, "Every parented entity has a node");
+	Check(mismatches() == 0, "World transforms match composing each chain of parents");
+
+	F64 staticTime = Measure(20, [&] { Hierarchy::Update(entities); });
+
+	F64 rootTime = Measure(20, [&]
+	{
+		World::GetEntity(entityIds[0]).position.x += 1.0f;
+		Hierarchy::Update(entities);
+	});
+
+	Check(mismatches() == 0, "Moving the root moves every descendant");
+
+	F64 leafTime = Measure(20, [&]
+	{
+		Hierarchy::SetLocalPosition(EntityRef{ entityIds[NodeCount - 1] }, Vector2{ 2.0f, 0.0f });
+		Hierarchy::Update(entities);
+	});
+
+	//Destroying the root first turns its children into roots that keep their world transform
+	Vector2 childPosition = World::GetEntity(entityIds[1]).position;
+
+	EntityCommandBuffer& commands = World::Commands();
+	commands.DestroyEntity(EntityRef{ entityIds[0] });
+	World::FlushCommands();
+	Hierarchy::Update(entities);
+
+	Check(!Hierarchy::GetParent(EntityRef{ entityIds[1] }).Valid() && World::GetEntity(entityIds[1]).position == childPosition, "Children of a destroyed entity become roots in place");
+
+	for (U32 i = 1; i < NodeCount; ++i) { commands.DestroyEntity(EntityRef{ entityIds[i] }); }
+
+	F64 destroyTime = Measure(1, [&] { World::FlushCommands(); });
+
+	Hierarchy::Update(entities);
+	Check(Hierarchy::NodeCount() == 0, "Destroying every entity empties the hierarchy");
+
+	Logger::Info("Hierarchy, ", NodeCount, " Nodes: First Update ", buildTime, "ms, Static ", staticTime, "ms, Root Moved ", rootTime, "ms, Leaf Moved ", leafTime, "ms, Destroy All ", destroyTime, "ms");
+}
\ No newline at end of file
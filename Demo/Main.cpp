@@ -27,6 +27,9 @@ ComponentRef<Tilemap> mainTilemap;
 ComponentRef<Tilemap> backgroundTilemap;
 ComponentRef<Tilemap> foregroundTilemap;
 ComponentRef<Character> character;
+Prefab burstPrefab{ Vector2::Zero, Vector2{ 0.5f, 0.5f } };
+
+constexpr U32 BurstSize = 32;
 
 void ComponentsInit()
 {
@@ -72,9 +75,19 @@ bool ProjectileHit(const EntityRef& ref, bool hitVertical)
 {
 	Particles::Spawn(ref->position, groundTexture);
 
-	Sprite::RemoveFrom(ref);
-	Projectile::RemoveFrom(ref);
-	World::DestroyEntity(ref);
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<Sprite>(ref);
+	commands.RemoveComponent<Projectile>(ref);
+	commands.DestroyEntity(ref);
+	return false;
+}
+
+bool ProjectileExpire(const EntityRef& ref)
+{
+	EntityCommandBuffer& commands = World::Commands();
+	commands.RemoveComponent<Sprite>(ref);
+	commands.RemoveComponent<Projectile>(ref);
+	commands.DestroyEntity(ref);
 	return false;
 }
 
@@ -140,12 +153,14 @@ bool Initialize()
 	
 	TilemapCollider::AddTo(tilemap, mainTilemap);
 
+	burstPrefab.Add<Sprite>({ .texture = groundTexture }).Add<Projectile>({ .duration = 2.0f });
+
 	return true;
 }
 
 void Shutdown()
 {
-
+	burstPrefab.Destroy();
 }
 
 void Update()
@@ -157,7 +172,22 @@ void Update()
 		ComponentRef<Sprite> s = Sprite::AddTo(id, groundTexture);
 		Vector2 dir = (World::ScreenToWorld(Input::MousePosition()) - player->position).Normalized();
 		ComponentRef<Projectile> p = Projectile::AddTo(id, dir * 20.0f, 0.0f, 0.0f);
-		if (s && p) { p->OnHit += ProjectileHit; }
+		if (s && p) { p->OnHit() += ProjectileHit; }
+	}
+
+	if (Input::OnButtonDown(ButtonCode::Q))
+	{
+		burstPrefab.position = player->position;
+
+		World::Instantiate(burstPrefab, BurstSize, [](const EntityRef& entity, U32 i)
+		{
+			F32 angle = (F32)(i * TwoPi / BurstSize);
+
+			ComponentRef<Projectile> p = Projectile::GetRef(entity);
+			p->SetVelocity(Vector2{ Math::Cos(angle), Math::Sin(angle) } * 20.0f);
+			p->OnHit() += ProjectileHit;
+			p->OnExpire() += ProjectileExpire;
+		});
 	}
 
 	if (Input::ButtonDown(ButtonCode::LeftMouse))
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Vector.hpp"
+
+struct DirtyRange
+{
+	U32 start;	//First modified element
+	U32 end;	//One past the last modified element
+};
+
+/// <summary>
+/// Tracks which elements of an array were modified since the last Clear, ranges are kept sorted and overlapping or adjacent ranges
+/// are merged on insertion, once more than MaxRanges exist the closest ranges are joined so the copy list stays small
+/// </summary>
+struct NH_API DirtyRanges
+{
+	static constexpr U32 MaxRanges = 1024;		//One copy command takes hundreds of regions, fewer would join scattered edits into most of the array
+
+	/// <summary>
+	/// Marks count elements starting at start as modified
+	/// </summary>
+	void Mark(U32 start, U32 count = 1);
+
+	/// <summary>
+	/// Marks every range of other as modified
+	/// </summary>
+	void Mark(const DirtyRanges& other);
+
+	/// <summary>
+	/// Drops everything at or past count, used when the tracked array shrinks
+	/// </summary>
+	void Clamp(U32 count);
+	void Clear();
+	void Destroy();
+
+	bool Empty() const;
+	U32 Count() const;
+
+	/// <summary>
+	/// The total amount of modified elements
+	/// </summary>
+	U32 Elements() const;
+
+	const DirtyRange* Data() const;
+	const DirtyRange* begin() const;
+	const DirtyRange* end() const;
+
+private:
+	void Insert(U32 start, U32 end);
+	void Collapse();
+
+	Vector<DirtyRange> ranges;
+};
+
+inline void DirtyRanges::Mark(U32 start, U32 count)
+{
+	if (count == 0) { return; }
+
+	U32 end = start + count;
+
+	//Sequential writes are the common case, extend the last range without searching
+	if (ranges.Size())
+	{
+		DirtyRange& last = ranges.Back();
+		if (start >= last.start && start <= last.end)
+		{
+			if (end > last.end) { last.end = end; }
+			return;
+		}
+	}
+
+	Insert(start, end);
+}
+
+inline void DirtyRanges::Mark(const DirtyRanges& other)
+{
+	for (const DirtyRange& range : other.ranges) { Insert(range.start, range.end); }
+}
+
+inline void DirtyRanges::Insert(U32 start, U32 end)
+{
+	//First range that ends at or after start, everything before it can't touch the new range
+	U64 low = 0;
+	U64 high = ranges.Size();
+	while (low < high)
+	{
+		U64 mid = (low + high) / 2;
+		if (ranges[mid].end < start) { low = mid + 1; }
+		else { high = mid; }
+	}
+
+	U64 first = low;
+	U64 last = first;
+	while (last < ranges.Size() && ranges[last].start <= end)
+	{
+		if (ranges[last].start < start) { start = ranges[last].start; }
+		if (ranges[last].end > end) { end = ranges[last].end; }
+		++last;
+	}
+
+	if (first == last) { ranges.Insert(first, DirtyRange{ start, end }); }
+	else
+	{
+		ranges[first] = { start, end };
+		if (last > first + 1) { ranges.Erase(first + 1, last); }
+	}
+
+	if (ranges.Size() > MaxRanges) { Collapse(); }
+}
+
+inline void DirtyRanges::Collapse()
+{
+	U32 bestGap = U32_MAX;
+
+	for (U64 i = 0; i + 1 < ranges.Size(); ++i)
+	{
+		U32 gap = ranges[i + 1].start - ranges[i].end;
+		if (gap < bestGap) { bestGap = gap; }
+	}
+
+	//Every gap as small as the smallest is joined at once, evenly spaced edits would otherwise rescan the ranges on every insert
+	U64 count = 1;
+	for (U64 i = 1; i < ranges.Size(); ++i)
+	{
+		if (ranges[i].start - ranges[count - 1].end <= bestGap) { ranges[count - 1].end = ranges[i].end; }
+		else { ranges[count++] = ranges[i]; }
+	}
+
+	ranges.Resize(count);
+}
+
+inline void DirtyRanges::Clamp(U32 count)
+{
+	while (ranges.Size() && ranges.Back().start >= count) { ranges.Pop(); }
+
+	if (ranges.Size() && ranges.Back().end > count) { ranges.Back().end = count; }
+}
+
+inline void DirtyRanges::Clear()
+{
+	ranges.Clear();
+}
+
+inline void DirtyRanges::Destroy()
+{
+	ranges.Destroy();
+}
+
+inline bool DirtyRanges::Empty() const
+{
+	return ranges.Size() == 0;
+}
+
+inline U32 DirtyRanges::Count() const
+{
+	return (U32)ranges.Size();
+}
+
+inline U32 DirtyRanges::Elements() const
+{
+	U32 elements = 0;
+	for (const DirtyRange& range : ranges) { elements += range.end - range.start; }
+
+	return elements;
+}
+
+inline const DirtyRange* DirtyRanges::Data() const
+{
+	return ranges.Data();
+}
+
+inline const DirtyRange* DirtyRanges::begin() const
+{
+	return ranges.Data();
+}
+
+inline const DirtyRange* DirtyRanges::end() const
+{
+	return ranges.Data() + ranges.Size();
+}
\ No newline at end of file
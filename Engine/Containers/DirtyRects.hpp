@@ -0,0 +1,192 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Vector.hpp"
+#include "DirtyRanges.hpp"
+#include "Math/Math.hpp"
+
+struct DirtyRect
+{
+	Vector2Int min;	//First modified cell
+	Vector2Int max;	//Last modified cell, inclusive
+
+	U64 Area() const { return (U64)(max.x - min.x + 1) * (U64)(max.y - min.y + 1); }
+};
+
+/// <summary>
+/// Tracks which cells of a row-major grid were modified since the last Clear, rects that overlap or share an edge are merged on insertion
+/// so no cell is copied twice, once more than MaxRects exist the pair whose union wastes the least is joined and merged again
+/// </summary>
+struct NH_API DirtyRects
+{
+	static constexpr U32 MaxRects = 16;
+
+	/// <summary>
+	/// Marks every cell from min to max, inclusive, as modified
+	/// </summary>
+	void Mark(const Vector2Int& min, const Vector2Int& max);
+	void Mark(const Vector2Int& cell);
+	void Clear();
+	void Destroy();
+
+	bool Empty() const;
+	U32 Count() const;
+
+	/// <summary>
+	/// The total amount of modified cells
+	/// </summary>
+	U64 Cells() const;
+
+	/// <summary>
+	/// Appends the modified cells as ranges of a row-major array width cells wide starting at offset, one range per row of each rect,
+	/// rects spanning the whole width are a single range
+	/// </summary>
+	void Ranges(U32 width, U32 offset, Vector<DirtyRange>& ranges) const;
+
+	const DirtyRect* begin() const;
+	const DirtyRect* end() const;
+
+private:
+	void Insert(DirtyRect rect);
+
+	static bool Touching(const DirtyRect& a, const DirtyRect& b);
+	static DirtyRect Union(const DirtyRect& a, const DirtyRect& b);
+	static I64 Waste(const DirtyRect& a, const DirtyRect& b);
+
+	Vector<DirtyRect> rects;
+};
+
+inline void DirtyRects::Mark(const Vector2Int& min, const Vector2Int& max)
+{
+	Insert({ min, max });
+
+	while (rects.Size() > MaxRects)
+	{
+		U64 bestA = 0;
+		U64 bestB = 1;
+		I64 bestWaste = I64_MAX;
+
+		for (U64 a = 0; a < rects.Size(); ++a)
+		{
+			for (U64 b = a + 1; b < rects.Size(); ++b)
+			{
+				I64 waste = Waste(rects[a], rects[b]);
+				if (waste < bestWaste) { bestWaste = waste; bestA = a; bestB = b; }
+			}
+		}
+
+		//The union can reach over other rects, so it goes back in like a newly marked one
+		DirtyRect joined = Union(rects[bestA], rects[bestB]);
+		rects.RemoveSwap(bestB);
+		rects.RemoveSwap(bestA);
+		Insert(joined);
+	}
+}
+
+inline void DirtyRects::Insert(DirtyRect rect)
+{
+	//Each merge grows the rect into ones checked earlier, so scan again until nothing merges
+	bool merged = true;
+	while (merged)
+	{
+		merged = false;
+
+		for (U64 i = 0; i < rects.Size(); ++i)
+		{
+			if (!Touching(rect, rects[i])) { continue; }
+
+			rect = Union(rect, rects[i]);
+			rects.RemoveSwap(i);
+			merged = true;
+			break;
+		}
+	}
+
+	rects.Push(rect);
+}
+
+inline void DirtyRects::Mark(const Vector2Int& cell)
+{
+	Mark(cell, cell);
+}
+
+inline void DirtyRects::Clear()
+{
+	rects.Clear();
+}
+
+inline void DirtyRects::Destroy()
+{
+	rects.Destroy();
+}
+
+inline bool DirtyRects::Empty() const
+{
+	return rects.Size() == 0;
+}
+
+inline U32 DirtyRects::Count() const
+{
+	return (U32)rects.Size();
+}
+
+inline U64 DirtyRects::Cells() const
+{
+	U64 cells = 0;
+	for (const DirtyRect& rect : rects) { cells += rect.Area(); }
+
+	return cells;
+}
+
+inline void DirtyRects::Ranges(U32 width, U32 offset, Vector<DirtyRange>& ranges) const
+{
+	for (const DirtyRect& rect : rects)
+	{
+		U32 start = offset + rect.min.x + rect.min.y * width;
+
+		if (rect.min.x == 0 && rect.max.x == (I32)width - 1)
+		{
+			ranges.Push({ start, start + width * (rect.max.y - rect.min.y + 1) });
+			continue;
+		}
+
+		U32 count = rect.max.x - rect.min.x + 1;
+		for (I32 y = rect.min.y; y <= rect.max.y; ++y, start += width) { ranges.Push({ start, start + count }); }
+	}
+}
+
+inline const DirtyRect* DirtyRects::begin() const
+{
+	return rects.Data();
+}
+
+inline const DirtyRect* DirtyRects::end() const
+{
+	return rects.Data() + rects.Size();
+}
+
+inline bool DirtyRects::Touching(const DirtyRect& a, const DirtyRect& b)
+{
+	//Overlapping on one axis and at most adjacent on the other, rects that only meet at a corner stay apart
+	bool overlapX = a.min.x <= b.max.x && b.min.x <= a.max.x;
+	bool overlapY = a.min.y <= b.max.y && b.min.y <= a.max.y;
+	bool adjacentX = a.min.x <= b.max.x + 1 && b.min.x <= a.max.x + 1;
+	bool adjacentY = a.min.y <= b.max.y + 1 && b.min.y <= a.max.y + 1;
+
+	return (overlapX && adjacentY) || (overlapY && adjacentX);
+}
+
+inline DirtyRect DirtyRects::Union(const DirtyRect& a, const DirtyRect& b)
+{
+	return {
+		{ Math::Min(a.min.x, b.min.x), Math::Min(a.min.y, b.min.y) },
+		{ Math::Max(a.max.x, b.max.x), Math::Max(a.max.y, b.max.y) }
+	};
+}
+
+inline I64 DirtyRects::Waste(const DirtyRect& a, const DirtyRect& b)
+{
+	//Cells the union would copy beyond what copying both rects separately costs, overlapping cells count twice when separate
+	return (I64)Union(a, b).Area() - (I64)a.Area() - (I64)b.Area();
+}
\ No newline at end of file
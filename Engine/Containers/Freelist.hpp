@@ -19,6 +19,7 @@ public:
 	void Reset();
 
 	U32 GetFree();
+	U32 GetFree(U32 count, U32* indices);
 	void Release(U32 index);
 
 	bool Full() const;
@@ -35,6 +36,10 @@ private:
 	U32 freeCount = 0;
 	U32* freeIndices = nullptr;
 	U32 lastFree = 0;
+
+#ifdef NH_DEBUG
+	U64* taken = nullptr;	//One bit per index, set while it's handed out so releasing an index twice is caught in constant time
+#endif
 };
 
 inline Freelist::Freelist() {}
@@ -42,6 +47,9 @@ inline Freelist::Freelist() {}
 inline Freelist::Freelist(U32 count) : capacity(count)
 {
 	Memory::Allocate(&freeIndices, count);
+#ifdef NH_DEBUG
+	Memory::Allocate(&taken, (count + 63) / 64);
+#endif
 }
 
 inline Freelist& Freelist::operator()(U32 count)
@@ -57,6 +65,9 @@ inline Freelist& Freelist::operator()(U32 count)
 	lastFree = 0;
 	capacity = count;
 	Memory::Allocate(&freeIndices, count);
+#ifdef NH_DEBUG
+	Memory::Allocate(&taken, (count + 63) / 64);
+#endif
 
 	return *this;
 }
@@ -73,6 +84,9 @@ inline void Freelist::Destroy()
 	lastFree = 0;
 
 	Memory::Free(&freeIndices);
+#ifdef NH_DEBUG
+	Memory::Free(&taken);
+#endif
 }
 
 inline void Freelist::Reset()
@@ -81,6 +95,9 @@ inline void Freelist::Reset()
 	lastFree = 0;
 	used = 0;
 	memset(freeIndices, 0, sizeof(U32) * capacity);
+#ifdef NH_DEBUG
+	memset(taken, 0, sizeof(U64) * ((capacity + 63) / 64));
+#endif
 }
 
 inline U32 Freelist::GetFree()
@@ -89,18 +106,47 @@ inline U32 Freelist::GetFree()
 
 	U32 index = SafeDecrement(&freeCount);
 
-	if (index < capacity) { ++used; if (freeCount > 10000) { BreakPoint; } return freeIndices[index]; }
+	if (index < capacity) { index = freeIndices[index]; }
+	else
+	{
+		++freeCount;
+		index = SafeIncrement(&lastFree) - 1;
+	}
 
+#ifdef NH_DEBUG
+	SafeCheckAndSet(&taken[index / 64], index % 64);
+#endif
 	++used;
-	++freeCount;
-	if (freeCount > 10000) { BreakPoint; }
-	return SafeIncrement(&lastFree) - 1;
+	return index;
+}
+
+inline U32 Freelist::GetFree(U32 count, U32* indices)
+{
+	//Not thread safe, only call from the main thread while nothing else takes or releases indices
+	U32 obtained = 0;
+
+	while (obtained < count && freeCount) { indices[obtained++] = freeIndices[--freeCount]; }
+
+	U32 remaining = count - obtained;
+	U32 tail = capacity - lastFree < remaining ? capacity - lastFree : remaining;
+
+	for (U32 i = 0; i < tail; ++i) { indices[obtained++] = lastFree + i; }
+
+	lastFree += tail;
+	used += obtained;
+
+#ifdef NH_DEBUG
+	for (U32 i = 0; i < obtained; ++i) { taken[indices[i] / 64] |= 1ull << (indices[i] % 64); }
+#endif
+
+	return obtained;
 }
 
 inline void Freelist::Release(U32 index)
 {
 #ifdef NH_DEBUG
-	for (U32 i = 0; i < freeCount; ++i) { if (freeIndices[i] == index) { BreakPoint; } }
+	//Catches indices that were never handed out and indices released twice
+	if (index >= lastFree || !SafeCheckAndReset(&taken[index / 64], index % 64)) { BreakPoint; }
 #endif
 	--used;
 	freeIndices[SafeIncrement(&freeCount) - 1] = index;
@@ -133,6 +179,9 @@ inline void Freelist::Resize(U32 count)
 	if (count <= capacity) { return; }
 
 	Memory::Reallocate(&freeIndices, count);
+#ifdef NH_DEBUG
+	Memory::Reallocate(&taken, (count + 63) / 64);
+#endif
 
 	capacity = count;
 }
\ No newline at end of file
@@ -22,11 +22,11 @@ template<Character C> constexpr inline const C* DecimalLookup =
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -42,11 +42,11 @@ template<Character C> constexpr inline const C* DecimalLookup =
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
@@ -73,11 +73,11 @@ template<> constexpr inline const char* DecimalLookup<char> =
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -93,11 +93,11 @@ template<> constexpr inline const char* DecimalLookup<char> =
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
@@ -124,11 +124,11 @@ u8"000001002003004005006007008009010011012013014015016017018019"
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -144,11 +144,11 @@ u8"000001002003004005006007008009010011012013014015016017018019"
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
@@ -175,11 +175,11 @@ u"000001002003004005006007008009010011012013014015016017018019"
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -195,11 +195,11 @@ u"000001002003004005006007008009010011012013014015016017018019"
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
@@ -226,11 +226,11 @@ U"000001002003004005006007008009010011012013014015016017018019"
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -246,11 +246,11 @@ U"000001002003004005006007008009010011012013014015016017018019"
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
@@ -277,11 +277,11 @@ L"000001002003004005006007008009010011012013014015016017018019"
 "240241242243244245246247248249250251252253254255256257258259"
 "260261262263264265266267268269270271272273274275276277278279"
 "280281282283284285286287288289290291292293294295296297298299"
-"300301302303304305306307038309310311312313314315316317318319"
-"320321322323324325326327238329330331332333334335336337338339"
-"340341342343344345346347438349350351352353354355356357358359"
-"360361362363364365366367638369370371372373374375376377378379"
-"380381382383384385386387838389390391392393394395396397398399"
+"300301302303304305306307308309310311312313314315316317318319"
+"320321322323324325326327328329330331332333334335336337338339"
+"340341342343344345346347348349350351352353354355356357358359"
+"360361362363364365366367368369370371372373374375376377378379"
+"380381382383384385386387388389390391392393394395396397398399"
 "400401402403404405406407408409410411412413414415416417418419"
 "420421422423424425426427428429430431432433434435436437438439"
 "440441442443444445446447448449450451452453454455456457458459"
@@ -297,11 +297,11 @@ L"000001002003004005006007008009010011012013014015016017018019"
 "640641642643644645646647648649650651652653654655656657658659"
 "660661662663664665666667668669670671672673674675676677678679"
 "680681682683684685686687688689690691692693694695696697698699"
-"707701702703704705706707708709710711712713714715716717718719"
-"727721722723724725726727728729730731732733734735736737738739"
-"747741742743744745746747748749750751752753754755756757758759"
-"767761762763764765766767768769770771772773774775776777778779"
-"787781782783784785786787788789790791792793794795796797798799"
+"700701702703704705706707708709710711712713714715716717718719"
+"720721722723724725726727728729730731732733734735736737738739"
+"740741742743744745746747748749750751752753754755756757758759"
+"760761762763764765766767768769770771772773774775776777778779"
+"780781782783784785786787788789790791792793794795796797798799"
 "800801802803804805806807808809810811812813814815816817818819"
 "820821822823824825826827828829830831832833834835836837838839"
 "840841842843844845846847848849850851852853854855856857858859"
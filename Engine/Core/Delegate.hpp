@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "TypeTraits.hpp"
+
+#include "Platform/Memory.hpp"
+
+template<class Signature>
+struct Delegate;
+
+/// <summary>
+/// A non-allocating callable wrapper, holds a function pointer, a bound member function, or a trivially copyable callable up to StorageSize bytes inline
+/// </summary>
+template<class Return, class... Args>
+struct Delegate<Return(Args...)>
+{
+	static constexpr U64 StorageSize = 24;
+
+	using FunctionPtr = Return(*)(Args...);
+
+	Delegate() {}
+	Delegate(NullPointer) {}
+
+	Delegate(FunctionPtr function)
+	{
+		if (!function) { return; }
+
+		memcpy(storage, &function, sizeof(FunctionPtr));
+		invoke = [](void* data, Args... args) -> Return { return (*(FunctionPtr*)data)(Forward<Args>(args)...); };
+	}
+
+	template<class Callable> requires (IsClass<RemoveQualsReference<Callable>> && !IsSame<RemoveQualsReference<Callable>, Delegate>)
+	Delegate(Callable&& callable)
+	{
+		using Type = RemoveQualsReference<Callable>;
+
+		static_assert(sizeof(Type) <= StorageSize, "Callable is too large to be stored inline in a Delegate, capture less or capture a pointer");
+		static_assert(alignof(Type) <= 8, "Callable is over-aligned for Delegate storage");
+		static_assert(std::is_trivially_copyable_v<Type> && std::is_trivially_destructible_v<Type>, "Delegate can only store trivially copyable callables");
+
+		Construct<Type>((Type*)storage, Forward<Callable>(callable));
+		invoke = [](void* data, Args... args) -> Return { return (*(Type*)data)(Forward<Args>(args)...); };
+	}
+
+	/// <summary>
+	/// Creates a delegate that calls a member function on object, object must outlive the delegate
+	/// </summary>
+	template<auto Method, class Type>
+	static Delegate Bind(Type* object)
+	{
+		Delegate delegate;
+		memcpy(delegate.storage, &object, sizeof(Type*));
+		delegate.invoke = [](void* data, Args... args) -> Return { return ((*(Type**)data)->*Method)(Forward<Args>(args)...); };
+
+		return delegate;
+	}
+
+	Return operator()(Args... args) const
+	{
+		return invoke(storage, Forward<Args>(args)...);
+	}
+
+	/// <summary>
+	/// Two delegates are equal if they call the same function with the same bound state
+	/// </summary>
+	bool operator==(const Delegate& other) const
+	{
+		return invoke == other.invoke && memcmp(storage, other.storage, StorageSize) == 0;
+	}
+
+	bool operator!=(const Delegate& other) const
+	{
+		return !(*this == other);
+	}
+
+	bool Valid() const { return invoke; }
+	operator bool() const { return invoke; }
+
+private:
+	using InvokeFn = Return(*)(void* data, Args... args);
+
+	alignas(8) mutable U8 storage[StorageSize]{};
+	InvokeFn invoke = nullptr;
+};
\ No newline at end of file
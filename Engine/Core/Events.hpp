@@ -2,60 +2,113 @@
 
 #include "Defines.hpp"
 
-#include "Containers/Hashmap.hpp"
+#include "Delegate.hpp"
 #include "Containers/Vector.hpp"
 
-#include <functional>
+using EventHandle = U32;
 
 template<typename... Args>
 struct Event
 {
 public:
+	using Function = Delegate<bool(Args...)>;
+
 	Event() {}
-	~Event() { invocationList.Destroy(); }
+	~Event() { Destroy(); }
 
-	Event& operator+=(std::function<bool(Args...)>&& func)
+	Event& operator+=(const Function& func)
 	{
-		invocationList.Push(Move(func));
+		Subscribe(func);
 		return *this;
 	}
 
-	Event& operator-=(std::function<bool(Args...)>&& func)
+	/// <summary>
+	/// Removes the first subscription that calls the same function with the same bound state, prefer Unsubscribe with a handle
+	/// </summary>
+	Event& operator-=(const Function& func)
 	{
+		if (first.handle && first.function == func) { RemoveFirst(); return *this; }
+
 		U32 i = 0;
-		for (const std::function<bool(Args...)>& f : invocationList)
+		for (const Subscription& subscription : rest)
 		{
-			if (func == f) { invocationList.Remove(i); return *this; }
+			if (subscription.function == func) { rest.Remove(i); return *this; }
 			++i;
 		}
 	
 		return *this;
 	}
 
+	/// <returns>A handle that can be passed to Unsubscribe, never 0</returns>
+	EventHandle Subscribe(const Function& func)
+	{
+		if (!func) { return 0; }
+
+		EventHandle handle = ++nextHandle;
+		if (handle == 0) { handle = ++nextHandle; }
+
+		if (!first.handle && rest.Empty()) { first = { func, handle }; }
+		else { rest.Push({ func, handle }); }
+
+		return handle;
+	}
+
+	void Unsubscribe(EventHandle handle)
+	{
+		if (!handle) { return; }
+		if (first.handle == handle) { RemoveFirst(); return; }
+
+		U32 i = 0;
+		for (const Subscription& subscription : rest)
+		{
+			if (subscription.handle == handle) { rest.Remove(i); return; }
+			++i;
+		}
+	}
+
 	void operator()(Args... args) const
 	{
-		for (const std::function<bool(Args...)>& func : invocationList)
+		if (first.handle && first.function(args...)) { return; }
+
+		for (const Subscription& subscription : rest)
 		{
-			if (func(args...)) { return; }
+			if (subscription.function(args...)) { return; }
 		}
 	}
 
 	operator bool() const
 	{
-		return invocationList.Size();
+		return first.handle;
 	}
 
 	void Destroy()
 	{
-		invocationList.Destroy();
+		first = {};
+		rest.Destroy();
 	}
 	
 	U32 InvocationSize() const
 	{
-		return invocationList.Size();
+		return (first.handle ? 1 : 0) + (U32)rest.Size();
 	}
 
 private:
+	struct Subscription
+	{
+		Function function;
+		EventHandle handle = 0;
+	};
+
+	void RemoveFirst()
+	{
+		if (rest.Empty()) { first = {}; return; }
+
+		first = rest[0];
+		rest.Remove(0);
+	}
 
-	Vector<std::function<bool(Args...)>> invocationList;
+	//The first subscription is stored inline so single-listener events never allocate
+	Subscription first;
+	Vector<Subscription> rest;
+	EventHandle nextHandle = 0;
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Platform/Input.hpp"
 #include "Resources/Settings.hpp"
 #include "Resources/Resources.hpp"
+#include "Resources/Particles.hpp"
 #include "Containers/String.hpp"
 #include "Core/Time.hpp"
 #include "Core/File.hpp"
@@ -16,6 +17,7 @@
 #include "Math/Math.hpp"
 #include "Math/Random.hpp"
 #include "Math/Physics.hpp"
+#include "Math/Pathfinding.hpp"
 #include "Multithreading/Jobs.hpp"
 #include "Rendering/Renderer.hpp"
 #include "Rendering/UI.hpp"
@@ -31,6 +33,7 @@ bool Engine::Initialize(const GameInfo& _info)
 
 	if (!Logger::Initialize()) { return false; }
 	if (!Memory::Initialize()) { return false; }
+	if (!Jobs::Initialize()) { return false; }
 	if (!Settings::Initialize()) { return false; }
 	if (!Platform::Initialize(game.name)) { return false; }
 	if (!Input::Initialize()) { return false; }
@@ -39,6 +42,8 @@ bool Engine::Initialize(const GameInfo& _info)
 	if (!Resources::Initialize()) { return false; }
 	if (!UI::Initialize()) { return false; }
 	if (!Physics::Initialize()) { return false; }
+	if (!Pathfinding::Initialize()) { return false; }
+	if (!Particles::Initialize()) { return false; }
 	game.componentsInit();
 	if (!World::Initialize()) { return false; }
 	if (!game.initialize()) { return false; }
@@ -53,11 +58,18 @@ bool Engine::Initialize(const GameInfo& _info)
 	return true;
 }
 
+void Engine::Quit()
+{
+	Platform::running = false;
+}
+
 void Engine::Shutdown()
 {
 	Time::Shutdown();
 	game.shutdown();
 	World::Shutdown();
+	Particles::Shutdown();
+	Pathfinding::Shutdown();
 	Physics::Shutdown();
 	UI::Shutdown();
 	Resources::Shutdown();
@@ -66,6 +78,7 @@ void Engine::Shutdown()
 	Input::Shutdown();
 	Platform::Shutdown();
 	Settings::Shutdown();
+	Jobs::Shutdown();
 	Memory::Shutdown();
 	Logger::Shutdown();
 }
@@ -85,6 +98,8 @@ void Engine::MainLoop()
 		if (Input::OnButtonDown(ButtonCode::Escape)) { Platform::running = false; }
 
 		game.update();
+		Physics::Update();
+		Pathfinding::Update();
 
 		if (!Platform::resized && !Platform::minimised)
 		{
@@ -25,6 +25,11 @@ class NH_API Engine
 public:
 	static bool Initialize(const GameInfo& game);
 
+	/// <summary>
+	/// Leaves the main loop once the current frame is done, the engine then shuts down as if the window was closed
+	/// </summary>
+	static void Quit();
+
 private:
 	static void Shutdown();
 	static void MainLoop();
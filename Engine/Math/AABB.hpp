@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Math.hpp"
+
+struct NH_API AABB
+{
+	static constexpr F32 SweepSkin = 0.001f;	//How far a swept shape can start inside a face and still only be touching it
+
+	Vector2 upperBound;
+	Vector2 lowerBound;
+
+	AABB operator+(const Vector2& v) const { return { upperBound + v, lowerBound + v }; }
+	AABB operator-(const Vector2& v) const { return { upperBound - v, lowerBound - v }; }
+
+	bool Overlaps(const AABB& other) const
+	{
+		return lowerBound.x < other.upperBound.x && upperBound.x > other.lowerBound.x &&
+			lowerBound.y < other.upperBound.y && upperBound.y > other.lowerBound.y;
+	}
+
+	bool Contains(const AABB& other) const
+	{
+		return lowerBound.x <= other.lowerBound.x && lowerBound.y <= other.lowerBound.y &&
+			upperBound.x >= other.upperBound.x && upperBound.y >= other.upperBound.y;
+	}
+
+	AABB Merged(const AABB& other) const
+	{
+		return { { Math::Max(upperBound.x, other.upperBound.x), Math::Max(upperBound.y, other.upperBound.y) },
+			{ Math::Min(lowerBound.x, other.lowerBound.x), Math::Min(lowerBound.y, other.lowerBound.y) } };
+	}
+
+	AABB Expanded(F32 margin) const
+	{
+		return { { upperBound.x + margin, upperBound.y + margin }, { lowerBound.x - margin, lowerBound.y - margin } };
+	}
+
+	/// <summary>
+	/// Slab test of the segment start + delta * t for t from 0 to maxFraction, segments starting inside hit at 0 with a zero normal,
+	/// segments only touching a face they run parallel to miss
+	/// </summary>
+	bool RayCast(const Vector2& start, const Vector2& delta, F32 maxFraction, F32& fraction, Vector2& normal) const
+	{
+		F32 tMin = -F32_MAX;
+		F32 tMax = F32_MAX;
+		normal = Vector2::Zero;
+
+		if (delta.x == 0.0f) { if (start.x <= lowerBound.x || start.x >= upperBound.x) { return false; } }
+		else
+		{
+			F32 t1 = (lowerBound.x - start.x) / delta.x;
+			F32 t2 = (upperBound.x - start.x) / delta.x;
+			F32 side = -1.0f;
+			if (t1 > t2) { Swap(t1, t2); side = 1.0f; }
+
+			if (t1 > tMin) { tMin = t1; normal = { side, 0.0f }; }
+			tMax = Math::Min(tMax, t2);
+		}
+
+		if (delta.y == 0.0f) { if (start.y <= lowerBound.y || start.y >= upperBound.y) { return false; } }
+		else
+		{
+			F32 t1 = (lowerBound.y - start.y) / delta.y;
+			F32 t2 = (upperBound.y - start.y) / delta.y;
+			F32 side = -1.0f;
+			if (t1 > t2) { Swap(t1, t2); side = 1.0f; }
+
+			if (t1 > tMin) { tMin = t1; normal = { 0.0f, side }; }
+			tMax = Math::Min(tMax, t2);
+		}
+
+		if (tMin > tMax || tMax <= 0.0f || tMin > maxFraction) { return false; }
+
+		if (tMin < 0.0f)
+		{
+			tMin = 0.0f;
+			normal = Vector2::Zero;
+		}
+
+		fraction = tMin;
+		return true;
+	}
+
+	/// <summary>
+	/// Sweeps shape by displacement against this box, the box is grown by shape's extents so it becomes a slab test from shape's center,
+	/// shapes starting less than SweepSkin inside a face only touch it: they hit it at 0 with its normal while moving into it and miss it otherwise,
+	/// shapes starting deeper inside hit at 0 with a zero normal
+	/// </summary>
+	bool Sweep(const AABB& shape, const Vector2& displacement, F32 maxFraction, F32& fraction, Vector2& normal) const
+	{
+		Vector2 extents = shape.Extents();
+		Vector2 start = shape.Center();
+		Vector2 lower = lowerBound - extents;
+		Vector2 upper = upperBound + extents;
+
+		F32 tMin = -F32_MAX;
+		F32 tMax = F32_MAX;
+		F32 touchDepth = F32_MAX;
+		Vector2 touchNormal = Vector2::Zero;
+		normal = Vector2::Zero;
+
+		auto slab = [&](F32 s, F32 d, F32 low, F32 high, const Vector2& axis)
+		{
+			if (d == 0.0f) { if (s <= low || s >= high) { return false; } }
+			else
+			{
+				F32 t1 = (low - s) / d;
+				F32 t2 = (high - s) / d;
+				Vector2 side = -axis;
+				if (t1 > t2) { Swap(t1, t2); side = axis; }
+
+				if (t1 > tMin) { tMin = t1; normal = side; }
+				tMax = Math::Min(tMax, t2);
+			}
+
+			//Rounding leaves resting shapes a hair inside what they rest on, which mustn't stop them sliding along it
+			F32 depthLow = s - low;
+			F32 depthHigh = high - s;
+			if (depthLow > 0.0f && depthHigh > 0.0f && Math::Min(depthLow, depthHigh) <= SweepSkin)
+			{
+				bool nearLow = depthLow < depthHigh;
+				if (nearLow ? d <= 0.0f : d >= 0.0f) { return false; }
+
+				F32 depth = nearLow ? depthLow : depthHigh;
+				if (depth < touchDepth)
+				{
+					touchDepth = depth;
+					touchNormal = nearLow ? -axis : axis;
+				}
+			}
+
+			return true;
+		};
+
+		if (!slab(start.x, displacement.x, lower.x, upper.x, { 1.0f, 0.0f }) || !slab(start.y, displacement.y, lower.y, upper.y, { 0.0f, 1.0f })) { return false; }
+
+		if (tMin > tMax || tMax <= 0.0f || tMin > maxFraction) { return false; }
+
+		if (tMin < 0.0f)
+		{
+			tMin = 0.0f;
+			normal = touchNormal;
+		}
+
+		fraction = tMin;
+		return true;
+	}
+
+	Vector2 Center() const { return (upperBound + lowerBound) * 0.5f; }
+	Vector2 Extents() const { return (upperBound - lowerBound) * 0.5f; }
+	F32 Perimeter() const { return 2.0f * ((upperBound.x - lowerBound.x) + (upperBound.y - lowerBound.y)); }
+};
\ No newline at end of file
@@ -0,0 +1,379 @@
+#include "DynamicTree.hpp"
+
+DynamicTree::~DynamicTree()
+{
+	Destroy();
+}
+
+void DynamicTree::Destroy()
+{
+	nodes.Destroy();
+
+	root = U32_MAX;
+	freeNode = U32_MAX;
+	proxyCount = 0;
+}
+
+U32 DynamicTree::Insert(const AABB& bounds, U32 userData, U32 category, U32 mask)
+{
+	U32 proxy = AllocateNode();
+
+	Node& node = nodes[proxy];
+	node.bounds = bounds.Expanded(Margin);
+	node.userData = userData;
+	node.category = category;
+	node.mask = mask;
+	node.height = 0;
+
+	InsertLeaf(proxy);
+	++proxyCount;
+
+	return proxy;
+}
+
+void DynamicTree::Remove(U32 proxy)
+{
+	if (!Valid(proxy)) { return; }
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--proxyCount;
+}
+
+void DynamicTree::SetFilter(U32 proxy, U32 category, U32 mask)
+{
+	if (!Valid(proxy)) { return; }
+
+	nodes[proxy].category = category;
+	nodes[proxy].mask = mask;
+
+	for (U32 index = nodes[proxy].parent; index != U32_MAX; index = nodes[index].parent)
+	{
+		Node& node = nodes[index];
+		node.category = nodes[node.child1].category | nodes[node.child2].category;
+		node.mask = nodes[node.child1].mask | nodes[node.child2].mask;
+	}
+}
+
+bool DynamicTree::Move(U32 proxy, const AABB& bounds, const Vector2& displacement)
+{
+	if (!Valid(proxy)) { return false; }
+
+	AABB fat = bounds.Expanded(Margin);
+
+	Vector2 offset = displacement * DisplacementMultiplier;
+	if (offset.x < 0.0f) { fat.lowerBound.x += offset.x; }
+	else { fat.upperBound.x += offset.x; }
+	if (offset.y < 0.0f) { fat.lowerBound.y += offset.y; }
+	else { fat.upperBound.y += offset.y; }
+
+	//Bounds that shrank a lot are re-inserted too, otherwise a fast proxy that stops keeps its stretched bounds forever
+	const AABB& current = nodes[proxy].bounds;
+	if (current.Contains(bounds) && fat.Expanded(DisplacementMultiplier * Margin).Contains(current)) { return false; }
+
+	RemoveLeaf(proxy);
+	nodes[proxy].bounds = fat;
+	InsertLeaf(proxy);
+
+	return true;
+}
+
+bool DynamicTree::Valid(U32 proxy) const
+{
+	return proxy < nodes.Size() && nodes[proxy].height == 0;
+}
+
+const AABB& DynamicTree::FatBounds(U32 proxy) const
+{
+	return nodes[proxy].bounds;
+}
+
+U32 DynamicTree::UserData(U32 proxy) const
+{
+	return nodes[proxy].userData;
+}
+
+U32 DynamicTree::Category(U32 proxy) const
+{
+	return nodes[proxy].category;
+}
+
+U32 DynamicTree::Mask(U32 proxy) const
+{
+	return nodes[proxy].mask;
+}
+
+U32 DynamicTree::Count() const
+{
+	return proxyCount;
+}
+
+I32 DynamicTree::Height() const
+{
+	return root == U32_MAX ? 0 : nodes[root].height;
+}
+
+U32 DynamicTree::AllocateNode()
+{
+	U32 index;
+	if (freeNode != U32_MAX)
+	{
+		index = freeNode;
+		freeNode = nodes[index].parent;
+	}
+	else
+	{
+		index = (U32)nodes.Size();
+		nodes.Push({});
+	}
+
+	Node& node = nodes[index];
+	node.parent = U32_MAX;
+	node.child1 = U32_MAX;
+	node.child2 = U32_MAX;
+	node.userData = 0;
+	node.category = 0;
+	node.mask = 0;
+	node.height = 0;
+
+	return index;
+}
+
+void DynamicTree::FreeNode(U32 index)
+{
+	Node& node = nodes[index];
+	node.parent = freeNode;
+	node.height = -1;
+	freeNode = index;
+}
+
+void DynamicTree::InsertLeaf(U32 leaf)
+{
+	if (root == U32_MAX)
+	{
+		root = leaf;
+		nodes[leaf].parent = U32_MAX;
+		return;
+	}
+
+	//Walk down picking the child that grows the least, stopping when becoming a sibling here is cheaper
+	AABB leafBounds = nodes[leaf].bounds;
+	U32 index = root;
+	while (!nodes[index].Leaf())
+	{
+		const Node& node = nodes[index];
+		const Node& child1 = nodes[node.child1];
+		const Node& child2 = nodes[node.child2];
+
+		F32 perimeter = node.bounds.Perimeter();
+		F32 combinedPerimeter = node.bounds.Merged(leafBounds).Perimeter();
+
+		F32 cost = 2.0f * combinedPerimeter;
+		F32 inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+		F32 cost1 = child1.bounds.Merged(leafBounds).Perimeter() + inheritanceCost;
+		if (!child1.Leaf()) { cost1 -= child1.bounds.Perimeter(); }
+
+		F32 cost2 = child2.bounds.Merged(leafBounds).Perimeter() + inheritanceCost;
+		if (!child2.Leaf()) { cost2 -= child2.bounds.Perimeter(); }
+
+		if (cost < cost1 && cost < cost2) { break; }
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	U32 sibling = index;
+	U32 oldParent = nodes[sibling].parent;
+	U32 newParent = AllocateNode();
+
+	Node& parent = nodes[newParent];
+	parent.parent = oldParent;
+	parent.bounds = leafBounds.Merged(nodes[sibling].bounds);
+	parent.category = nodes[leaf].category | nodes[sibling].category;
+	parent.mask = nodes[leaf].mask | nodes[sibling].mask;
+	parent.height = nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+
+	if (oldParent != U32_MAX)
+	{
+		if (nodes[oldParent].child1 == sibling) { nodes[oldParent].child1 = newParent; }
+		else { nodes[oldParent].child2 = newParent; }
+	}
+	else { root = newParent; }
+
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	Refit(newParent);
+}
+
+void DynamicTree::RemoveLeaf(U32 leaf)
+{
+	if (leaf == root)
+	{
+		root = U32_MAX;
+		return;
+	}
+
+	U32 parent = nodes[leaf].parent;
+	U32 grandParent = nodes[parent].parent;
+	U32 sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != U32_MAX)
+	{
+		if (nodes[grandParent].child1 == parent) { nodes[grandParent].child1 = sibling; }
+		else { nodes[grandParent].child2 = sibling; }
+
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		Refit(grandParent);
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = U32_MAX;
+		FreeNode(parent);
+	}
+}
+
+void DynamicTree::Refit(U32 index)
+{
+	while (index != U32_MAX)
+	{
+		index = Balance(index);
+
+		Node& node = nodes[index];
+		const Node& child1 = nodes[node.child1];
+		const Node& child2 = nodes[node.child2];
+
+		node.height = 1 + Math::Max(child1.height, child2.height);
+		node.bounds = child1.bounds.Merged(child2.bounds);
+		node.category = child1.category | child2.category;
+		node.mask = child1.mask | child2.mask;
+
+		index = node.parent;
+	}
+}
+
+U32 DynamicTree::Balance(U32 iA)
+{
+	Node& a = nodes[iA];
+	if (a.Leaf() || a.height < 2) { return iA; }
+
+	U32 iB = a.child1;
+	U32 iC = a.child2;
+	Node& b = nodes[iB];
+	Node& c = nodes[iC];
+
+	I32 balance = c.height - b.height;
+
+	//Rotate C up
+	if (balance > 1)
+	{
+		U32 iF = c.child1;
+		U32 iG = c.child2;
+		Node& f = nodes[iF];
+		Node& g = nodes[iG];
+
+		c.child1 = iA;
+		c.parent = a.parent;
+		a.parent = iC;
+
+		if (c.parent != U32_MAX)
+		{
+			if (nodes[c.parent].child1 == iA) { nodes[c.parent].child1 = iC; }
+			else { nodes[c.parent].child2 = iC; }
+		}
+		else { root = iC; }
+
+		if (f.height > g.height)
+		{
+			c.child2 = iF;
+			a.child2 = iG;
+			g.parent = iA;
+			a.bounds = b.bounds.Merged(g.bounds);
+			c.bounds = a.bounds.Merged(f.bounds);
+
+			a.height = 1 + Math::Max(b.height, g.height);
+			c.height = 1 + Math::Max(a.height, f.height);
+			a.category = b.category | g.category;
+			c.category = a.category | f.category;
+			a.mask = b.mask | g.mask;
+			c.mask = a.mask | f.mask;
+		}
+		else
+		{
+			c.child2 = iG;
+			a.child2 = iF;
+			f.parent = iA;
+			a.bounds = b.bounds.Merged(f.bounds);
+			c.bounds = a.bounds.Merged(g.bounds);
+
+			a.height = 1 + Math::Max(b.height, f.height);
+			c.height = 1 + Math::Max(a.height, g.height);
+			a.category = b.category | f.category;
+			c.category = a.category | g.category;
+			a.mask = b.mask | f.mask;
+			c.mask = a.mask | g.mask;
+		}
+
+		return iC;
+	}
+
+	//Rotate B up
+	if (balance < -1)
+	{
+		U32 iD = b.child1;
+		U32 iE = b.child2;
+		Node& d = nodes[iD];
+		Node& e = nodes[iE];
+
+		b.child1 = iA;
+		b.parent = a.parent;
+		a.parent = iB;
+
+		if (b.parent != U32_MAX)
+		{
+			if (nodes[b.parent].child1 == iA) { nodes[b.parent].child1 = iB; }
+			else { nodes[b.parent].child2 = iB; }
+		}
+		else { root = iB; }
+
+		if (d.height > e.height)
+		{
+			b.child2 = iD;
+			a.child1 = iE;
+			e.parent = iA;
+			a.bounds = c.bounds.Merged(e.bounds);
+			b.bounds = a.bounds.Merged(d.bounds);
+
+			a.height = 1 + Math::Max(c.height, e.height);
+			b.height = 1 + Math::Max(a.height, d.height);
+			a.category = c.category | e.category;
+			b.category = a.category | d.category;
+			a.mask = c.mask | e.mask;
+			b.mask = a.mask | d.mask;
+		}
+		else
+		{
+			b.child2 = iE;
+			a.child1 = iD;
+			d.parent = iA;
+			a.bounds = c.bounds.Merged(d.bounds);
+			b.bounds = a.bounds.Merged(e.bounds);
+
+			a.height = 1 + Math::Max(c.height, d.height);
+			b.height = 1 + Math::Max(a.height, e.height);
+			a.category = c.category | d.category;
+			b.category = a.category | e.category;
+			a.mask = c.mask | d.mask;
+			b.mask = a.mask | e.mask;
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
\ No newline at end of file
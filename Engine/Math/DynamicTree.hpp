@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "AABB.hpp"
+
+#include "Containers/Vector.hpp"
+
+/// <summary>
+/// Bounding volume tree for moving proxies, leaves hold fattened bounds so small moves don't touch the tree,
+/// the tree is kept balanced with rotations as leaves are inserted and removed
+/// </summary>
+class NH_API DynamicTree
+{
+public:
+	static constexpr F32 Margin = 0.1f;					//Fattening applied to every leaf
+	static constexpr F32 DisplacementMultiplier = 4.0f;	//How far ahead of a moving proxy its bounds are stretched
+
+	~DynamicTree();
+	void Destroy();
+
+	/// <summary>
+	/// category holds the layers the proxy is on, mask the layers it collides with
+	/// </summary>
+	/// <returns>A proxy id that stays valid until it's removed</returns>
+	U32 Insert(const AABB& bounds, U32 userData = 0, U32 category = 1, U32 mask = U32_MAX);
+	void Remove(U32 proxy);
+	void SetFilter(U32 proxy, U32 category, U32 mask);
+
+	/// <summary>
+	/// Moves a proxy, displacement is used to predict where it's heading
+	/// </summary>
+	/// <returns>true if the proxy was re-inserted, false if its fat bounds still contained bounds</returns>
+	bool Move(U32 proxy, const AABB& bounds, const Vector2& displacement = Vector2::Zero);
+
+	bool Valid(U32 proxy) const;
+	const AABB& FatBounds(U32 proxy) const;
+	U32 UserData(U32 proxy) const;
+	U32 Category(U32 proxy) const;
+	U32 Mask(U32 proxy) const;
+	U32 Count() const;
+	I32 Height() const;
+
+	/// <summary>
+	/// Calls callback(proxy) once for every proxy on a layer in mask whose fat bounds overlap bounds, return false from callback to stop early
+	/// </summary>
+	template<class Callback>
+	void Query(const AABB& bounds, Callback&& callback, U32 mask = U32_MAX) const;
+
+	/// <summary>
+	/// Calls callback(proxy, maxFraction) for every proxy whose fat bounds the segment from start to end passes through,
+	/// callback returns the new max fraction: 0 stops the cast, the current max fraction continues unchanged
+	/// </summary>
+	template<class Callback>
+	void RayCast(const Vector2& start, const Vector2& end, Callback&& callback, U32 mask = U32_MAX) const;
+
+	/// <summary>
+	/// Calls callback(proxyA, proxyB) once for every pair of proxies whose fat bounds overlap and whose layers collide with each other,
+	/// proxyA is always less than proxyB
+	/// </summary>
+	template<class Callback>
+	void QueryPairs(Callback&& callback) const;
+
+private:
+	static constexpr U32 StackSize = 256;
+
+	//Traversal stack, lives on the call stack and only spills into the heap for trees too unbalanced to fit in StackSize
+	struct NodeStack
+	{
+		void Push(U32 node);
+		U32 Pop();
+		bool Empty() const;
+
+		U32 nodes[StackSize];
+		U32 count = 0;
+		Vector<U32> overflow;
+	};
+
+	struct Node
+	{
+		AABB bounds;
+		U32 userData;
+		U32 category;		//Layers of every leaf below this node
+		U32 mask;			//Layers of every leaf below this node collide with
+		U32 parent;			//Next free node while unused
+		U32 child1;
+		U32 child2;
+		I32 height;			//0 for leaves, -1 while unused
+
+		bool Leaf() const { return child1 == U32_MAX; }
+	};
+
+	U32 AllocateNode();
+	void FreeNode(U32 node);
+	void InsertLeaf(U32 leaf);
+	void RemoveLeaf(U32 leaf);
+	void Refit(U32 node);
+	U32 Balance(U32 node);
+
+	Vector<Node> nodes;
+	U32 root = U32_MAX;
+	U32 freeNode = U32_MAX;
+	U32 proxyCount = 0;
+};
+
+inline void DynamicTree::NodeStack::Push(U32 node)
+{
+	if (count < StackSize) { nodes[count++] = node; }
+	else { overflow.Push(node); }
+}
+
+inline U32 DynamicTree::NodeStack::Pop()
+{
+	U32 node;
+	if (overflow.Size()) { overflow.Pop(node); }
+	else { node = nodes[--count]; }
+
+	return node;
+}
+
+inline bool DynamicTree::NodeStack::Empty() const
+{
+	return count == 0 && overflow.Empty();
+}
+
+template<class Callback>
+inline void DynamicTree::Query(const AABB& bounds, Callback&& callback, U32 mask) const
+{
+	if (root == U32_MAX) { return; }
+
+	NodeStack stack;
+	stack.Push(root);
+
+	while (!stack.Empty())
+	{
+		U32 index = stack.Pop();
+		const Node& node = nodes[index];
+
+		if (!(node.category & mask) || !node.bounds.Overlaps(bounds)) { continue; }
+
+		if (node.Leaf())
+		{
+			if (!callback(index)) { return; }
+		}
+		else
+		{
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
+
+template<class Callback>
+inline void DynamicTree::RayCast(const Vector2& start, const Vector2& end, Callback&& callback, U32 mask) const
+{
+	if (root == U32_MAX) { return; }
+
+	Vector2 ray = end - start;
+	if (ray.x == 0.0f && ray.y == 0.0f) { return; }
+
+	//Nodes are rejected by the segment's normal axis, the segment's bounds handle the other two
+	Vector2 normal = { -ray.y, ray.x };
+	Vector2 absNormal = { Math::Abs(normal.x), Math::Abs(normal.y) };
+
+	F32 maxFraction = 1.0f;
+	Vector2 segmentEnd = end;
+	AABB segment{ { Math::Max(start.x, end.x), Math::Max(start.y, end.y) }, { Math::Min(start.x, end.x), Math::Min(start.y, end.y) } };
+
+	NodeStack stack;
+	stack.Push(root);
+
+	while (!stack.Empty())
+	{
+		U32 index = stack.Pop();
+		const Node& node = nodes[index];
+
+		if (!(node.category & mask) || !node.bounds.Overlaps(segment)) { continue; }
+
+		Vector2 center = node.bounds.Center();
+		Vector2 extents = node.bounds.Extents();
+		F32 separation = Math::Abs(normal.Dot(start - center)) - absNormal.Dot(extents);
+		if (separation > 0.0f) { continue; }
+
+		if (node.Leaf())
+		{
+			F32 fraction = callback(index, maxFraction);
+			if (fraction == 0.0f) { return; }
+
+			if (fraction > 0.0f && fraction < maxFraction)
+			{
+				maxFraction = fraction;
+				segmentEnd = start + ray * maxFraction;
+				segment = { { Math::Max(start.x, segmentEnd.x), Math::Max(start.y, segmentEnd.y) }, { Math::Min(start.x, segmentEnd.x), Math::Min(start.y, segmentEnd.y) } };
+			}
+		}
+		else
+		{
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
+
+template<class Callback>
+inline void DynamicTree::QueryPairs(Callback&& callback) const
+{
+	for (U32 i = 0; i < nodes.Size(); ++i)
+	{
+		const Node& leaf = nodes[i];
+		if (leaf.height != 0) { continue; }
+
+		//Subtrees are pruned by the leaf's mask, the other side of the filter is checked per pair
+		Query(leaf.bounds, [&](U32 other)
+		{
+			if (other > i && (nodes[other].mask & leaf.category)) { callback(i, other); }
+			return true;
+		}, leaf.mask);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,593 @@
+#include "FlowField.hpp"
+
+#include "Core/Time.hpp"
+#include "Multithreading/Jobs.hpp"
+#include "Resources/TileGrid.hpp"
+
+#include "tracy/Tracy.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define NH_FLOWFIELD_SSE
+#	include <immintrin.h>
+#endif
+
+static constexpr F32 Unreachable = Traits<F32>::Infinity;
+static constexpr F32 DiagonalCost = 1.41421356f;
+
+//Same order as the directions, the first four are the edges of a chunk and the last four its corners
+static constexpr I32 Neighbours[8][2] = {
+	{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+	{ 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+};
+
+static const Vector2 DirectionVectors[FlowField::NoDirection + 1] = {
+	{ 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+	{ 0.70710678f, 0.70710678f }, { -0.70710678f, 0.70710678f }, { 0.70710678f, -0.70710678f }, { -0.70710678f, -0.70710678f },
+	{ 0.0f, 0.0f }
+};
+
+//Lowers each tile of row from the row above or below it, a diagonal step needs the tiles beside it on both rows to be open
+static bool RelaxRow(F32* row, const F32* from, const F32* rowWalls, const F32* fromWalls)
+{
+	I32 x = 1;
+
+#ifdef NH_FLOWFIELD_SSE
+	__m128 straightCost = _mm_set1_ps(1.0f);
+	__m128 diagonalCost = _mm_set1_ps(DiagonalCost);
+	__m128 changed = _mm_setzero_ps();
+
+	for (; x + 4 <= FlowField::ChunkSize + 1; x += 4)
+	{
+		__m128 besideWalls = _mm_loadu_ps(fromWalls + x);
+		__m128 straight = _mm_add_ps(_mm_loadu_ps(from + x), straightCost);
+		__m128 left = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(from + x - 1), diagonalCost), _mm_add_ps(_mm_loadu_ps(rowWalls + x - 1), besideWalls));
+		__m128 right = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(from + x + 1), diagonalCost), _mm_add_ps(_mm_loadu_ps(rowWalls + x + 1), besideWalls));
+
+		//Solid tiles add infinity, so they're never lowered and nothing is lowered through them
+		__m128 best = _mm_add_ps(_mm_min_ps(straight, _mm_min_ps(left, right)), _mm_loadu_ps(rowWalls + x));
+		__m128 current = _mm_loadu_ps(row + x);
+
+		changed = _mm_or_ps(changed, _mm_cmplt_ps(best, current));
+		_mm_storeu_ps(row + x, _mm_min_ps(current, best));
+	}
+
+	bool lowered = _mm_movemask_ps(changed) != 0;
+#else
+	bool lowered = false;
+#endif
+
+	for (; x <= FlowField::ChunkSize; ++x)
+	{
+		F32 straight = from[x] + 1.0f;
+		F32 left = from[x - 1] + DiagonalCost + rowWalls[x - 1] + fromWalls[x];
+		F32 right = from[x + 1] + DiagonalCost + rowWalls[x + 1] + fromWalls[x];
+		F32 best = Math::Min(straight, Math::Min(left, right)) + rowWalls[x];
+
+		if (best < row[x])
+		{
+			row[x] = best;
+			lowered = true;
+		}
+	}
+
+	return lowered;
+}
+
+//Lowers each tile of row from the tiles beside it, every step depends on the last one so this stays scalar
+static bool ScanRow(F32* row, const F32* rowWalls)
+{
+	bool lowered = false;
+
+	F32 cost = row[0];
+	for (I32 x = 1; x <= FlowField::ChunkSize; ++x)
+	{
+		F32 current = row[x];
+		cost = Math::Min(current, cost + (1.0f + rowWalls[x]));
+		lowered |= cost < current;
+		row[x] = cost;
+	}
+
+	cost = row[FlowField::ChunkSize + 1];
+	for (I32 x = FlowField::ChunkSize; x >= 1; --x)
+	{
+		F32 current = row[x];
+		cost = Math::Min(current, cost + (1.0f + rowWalls[x]));
+		lowered |= cost < current;
+		row[x] = cost;
+	}
+
+	return lowered;
+}
+
+//Whether any of count tiles from edge, stride apart, is a shorter way into the tiles facing them,
+//a diagonal step needs both the tile across from it and the one beside it to be open
+static bool Improves(const F32* edge, const F32* edgeWalls, const F32* facing, const F32* facingWalls, I32 stride, I32 count)
+{
+	for (I32 i = 0; i < count; ++i)
+	{
+		if (facingWalls[i * stride] != 0.0f) { continue; }
+
+		F32 cost = edge[i * stride];
+		if (cost + 1.0f < facing[i * stride]) { return true; }
+
+		for (I32 offset = i - 1; offset <= i + 1; offset += 2)
+		{
+			if (offset >= 0 && offset < count && facingWalls[offset * stride] == 0.0f && edgeWalls[offset * stride] == 0.0f && cost + DiagonalCost < facing[offset * stride]) { return true; }
+		}
+	}
+
+	return false;
+}
+
+FlowField::FlowField() : tiles(nullptr), dimensions(Vector2Int::Zero), chunkCount(Vector2Int::Zero), goal{ -1, -1 }, reset(false), settled(true) {}
+
+FlowField::~FlowField()
+{
+	Destroy();
+}
+
+void FlowField::Destroy()
+{
+	costs.Destroy();
+	walls.Destroy();
+	directions.Destroy();
+	chunkFlags.Destroy();
+	dirtyRows.Destroy();
+	chunkEdges.Destroy();
+	queuedChunks.Destroy();
+	activeChunks.Destroy();
+	sweptChunks.Destroy();
+
+	tiles = nullptr;
+	dimensions = Vector2Int::Zero;
+	chunkCount = Vector2Int::Zero;
+	goal = { -1, -1 };
+	reset = false;
+	settled = true;
+}
+
+void FlowField::Create(const TileGrid* grid)
+{
+	Destroy();
+
+	tiles = grid;
+	dimensions = grid->Dimensions();
+	chunkCount = { (dimensions.x + ChunkSize - 1) >> ChunkShift, (dimensions.y + ChunkSize - 1) >> ChunkShift };
+
+	//Tiles past the edges of the grid stay solid and unreachable
+	U32 chunks = chunkCount.x * chunkCount.y;
+	costs = Vector<F32>((U64)chunks * PaddedArea, Unreachable);
+	walls = Vector<F32>((U64)chunks * PaddedArea, Unreachable);
+	directions = Vector<U8>((U64)dimensions.x * dimensions.y, NoDirection);
+	chunkFlags = Vector<U8>(chunks, (U8)0);
+	dirtyRows = Vector<U64>(chunks, 0ull);
+	chunkEdges = Vector<U8>(chunks, (U8)0);
+
+	ReadTiles(Vector2Int::Zero, dimensions - Vector2Int::One);
+}
+
+void FlowField::SetGoal(const Vector2Int& tile)
+{
+	if (!tiles || tile == goal) { return; }
+
+	bool inside = tile.x >= 0 && tile.y >= 0 && tile.x < dimensions.x && tile.y < dimensions.y;
+	bool oldInside = goal.x >= 0 && goal.y >= 0 && goal.x < dimensions.x && goal.y < dimensions.y;
+
+	//The distance between the goals is read before the old one is replaced, it's an upper bound even mid build
+	F32 shift = inside && oldInside && !reset ? costs[Cell(tile.x, tile.y)] : Unreachable;
+
+	goal = tile;
+	settled = false;
+
+	if (shift == Unreachable || walls[Cell(tile.x, tile.y)] != 0.0f)
+	{
+		reset = true;
+		return;
+	}
+
+	//A path to the old goal followed by the way over to the new one is never shorter than the new distance,
+	//so shifting every distance up keeps them upper bounds that the sweeps lower from the new goal outward
+	F32* data = costs.Data();
+	U64 count = costs.Size();
+	U64 i = 0;
+
+#ifdef NH_FLOWFIELD_SSE
+	__m128 offset = _mm_set1_ps(shift);
+	for (; i + 4 <= count; i += 4) { _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), offset)); }
+#endif
+
+	for (; i < count; ++i) { data[i] += shift; }
+
+	U32 chunk = (tile.x >> ChunkShift) + (tile.y >> ChunkShift) * chunkCount.x;
+	costs[Cell(tile.x, tile.y)] = 0.0f;
+	dirtyRows[chunk] |= 1ull << (tile.y & (ChunkSize - 1));
+	Queue(chunk);
+}
+
+void FlowField::UpdateTiles(const Vector2Int& min, const Vector2Int& max)
+{
+	if (!tiles) { return; }
+
+	Vector2Int start = { Math::Max(min.x, 0), Math::Max(min.y, 0) };
+	Vector2Int end = { Math::Min(max.x, dimensions.x - 1), Math::Min(max.y, dimensions.y - 1) };
+	if (start.x > end.x || start.y > end.y) { return; }
+
+	settled = false;
+
+	//Distances can only be lowered, a new wall can lengthen paths anywhere so the field starts over
+	if (ReadTiles(start, end))
+	{
+		reset = true;
+		return;
+	}
+
+	//Opened tiles are unreachable until the tiles around them flow in, including ones across a chunk edge
+	I32 minX = Math::Max(start.x - 1, 0) >> ChunkShift;
+	I32 minY = Math::Max(start.y - 1, 0) >> ChunkShift;
+	I32 maxX = Math::Min(end.x + 1, dimensions.x - 1) >> ChunkShift;
+	I32 maxY = Math::Min(end.y + 1, dimensions.y - 1) >> ChunkShift;
+
+	for (I32 y = minY; y <= maxY; ++y)
+	{
+		for (I32 x = minX; x <= maxX; ++x) { Queue(x + y * chunkCount.x); }
+	}
+}
+
+bool FlowField::Build(F64 budget)
+{
+	if (settled) { return true; }
+
+	ZoneScopedN("Flow Field");
+
+	F64 start = Time::AbsoluteTime();
+
+	if (reset)
+	{
+		Reset();
+		reset = false;
+	}
+
+	U32 threads = Jobs::ThreadCount();
+
+	while (!queuedChunks.Empty())
+	{
+		Swap(activeChunks, queuedChunks);
+		queuedChunks.Clear();
+
+		for (U32 chunk : activeChunks)
+		{
+			chunkFlags[chunk] &= ~QueuedFlag;
+
+			if (!(chunkFlags[chunk] & SweptFlag))
+			{
+				chunkFlags[chunk] |= SweptFlag;
+				sweptChunks.Push(chunk);
+			}
+		}
+
+		U32 count = (U32)activeChunks.Size();
+		U32 batchSize = Math::Max((count + threads - 1) / threads, 1u);
+
+		//Every chunk copies its neighbours' edges before any of them is swept, so no chunk is read while it's written
+		Jobs::ParallelFor(count, batchSize, [this](U32 first, U32 last)
+		{
+			for (U32 i = first; i < last; ++i) { PullBorders(activeChunks[i]); }
+		});
+
+		Jobs::ParallelFor(count, batchSize, [this](U32 first, U32 last)
+		{
+			for (U32 i = first; i < last; ++i) { Sweep(activeChunks[i]); }
+		});
+
+		//Edges are compared once the whole round is swept, neighbours in the same round may have just been lowered
+		Jobs::ParallelFor(count, batchSize, [this](U32 first, U32 last)
+		{
+			for (U32 i = first; i < last; ++i) { chunkEdges[activeChunks[i]] = Spread(activeChunks[i]); }
+		});
+
+		for (U32 chunk : activeChunks)
+		{
+			I32 chunkX = chunk % chunkCount.x;
+			I32 chunkY = chunk / chunkCount.x;
+
+			for (U32 edges = chunkEdges[chunk]; edges; edges &= edges - 1)
+			{
+				const I32* neighbour = Neighbours[std::countr_zero(edges)];
+				I32 x = chunkX + neighbour[0];
+				I32 y = chunkY + neighbour[1];
+
+				if (x >= 0 && y >= 0 && x < chunkCount.x && y < chunkCount.y) { Queue(x + y * chunkCount.x); }
+			}
+		}
+
+		TracyPlot("Flow Field Chunks", (I64)count);
+
+		if (!queuedChunks.Empty() && Time::AbsoluteTime() - start >= budget) { return false; }
+	}
+
+	U32 count = (U32)sweptChunks.Size();
+	U32 batchSize = Math::Max((count + threads - 1) / threads, 1u);
+
+	Jobs::ParallelFor(count, batchSize, [this](U32 first, U32 last)
+	{
+		for (U32 i = first; i < last; ++i) { BuildDirections(sweptChunks[i]); }
+	});
+
+	for (U32 chunk : sweptChunks) { chunkFlags[chunk] &= ~SweptFlag; }
+	sweptChunks.Clear();
+
+	settled = true;
+	return true;
+}
+
+bool FlowField::Settled() const
+{
+	return settled;
+}
+
+const Vector2Int& FlowField::Goal() const
+{
+	return goal;
+}
+
+Vector2 FlowField::Direction(const Vector2Int& tile) const
+{
+	return DirectionVectors[DirectionIndex(tile)];
+}
+
+U8 FlowField::DirectionIndex(const Vector2Int& tile) const
+{
+	if (tile.x < 0 || tile.y < 0 || tile.x >= dimensions.x || tile.y >= dimensions.y) { return NoDirection; }
+
+	return directions[tile.x + (U64)tile.y * dimensions.x];
+}
+
+F32 FlowField::Distance(const Vector2Int& tile) const
+{
+	if (tile.x < 0 || tile.y < 0 || tile.x >= dimensions.x || tile.y >= dimensions.y) { return Unreachable; }
+
+	return costs[Cell(tile.x, tile.y)];
+}
+
+void FlowField::Reset()
+{
+	F32* data = costs.Data();
+	for (U64 i = 0; i < costs.Size(); ++i) { data[i] = Unreachable; }
+
+	for (U32 chunk : queuedChunks) { chunkFlags[chunk] &= ~QueuedFlag; }
+	queuedChunks.Clear();
+
+	//Every direction may point toward an old goal, so they're all rebuilt once this settles
+	for (U32 chunk = 0; chunk < chunkFlags.Size(); ++chunk)
+	{
+		if (!(chunkFlags[chunk] & SweptFlag))
+		{
+			chunkFlags[chunk] |= SweptFlag;
+			sweptChunks.Push(chunk);
+		}
+	}
+
+	if (goal.x < 0 || goal.y < 0 || goal.x >= dimensions.x || goal.y >= dimensions.y || walls[Cell(goal.x, goal.y)] != 0.0f) { return; }
+
+	U32 chunk = (goal.x >> ChunkShift) + (goal.y >> ChunkShift) * chunkCount.x;
+	costs[Cell(goal.x, goal.y)] = 0.0f;
+	dirtyRows[chunk] |= 1ull << (goal.y & (ChunkSize - 1));
+	Queue(chunk);
+}
+
+bool FlowField::ReadTiles(const Vector2Int& min, const Vector2Int& max)
+{
+	bool closed = false;
+
+	for (I32 y = min.y; y <= max.y; ++y)
+	{
+		for (I32 x = min.x; x <= max.x; ++x)
+		{
+			F32 wall = tiles->Get(x, y) != TileType::Air ? Unreachable : 0.0f;
+
+			U64 cell = Cell(x, y);
+			if (walls[cell] == wall) { continue; }
+
+			closed |= wall != 0.0f;
+			walls[cell] = wall;
+
+			//Tiles on the edge of a chunk are also copied into the border of each chunk they touch
+			I32 localX = x & (ChunkSize - 1);
+			I32 localY = y & (ChunkSize - 1);
+
+			if (localX == 0 || localY == 0 || localX == ChunkSize - 1 || localY == ChunkSize - 1)
+			{
+				for (const I32* neighbour : Neighbours)
+				{
+					if ((neighbour[0] == 1 && localX != ChunkSize - 1) || (neighbour[0] == -1 && localX != 0) ||
+						(neighbour[1] == 1 && localY != ChunkSize - 1) || (neighbour[1] == -1 && localY != 0)) { continue; }
+
+					I32 chunkX = (x >> ChunkShift) + neighbour[0];
+					I32 chunkY = (y >> ChunkShift) + neighbour[1];
+					if (chunkX < 0 || chunkY < 0 || chunkX >= chunkCount.x || chunkY >= chunkCount.y) { continue; }
+
+					I32 borderX = neighbour[0] ? (neighbour[0] > 0 ? 0 : ChunkSize + 1) : localX + 1;
+					I32 borderY = neighbour[1] ? (neighbour[1] > 0 ? 0 : ChunkSize + 1) : localY + 1;
+					walls[(U64)(chunkX + chunkY * chunkCount.x) * PaddedArea + borderY * PaddedSize + borderX] = wall;
+				}
+			}
+
+			//Solid tiles are never lowered, so one that closes has to be cleared here
+			if (wall != 0.0f) { costs[cell] = Unreachable; }
+			else { dirtyRows[(x >> ChunkShift) + (y >> ChunkShift) * chunkCount.x] |= 1ull << localY; }
+		}
+	}
+
+	return closed;
+}
+
+void FlowField::Queue(U32 chunk)
+{
+	if (chunkFlags[chunk] & QueuedFlag) { return; }
+
+	chunkFlags[chunk] |= QueuedFlag;
+	queuedChunks.Push(chunk);
+}
+
+void FlowField::PullBorders(U32 chunk)
+{
+	I32 chunkX = chunk % chunkCount.x;
+	I32 chunkY = chunk / chunkCount.x;
+	F32* cells = costs.Data() + (U64)chunk * PaddedArea;
+
+	auto source = [&](I32 offsetX, I32 offsetY) -> const F32*
+	{
+		I32 x = chunkX + offsetX;
+		I32 y = chunkY + offsetY;
+		if (x < 0 || y < 0 || x >= chunkCount.x || y >= chunkCount.y) { return nullptr; }
+
+		return costs.Data() + (U64)(x + y * chunkCount.x) * PaddedArea;
+	};
+
+	//Each side of the border is the opposite edge of the neighbour it touches, chunks off the grid leave it unreachable
+	if (const F32* above = source(0, -1)) { CopyData(cells + 1, above + ChunkSize * PaddedSize + 1, ChunkSize); }
+	if (const F32* below = source(0, 1)) { CopyData(cells + (ChunkSize + 1) * PaddedSize + 1, below + PaddedSize + 1, ChunkSize); }
+
+	//A side that changed only reaches the row it's on by scanning along it
+	U64 dirty = 0;
+
+	if (const F32* left = source(-1, 0))
+	{
+		for (I32 y = 1; y <= ChunkSize; ++y)
+		{
+			F32 cost = left[y * PaddedSize + ChunkSize];
+			if (cost != cells[y * PaddedSize]) { cells[y * PaddedSize] = cost; dirty |= 1ull << (y - 1); }
+		}
+	}
+
+	if (const F32* right = source(1, 0))
+	{
+		for (I32 y = 1; y <= ChunkSize; ++y)
+		{
+			F32 cost = right[y * PaddedSize + 1];
+			if (cost != cells[y * PaddedSize + ChunkSize + 1]) { cells[y * PaddedSize + ChunkSize + 1] = cost; dirty |= 1ull << (y - 1); }
+		}
+	}
+
+	dirtyRows[chunk] |= dirty;
+
+	if (const F32* corner = source(-1, -1)) { cells[0] = corner[ChunkSize * PaddedSize + ChunkSize]; }
+	if (const F32* corner = source(1, -1)) { cells[ChunkSize + 1] = corner[ChunkSize * PaddedSize + 1]; }
+	if (const F32* corner = source(-1, 1)) { cells[(ChunkSize + 1) * PaddedSize] = corner[PaddedSize + ChunkSize]; }
+	if (const F32* corner = source(1, 1)) { cells[(ChunkSize + 1) * PaddedSize + ChunkSize + 1] = corner[PaddedSize + 1]; }
+}
+
+void FlowField::Sweep(U32 chunk)
+{
+	F32* cells = costs.Data() + (U64)chunk * PaddedArea;
+	const F32* chunkWalls = walls.Data() + (U64)chunk * PaddedArea;
+	U64 dirty = dirtyRows[chunk];
+
+	//Passes alternate down and up, each row is lowered from the row before it and then along itself if anything changed,
+	//once a pass lowers nothing every row agrees with the rows on both sides of it
+	bool lowered = true;
+	for (U32 pass = 0; lowered || pass < 2; ++pass)
+	{
+		bool down = !(pass & 1);
+		I32 from = down ? -(I32)PaddedSize : (I32)PaddedSize;
+		lowered = false;
+
+		for (I32 i = 0; i < ChunkSize; ++i)
+		{
+			I32 y = down ? i + 1 : ChunkSize - i;
+			F32* row = cells + y * PaddedSize;
+			const F32* rowWalls = chunkWalls + y * PaddedSize;
+
+			U64 bit = 1ull << (y - 1);
+			bool relaxed = RelaxRow(row, row + from, rowWalls, rowWalls + from);
+
+			if (relaxed || (dirty & bit))
+			{
+				relaxed |= ScanRow(row, rowWalls);
+				dirty &= ~bit;
+			}
+
+			lowered |= relaxed;
+		}
+	}
+
+	dirtyRows[chunk] = 0;
+}
+
+U8 FlowField::Spread(U32 chunk) const
+{
+	I32 chunkX = chunk % chunkCount.x;
+	I32 chunkY = chunk / chunkCount.x;
+	const F32* cells = costs.Data() + (U64)chunk * PaddedArea;
+	const F32* chunkWalls = walls.Data() + (U64)chunk * PaddedArea;
+
+	//Neighbours are only swept again if a tile on this side of their edge is a shorter way into them,
+	//so the chunk that lowered this one isn't woken by its own distances flowing back
+	U8 edges = 0;
+	for (U8 i = 0; i < 8; ++i)
+	{
+		I32 dx = Neighbours[i][0];
+		I32 dy = Neighbours[i][1];
+		I32 x = chunkX + dx;
+		I32 y = chunkY + dy;
+		if (x < 0 || y < 0 || x >= chunkCount.x || y >= chunkCount.y) { continue; }
+
+		U64 neighbour = (U64)(x + y * chunkCount.x) * PaddedArea;
+		const F32* facing = costs.Data() + neighbour;
+		const F32* facingWalls = walls.Data() + neighbour;
+
+		U32 edge = (dy > 0 ? ChunkSize : 1) * PaddedSize + (dx > 0 ? ChunkSize : 1);
+		U32 face = (dy < 0 ? ChunkSize : 1) * PaddedSize + (dx < 0 ? ChunkSize : 1);
+
+		bool improves = dx && dy ?
+			facingWalls[face] == 0.0f && chunkWalls[edge + dx] == 0.0f && chunkWalls[edge + dy * PaddedSize] == 0.0f && cells[edge] + DiagonalCost < facing[face] :
+			Improves(cells + edge, chunkWalls + edge, facing + face, facingWalls + face, dx ? PaddedSize : 1, ChunkSize);
+
+		if (improves) { edges |= 1 << i; }
+	}
+
+	return edges;
+}
+
+void FlowField::BuildDirections(U32 chunk)
+{
+	I32 originX = (I32)(chunk % chunkCount.x) << ChunkShift;
+	I32 originY = (I32)(chunk / chunkCount.x) << ChunkShift;
+	I32 width = Math::Min(ChunkSize, dimensions.x - originX);
+	I32 height = Math::Min(ChunkSize, dimensions.y - originY);
+
+	const F32* cells = costs.Data() + (U64)chunk * PaddedArea;
+	const F32* chunkWalls = walls.Data() + (U64)chunk * PaddedArea;
+
+	for (I32 y = 0; y < height; ++y)
+	{
+		U8* row = directions.Data() + (U64)(originY + y) * dimensions.x + originX;
+
+		for (I32 x = 0; x < width; ++x)
+		{
+			U32 cell = (y + 1) * PaddedSize + x + 1;
+			F32 here = cells[cell];
+
+			//Each tile points at the neighbour its shortest path goes through, straight steps win ties
+			U8 best = NoDirection;
+			if (here != 0.0f && here != Unreachable)
+			{
+				F32 bestCost = Unreachable;
+
+				for (U8 i = 0; i < NoDirection; ++i)
+				{
+					I32 dx = Neighbours[i][0];
+					I32 dy = Neighbours[i][1];
+					bool diagonal = dx && dy;
+
+					if (diagonal && (chunkWalls[cell + dx] != 0.0f || chunkWalls[cell + dy * PaddedSize] != 0.0f)) { continue; }
+
+					F32 cost = cells[cell + dx + dy * PaddedSize] + (diagonal ? DiagonalCost : 1.0f);
+					if (cost < bestCost) { bestCost = cost; best = i; }
+				}
+			}
+
+			row[x] = best;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Math.hpp"
+
+#include "Containers/Vector.hpp"
+
+class TileGrid;
+
+/// <summary>
+/// Distance to one goal from every air tile of a tile grid along with the direction to step in, so any amount of agents
+/// chasing the same goal share a single search. Distances are found by sweeping chunks back and forth on the worker threads,
+/// chunks only wake up when a neighbour's edge changes, and moving the goal starts from the previous distances
+/// </summary>
+class NH_API FlowField
+{
+public:
+	static constexpr I32 ChunkShift = 6;
+	static constexpr I32 ChunkSize = 1 << ChunkShift;		//Tiles along each side of a chunk
+	static constexpr I32 PaddedSize = ChunkSize + 2;		//Each chunk keeps a copy of the tiles bordering it
+	static constexpr U32 PaddedArea = PaddedSize * PaddedSize;
+	static constexpr U8 NoDirection = 8;					//The goal, solid tiles and tiles that can't reach the goal
+
+	FlowField();
+	~FlowField();
+	void Destroy();
+
+	/// <summary>
+	/// Reads the tiles of grid, the grid must stay alive until Destroy
+	/// </summary>
+	void Create(const TileGrid* grid);
+
+	/// <summary>
+	/// Moves the goal, nothing is recomputed until Build
+	/// </summary>
+	void SetGoal(const Vector2Int& goal);
+
+	/// <summary>
+	/// Re-reads the tiles from min to max, inclusive, nothing is recomputed until Build
+	/// </summary>
+	void UpdateTiles(const Vector2Int& min, const Vector2Int& max);
+
+	/// <summary>
+	/// Sweeps chunks until the distances settle or budget seconds pass, a sweep that has started always finishes,
+	/// directions are only rewritten once everything settles, so agents keep following the previous field meanwhile
+	/// </summary>
+	/// <returns>true once the field has settled</returns>
+	bool Build(F64 budget = F64_MAX);
+
+	bool Settled() const;
+	const Vector2Int& Goal() const;
+
+	/// <summary>
+	/// The unit direction to step in from tile, zero at the goal and anywhere the goal can't be reached from
+	/// </summary>
+	Vector2 Direction(const Vector2Int& tile) const;
+
+	/// <summary>
+	/// The direction as an index into the eight neighbours, NoDirection at the goal and anywhere the goal can't be reached from
+	/// </summary>
+	U8 DirectionIndex(const Vector2Int& tile) const;
+
+	/// <summary>
+	/// The cost of the shortest path from tile to the goal, straight steps cost 1 and diagonal ones the square root of 2, infinite if there's no way,
+	/// only final once the field has settled
+	/// </summary>
+	F32 Distance(const Vector2Int& tile) const;
+
+private:
+	static constexpr U8 QueuedFlag = 1 << 0;
+	static constexpr U8 SweptFlag = 1 << 1;
+
+	void Reset();
+	bool ReadTiles(const Vector2Int& min, const Vector2Int& max);
+	void Queue(U32 chunk);
+	void PullBorders(U32 chunk);
+	void Sweep(U32 chunk);
+	U8 Spread(U32 chunk) const;
+	void BuildDirections(U32 chunk);
+	U64 Cell(I32 x, I32 y) const;
+
+	const TileGrid* tiles;
+	Vector2Int dimensions;
+	Vector2Int chunkCount;
+	Vector2Int goal;
+
+	Vector<F32> costs;			//Padded chunk after chunk, the border copies are refreshed before each sweep
+	Vector<F32> walls;			//0 for air, infinite for solid, laid out like costs with the border filled in up front
+	Vector<U8> directions;		//Row major over the whole grid
+
+	Vector<U8> chunkFlags;
+	Vector<U64> dirtyRows;		//One bit per row of each chunk whose tiles may still lower each other along the row
+	Vector<U8> chunkEdges;		//Which neighbours the last sweep can lower, one bit each in the order of Neighbours
+	Vector<U32> queuedChunks;	//Swept in the next round
+	Vector<U32> activeChunks;	//Swept in the current round
+	Vector<U32> sweptChunks;	//Swept at least once since the field last settled, their directions are rebuilt
+	bool reset;
+	bool settled;
+};
+
+inline U64 FlowField::Cell(I32 x, I32 y) const
+{
+	U64 chunk = (U64)(x >> ChunkShift) + (U64)(y >> ChunkShift) * chunkCount.x;
+	return chunk * PaddedArea + (U64)((y & (ChunkSize - 1)) + 1) * PaddedSize + (x & (ChunkSize - 1)) + 1;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "PairCache.hpp"
+
+PairCache::~PairCache()
+{
+	Destroy();
+}
+
+void PairCache::Destroy()
+{
+	pairs.Destroy();
+	slots.Destroy();
+	stamp = 0;
+}
+
+void PairCache::Begin()
+{
+	++stamp;
+}
+
+bool PairCache::Add(U32 a, U32 b)
+{
+	U64 key = Key(a, b);
+
+	if ((pairs.Size() + 1) * 2 > slots.Size()) { Grow(); }
+
+	U64 mask = slots.Size() - 1;
+	U64 i = Hash(key) & mask;
+	for (; slots[i] != U32_MAX; i = (i + 1) & mask)
+	{
+		Pair& pair = pairs[slots[i]];
+		if (pair.key == key)
+		{
+			pair.stamp = stamp;
+			return false;
+		}
+	}
+
+	slots[i] = (U32)pairs.Size();
+	pairs.Push({ key, (U32)i, stamp });
+
+	return true;
+}
+
+bool PairCache::Contains(U32 a, U32 b) const
+{
+	return Find(Key(a, b)) != U32_MAX;
+}
+
+U32 PairCache::Count() const
+{
+	return (U32)pairs.Size();
+}
+
+U32 PairCache::Find(U64 key) const
+{
+	if (slots.Empty()) { return U32_MAX; }
+
+	U64 mask = slots.Size() - 1;
+	for (U64 i = Hash(key) & mask; slots[i] != U32_MAX; i = (i + 1) & mask)
+	{
+		if (pairs[slots[i]].key == key) { return (U32)i; }
+	}
+
+	return U32_MAX;
+}
+
+void PairCache::Grow()
+{
+	U64 capacity = slots.Size() ? slots.Size() * 2 : 256;
+	slots = Vector<U32>(capacity, U32_MAX);
+
+	U64 mask = capacity - 1;
+	for (U32 p = 0; p < pairs.Size(); ++p)
+	{
+		U64 i = Hash(pairs[p].key) & mask;
+		while (slots[i] != U32_MAX) { i = (i + 1) & mask; }
+
+		slots[i] = p;
+		pairs[p].slot = (U32)i;
+	}
+}
+
+void PairCache::RemoveSlot(U32 hole)
+{
+	//Backward shift deletion, later slots of the same probe run move up so lookups never need tombstones
+	U64 mask = slots.Size() - 1;
+	U64 i = hole;
+	U64 j = hole;
+
+	while (true)
+	{
+		j = (j + 1) & mask;
+		if (slots[j] == U32_MAX) { break; }
+
+		U64 home = Hash(pairs[slots[j]].key) & mask;
+
+		//Only move j into the hole if its home isn't cyclically between the hole and j
+		if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) { continue; }
+
+		slots[i] = slots[j];
+		pairs[slots[i]].slot = (U32)i;
+		i = j;
+	}
+
+	slots[i] = U32_MAX;
+}
\ No newline at end of file
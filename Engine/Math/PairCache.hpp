@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Containers/Vector.hpp"
+
+/// <summary>
+/// Set of id pairs that persists between updates, pairs are keyed by their sorted ids in an open addressed table,
+/// each update re-adds the pairs that still exist and whatever wasn't re-added is dropped when the update ends
+/// </summary>
+class NH_API PairCache
+{
+public:
+	~PairCache();
+	void Destroy();
+
+	/// <summary>
+	/// Starts an update
+	/// </summary>
+	void Begin();
+
+	/// <returns>true if the pair wasn't in the cache before, the order of a and b doesn't matter</returns>
+	bool Add(U32 a, U32 b);
+
+	/// <summary>
+	/// Ends an update, calls callback(a, b) for every pair that wasn't added since Begin and removes it, a is always less than b
+	/// </summary>
+	template<class Callback>
+	void End(Callback&& callback);
+
+	bool Contains(U32 a, U32 b) const;
+	U32 Count() const;
+
+private:
+	struct Pair
+	{
+		U64 key;
+		U32 slot;		//Where in slots this pair is
+		U32 stamp;		//Update this pair was last added in
+	};
+
+	static U64 Key(U32 a, U32 b);
+	static U64 Hash(U64 key);
+
+	U32 Find(U64 key) const;
+	void Grow();
+	void RemoveSlot(U32 slot);
+
+	Vector<Pair> pairs;
+	Vector<U32> slots;		//Index into pairs, U32_MAX if empty
+	U32 stamp = 0;
+};
+
+inline U64 PairCache::Key(U32 a, U32 b)
+{
+	return a < b ? ((U64)a << 32) | b : ((U64)b << 32) | a;
+}
+
+inline U64 PairCache::Hash(U64 key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+
+	return key;
+}
+
+template<class Callback>
+inline void PairCache::End(Callback&& callback)
+{
+	for (U32 i = 0; i < pairs.Size();)
+	{
+		Pair& pair = pairs[i];
+		if (pair.stamp == stamp) { ++i; continue; }
+
+		callback((U32)(pair.key >> 32), (U32)pair.key);
+
+		RemoveSlot(pair.slot);
+
+		//Fill the hole with the last pair so pairs stays dense
+		Pair& last = pairs.Back();
+		if (&last != &pair)
+		{
+			pair = last;
+			slots[pair.slot] = i;
+		}
+
+		pairs.Pop();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,1139 @@
+#include "Pathfinding.hpp"
+
+#include "Core/Time.hpp"
+#include "Multithreading/Jobs.hpp"
+#include "Resources/TileGrid.hpp"
+
+#include "tracy/Tracy.hpp"
+
+#include <bit>
+
+Vector<Pathfinding::PathGrid> Pathfinding::grids;
+Vector<Pathfinding::PathRequest> Pathfinding::requests;
+U32 Pathfinding::freeRequest = U32_MAX;
+Vector<U32> Pathfinding::pendingRequests;
+U32 Pathfinding::nextPending = 0;
+Vector<Pathfinding::SearchScratch> Pathfinding::scratches;
+F64 Pathfinding::frameBudget = Pathfinding::DefaultFrameBudget;
+F64 Pathfinding::requestTime = 0.0;
+
+static constexpr F32 DiagonalCost = 1.41421356f;
+
+//Costs inside a cluster are counted in whole units, 17/12 is within 0.2% of the diagonal cost
+static constexpr U16 StraightUnits = 12;
+static constexpr U16 DiagonalUnits = 17;
+
+static constexpr I32 Directions[8][2] = {
+	{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+	{ 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+};
+
+static F32 Octile(I32 dx, I32 dy)
+{
+	dx = Math::Abs(dx);
+	dy = Math::Abs(dy);
+
+	return (F32)(dx + dy) + (DiagonalCost - 2.0f) * (F32)Math::Min(dx, dy);
+}
+
+static F32 LocalCost(U16 units)
+{
+	return units == U16_MAX ? F32_MAX : units * (1.0f / StraightUnits);
+}
+
+static I32 Sign(I32 value)
+{
+	return (value > 0) - (value < 0);
+}
+
+template<class Entry>
+static void PushOpen(Vector<Entry>& heap, const Entry& entry)
+{
+	U64 i = heap.Size();
+	heap.Push(entry);
+
+	while (i)
+	{
+		U64 parent = (i - 1) / 2;
+		if (heap[parent].score <= entry.score) { break; }
+
+		heap[i] = heap[parent];
+		i = parent;
+	}
+
+	heap[i] = entry;
+}
+
+template<class Entry>
+static Entry PopOpen(Vector<Entry>& heap)
+{
+	Entry top = heap[0];
+	Entry last;
+	heap.Pop(last);
+
+	U64 count = heap.Size();
+	if (!count) { return top; }
+
+	U64 i = 0;
+	while (true)
+	{
+		U64 child = i * 2 + 1;
+		if (child >= count) { break; }
+		if (child + 1 < count && heap[child + 1].score < heap[child].score) { ++child; }
+		if (last.score <= heap[child].score) { break; }
+
+		heap[i] = heap[child];
+		i = child;
+	}
+
+	heap[i] = last;
+
+	return top;
+}
+
+//Walks forward along row y from x, returns the first jump point or the goal, I32_MAX if a solid tile comes first
+template<class Grid>
+static I32 ScanForward(const Grid& bits, I32 x, I32 y, I32 goalX, I32 goalY)
+{
+	for (;; x += 64)
+	{
+		//A tile is forced when the tile beside it is open but the one behind that is solid, the path may have to turn there
+		U64 blocked = bits.Bits(x + 1, y);
+		U64 forced = (~bits.Bits(x + 1, y - 1) & bits.Bits(x, y - 1)) | (~bits.Bits(x + 1, y + 1) & bits.Bits(x, y + 1));
+		U64 stop = blocked | forced;
+
+		I32 offset = stop ? std::countr_zero(stop) : 63;
+		if (goalY == y && goalX > x && goalX - x - 1 <= offset) { return goalX; }
+
+		if (stop) { return (blocked >> offset) & 1 ? I32_MAX : x + 1 + offset; }
+	}
+}
+
+//Same as ScanForward walking toward lower x
+template<class Grid>
+static I32 ScanBackward(const Grid& bits, I32 x, I32 y, I32 goalX, I32 goalY)
+{
+	for (;; x -= 64)
+	{
+		U64 blocked = bits.Bits(x - 64, y);
+		U64 forced = (~bits.Bits(x - 64, y - 1) & bits.Bits(x - 63, y - 1)) | (~bits.Bits(x - 64, y + 1) & bits.Bits(x - 63, y + 1));
+		U64 stop = blocked | forced;
+
+		I32 offset = stop ? 63 - std::countl_zero(stop) : 0;
+		if (goalY == y && goalX < x && goalX >= x - 64 + offset) { return goalX; }
+
+		if (stop) { return (blocked >> offset) & 1 ? I32_MAX : x - 64 + offset; }
+	}
+}
+
+bool Pathfinding::Initialize()
+{
+	return true;
+}
+
+void Pathfinding::Shutdown()
+{
+	for (U32 i = 0; i < grids.Size(); ++i) { RemoveGrid(i); }
+
+	grids.Destroy();
+	requests.Destroy();
+	freeRequest = U32_MAX;
+	pendingRequests.Destroy();
+	nextPending = 0;
+	scratches.Destroy();
+}
+
+void Pathfinding::Update()
+{
+	ZoneScopedN("Pathfinding");
+
+	for (PathGrid& grid : grids)
+	{
+		if (grid.tiles) { Repair(grid); }
+	}
+
+	U32 threads = Jobs::ThreadCount();
+	while (scratches.Size() < threads) { scratches.Push({}); }
+
+	F64 updateStart = Time::AbsoluteTime();
+	F64 elapsed = 0.0;
+
+	while (nextPending < pendingRequests.Size())
+	{
+		//Rounds are sized by how long requests have been taking so the last one doesn't run far past the budget
+		U32 perThread = 1;
+		if (requestTime > 0.0) { perThread = (U32)Math::Clamp((frameBudget - elapsed) / requestTime, 1.0, (F64)RequestsPerThread); }
+
+		U32 count = Math::Min((U32)pendingRequests.Size() - nextPending, threads * perThread);
+		U32 batchSize = (count + threads - 1) / threads;
+		const U32* batch = pendingRequests.Data() + nextPending;
+
+		Jobs::ParallelFor(count, batchSize, [batch, batchSize](U32 start, U32 end)
+		{
+			SearchScratch& scratch = scratches[start / batchSize];
+
+			for (U32 i = start; i < end; ++i)
+			{
+				PathRequest& request = requests[batch[i]];
+				if (!request.alive || request.status != PathStatus::Pending) { continue; }
+
+				const PathGrid& grid = grids[request.grid];
+				request.status = grid.tiles && Search(grid, request.start, request.goal, scratch, request.path) ? PathStatus::Found : PathStatus::NotFound;
+			}
+		});
+
+		nextPending += count;
+
+		F64 now = Time::AbsoluteTime() - updateStart;
+		F64 taken = (now - elapsed) / batchSize;
+		requestTime = requestTime > 0.0 ? (requestTime + taken) * 0.5 : taken;
+		elapsed = now;
+
+		if (elapsed >= frameBudget) { break; }
+	}
+
+	if (nextPending == pendingRequests.Size())
+	{
+		pendingRequests.Clear();
+		nextPending = 0;
+	}
+
+	TracyPlot("Pending Paths", (I64)(pendingRequests.Size() - nextPending));
+}
+
+U32 Pathfinding::AddGrid(const TileGrid* tiles)
+{
+	U32 index = (U32)grids.Size();
+	PathGrid& grid = grids.Push({});
+
+	grid.tiles = tiles;
+	grid.dimensions = tiles->Dimensions();
+	grid.clusterCount = { (grid.dimensions.x + ClusterSize - 1) / ClusterSize, (grid.dimensions.y + ClusterSize - 1) / ClusterSize };
+	grid.rows.Create(grid.dimensions.x, grid.dimensions.y);
+	grid.columns.Create(grid.dimensions.y, grid.dimensions.x);
+	grid.freeNode = U32_MAX;
+
+	U32 clusterCount = grid.clusterCount.x * grid.clusterCount.y;
+	grid.clusters.Reserve(clusterCount);
+	for (U32 i = 0; i < clusterCount; ++i) { grid.clusters.Push({}); }
+
+	UpdateGrid(index, Vector2Int::Zero, grid.dimensions - Vector2Int::One);
+	Repair(grid);
+
+	return index;
+}
+
+void Pathfinding::UpdateGrid(U32 index, const Vector2Int& min, const Vector2Int& max)
+{
+	PathGrid& grid = grids[index];
+	if (!grid.tiles) { return; }
+
+	Vector2Int start = { Math::Max(min.x, 0), Math::Max(min.y, 0) };
+	Vector2Int end = { Math::Min(max.x, grid.dimensions.x - 1), Math::Min(max.y, grid.dimensions.y - 1) };
+	if (start.x > end.x || start.y > end.y) { return; }
+
+	ReadTiles(grid, start, end);
+
+	for (I32 y = start.y / ClusterSize; y <= end.y / ClusterSize; ++y)
+	{
+		for (I32 x = start.x / ClusterSize; x <= end.x / ClusterSize; ++x) { MarkCluster(grid, x + y * grid.clusterCount.x); }
+	}
+}
+
+void Pathfinding::RemoveGrid(U32 index)
+{
+	//Indices are handed out to callers, so the slot stays and requests on it fail
+	PathGrid& grid = grids[index];
+	grid.tiles = nullptr;
+	grid.rows.words.Destroy();
+	grid.columns.words.Destroy();
+	grid.nodes.Destroy();
+	grid.clusters.Destroy();
+	grid.dirtyClusters.Destroy();
+}
+
+bool Pathfinding::Walkable(U32 index, const Vector2Int& tile)
+{
+	const PathGrid& grid = grids[index];
+
+	return grid.tiles && tile.x >= 0 && tile.y >= 0 && tile.x < grid.dimensions.x && tile.y < grid.dimensions.y && !grid.rows.Solid(tile.x, tile.y);
+}
+
+bool Pathfinding::FindPath(U32 index, const Vector2Int& start, const Vector2Int& goal, Vector<Vector2Int>& path)
+{
+	ZoneScopedN("Find Path");
+
+	PathGrid& grid = grids[index];
+	if (!grid.tiles) { return false; }
+
+	Repair(grid);
+
+	if (scratches.Empty()) { scratches.Push({}); }
+
+	return Search(grid, start, goal, scratches[0], path);
+}
+
+U32 Pathfinding::RequestPath(U32 grid, const Vector2Int& start, const Vector2Int& goal)
+{
+	U32 id;
+	if (freeRequest != U32_MAX)
+	{
+		id = freeRequest;
+		freeRequest = requests[id].nextFree;
+	}
+	else
+	{
+		id = (U32)requests.Size();
+		requests.Push({});
+	}
+
+	PathRequest& request = requests[id];
+	request.grid = grid;
+	request.start = start;
+	request.goal = goal;
+	request.path.Clear();
+	request.nextFree = U32_MAX;
+	request.status = grid < grids.Size() ? PathStatus::Pending : PathStatus::NotFound;
+	request.alive = true;
+
+	if (request.status == PathStatus::Pending) { pendingRequests.Push(id); }
+
+	return id;
+}
+
+PathStatus Pathfinding::Status(U32 request)
+{
+	if (request >= requests.Size() || !requests[request].alive) { return PathStatus::NotFound; }
+
+	return requests[request].status;
+}
+
+const Vector<Vector2Int>& Pathfinding::Path(U32 request)
+{
+	return requests[request].path;
+}
+
+void Pathfinding::ReleasePath(U32 id)
+{
+	if (id >= requests.Size() || !requests[id].alive) { return; }
+
+	//The id may still be queued, a request reusing the slot is solved by whichever entry comes first
+	PathRequest& request = requests[id];
+	request.alive = false;
+	request.nextFree = freeRequest;
+	freeRequest = id;
+}
+
+void Pathfinding::SetFrameBudget(F64 seconds)
+{
+	frameBudget = seconds;
+}
+
+U32 Pathfinding::PendingRequests()
+{
+	return (U32)pendingRequests.Size() - nextPending;
+}
+
+bool Pathfinding::Search(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, SearchScratch& scratch, Vector<Vector2Int>& path)
+{
+	path.Clear();
+
+	if (start.x < 0 || start.y < 0 || start.x >= grid.dimensions.x || start.y >= grid.dimensions.y ||
+		goal.x < 0 || goal.y < 0 || goal.x >= grid.dimensions.x || goal.y >= grid.dimensions.y ||
+		grid.rows.Solid(start.x, start.y) || grid.rows.Solid(goal.x, goal.y)) { return false; }
+
+	if (start == goal)
+	{
+		path.Push(start);
+		return true;
+	}
+
+	//Without this a goal walled off from the start would be searched for across everything the start can reach
+	if (!Reachable(grid, start, goal)) { return false; }
+
+	if (Math::Max(Math::Abs(goal.x - start.x), Math::Abs(goal.y - start.y)) > LongRouteDistance)
+	{
+		return HierarchicalSearch(grid, start, goal, scratch, path);
+	}
+
+	//The goal is reachable, so a short route only fails when it winds too far around before getting there
+	return JumpSearch(grid, start, goal, JumpPointLimit, scratch, path) || HierarchicalSearch(grid, start, goal, scratch, path);
+}
+
+bool Pathfinding::Reachable(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal)
+{
+	U32 startCluster = ClusterOf(grid, start);
+	U32 goalCluster = ClusterOf(grid, goal);
+
+	U32 mask[ClusterSize];
+	FloodCluster(grid, start, mask);
+
+	if (startCluster == goalCluster && (mask[goal.y % ClusterSize] >> (goal.x % ClusterSize)) & 1) { return true; }
+
+	//Every node a tile reaches inside its cluster shares a component, so one is enough on each side
+	U32 component = U32_MAX;
+	for (U32 node : grid.clusters[startCluster].nodes)
+	{
+		const Vector2Int& tile = grid.nodes[node].tile;
+		if ((mask[tile.y % ClusterSize] >> (tile.x % ClusterSize)) & 1) { component = grid.nodes[node].component; break; }
+	}
+
+	if (component == U32_MAX) { return false; }
+
+	FloodCluster(grid, goal, mask);
+
+	for (U32 node : grid.clusters[goalCluster].nodes)
+	{
+		const Vector2Int& tile = grid.nodes[node].tile;
+		if ((mask[tile.y % ClusterSize] >> (tile.x % ClusterSize)) & 1) { return grid.nodes[node].component == component; }
+	}
+
+	return false;
+}
+
+void Pathfinding::FloodCluster(const PathGrid& grid, const Vector2Int& tile, U32* mask)
+{
+	I32 minX = tile.x / ClusterSize * ClusterSize;
+	I32 minY = tile.y / ClusterSize * ClusterSize;
+	I32 rows = Math::Min(ClusterSize, grid.dimensions.y - minY);
+
+	//Tiles past the right edge of the grid are solid in the bitmap, rows past the bottom are never read
+	U32 open[ClusterSize];
+	for (I32 y = 0; y < rows; ++y)
+	{
+		open[y] = ~(U32)grid.rows.Bits(minX, minY + y);
+		mask[y] = 0;
+	}
+
+	mask[tile.y - minY] = 1u << (tile.x - minX);
+
+	//Diagonal moves need both tiles beside them open, so the tiles a path can reach are exactly the four-connected ones
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		for (I32 y = 0; y < rows; ++y)
+		{
+			U32 row = mask[y] | (mask[y] >> 1) | (mask[y] << 1);
+			if (y > 0) { row |= mask[y - 1]; }
+			if (y + 1 < rows) { row |= mask[y + 1]; }
+			row &= open[y];
+
+			//Adding carries each reached tile through the rest of its run toward higher bits
+			row |= ((open[y] + row) ^ open[y]) & open[y];
+
+			if (row != mask[y])
+			{
+				mask[y] = row;
+				changed = true;
+			}
+		}
+	}
+}
+
+bool Pathfinding::JumpSearch(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, U32 limit, SearchScratch& scratch, Vector<Vector2Int>& path)
+{
+	U32 width = (U32)grid.dimensions.x;
+	U32 goalTile = goal.x + goal.y * width;
+
+	scratch.records.Clear();
+	scratch.open.Clear();
+
+	if (++scratch.stamp == 0)
+	{
+		for (RecordSlot& slot : scratch.table) { slot.stamp = 0; }
+		scratch.stamp = 1;
+	}
+
+	U32 first = FindRecord(scratch, start.x + start.y * width);
+	scratch.records[first].cost = 0.0f;
+	PushOpen(scratch.open, OpenEntry{ Octile(goal.x - start.x, goal.y - start.y), first });
+
+	while (!scratch.open.Empty() && scratch.records.Size() <= limit)
+	{
+		OpenEntry entry = PopOpen(scratch.open);
+
+		JumpRecord record = scratch.records[entry.index];
+		if (record.closed) { continue; }
+		scratch.records[entry.index].closed = true;
+
+		if (record.tile == goalTile)
+		{
+			path.Clear();
+			for (U32 i = entry.index; i != U32_MAX; i = scratch.records[i].parent)
+			{
+				U32 tile = scratch.records[i].tile;
+				path.Push({ (I32)(tile % width), (I32)(tile / width) });
+			}
+
+			for (U64 i = 0, j = path.Size() - 1; i < j; ++i, --j) { Swap(path[i], path[j]); }
+
+			return true;
+		}
+
+		I32 x = record.tile % width;
+		I32 y = record.tile / width;
+
+		//Only directions the path could turn into are followed, the rest are reached more cheaply through the parent
+		I32 directions[8][2];
+		U32 directionCount = 0;
+
+		if (record.parent == U32_MAX)
+		{
+			for (const I32* direction : Directions)
+			{
+				directions[directionCount][0] = direction[0];
+				directions[directionCount++][1] = direction[1];
+			}
+		}
+		else
+		{
+			U32 parent = scratch.records[record.parent].tile;
+			I32 dx = Sign(x - (I32)(parent % width));
+			I32 dy = Sign(y - (I32)(parent / width));
+
+			auto add = [&](I32 directionX, I32 directionY)
+			{
+				directions[directionCount][0] = directionX;
+				directions[directionCount++][1] = directionY;
+			};
+
+			if (dx && dy) { add(dx, 0); add(0, dy); add(dx, dy); }
+			else if (dx) { add(dx, 0); add(dx, 1); add(dx, -1); add(0, 1); add(0, -1); }
+			else { add(0, dy); add(1, dy); add(-1, dy); add(1, 0); add(-1, 0); }
+		}
+
+		for (U32 i = 0; i < directionCount; ++i)
+		{
+			Vector2Int jumpPoint;
+			if (!Jump(grid, x, y, directions[i][0], directions[i][1], goal, jumpPoint)) { continue; }
+
+			F32 cost = record.cost + Octile(jumpPoint.x - x, jumpPoint.y - y);
+			U32 next = FindRecord(scratch, jumpPoint.x + jumpPoint.y * width);
+
+			JumpRecord& nextRecord = scratch.records[next];
+			if (nextRecord.closed || cost >= nextRecord.cost) { continue; }
+
+			nextRecord.cost = cost;
+			nextRecord.parent = entry.index;
+			PushOpen(scratch.open, OpenEntry{ cost + Octile(goal.x - jumpPoint.x, goal.y - jumpPoint.y), next });
+		}
+	}
+
+	return false;
+}
+
+bool Pathfinding::Jump(const PathGrid& grid, I32 x, I32 y, I32 dx, I32 dy, const Vector2Int& goal, Vector2Int& jumpPoint)
+{
+	if (!dy)
+	{
+		I32 jumpX = dx > 0 ? ScanForward(grid.rows, x, y, goal.x, goal.y) : ScanBackward(grid.rows, x, y, goal.x, goal.y);
+		jumpPoint = { jumpX, y };
+		return jumpX != I32_MAX;
+	}
+
+	if (!dx)
+	{
+		I32 jumpY = dy > 0 ? ScanForward(grid.columns, y, x, goal.y, goal.x) : ScanBackward(grid.columns, y, x, goal.y, goal.x);
+		jumpPoint = { x, jumpY };
+		return jumpY != I32_MAX;
+	}
+
+	//Diagonal steps need both tiles beside them open, a tile is a jump point if either straight scan from it finds one
+	while (true)
+	{
+		if (grid.rows.Solid(x + dx, y + dy) || grid.rows.Solid(x + dx, y) || grid.rows.Solid(x, y + dy)) { return false; }
+
+		x += dx;
+		y += dy;
+
+		if ((x == goal.x && y == goal.y) ||
+			(dx > 0 ? ScanForward(grid.rows, x, y, goal.x, goal.y) : ScanBackward(grid.rows, x, y, goal.x, goal.y)) != I32_MAX ||
+			(dy > 0 ? ScanForward(grid.columns, y, x, goal.y, goal.x) : ScanBackward(grid.columns, y, x, goal.y, goal.x)) != I32_MAX)
+		{
+			jumpPoint = { x, y };
+			return true;
+		}
+	}
+}
+
+U32 Pathfinding::FindRecord(SearchScratch& scratch, U32 tile)
+{
+	if ((scratch.records.Size() + 1) * 2 > scratch.table.Size())
+	{
+		U64 capacity = scratch.table.Size() ? scratch.table.Size() * 2 : 1024;
+		scratch.table = Vector<RecordSlot>(capacity, RecordSlot{ 0, 0 });
+		if (!scratch.stamp) { scratch.stamp = 1; }
+
+		U64 mask = capacity - 1;
+		for (U32 i = 0; i < scratch.records.Size(); ++i)
+		{
+			U64 slot = Hash(scratch.records[i].tile) & mask;
+			while (scratch.table[slot].stamp == scratch.stamp) { slot = (slot + 1) & mask; }
+
+			scratch.table[slot] = { i, scratch.stamp };
+		}
+	}
+
+	U64 mask = scratch.table.Size() - 1;
+	for (U64 slot = Hash(tile) & mask;; slot = (slot + 1) & mask)
+	{
+		RecordSlot& entry = scratch.table[slot];
+
+		if (entry.stamp != scratch.stamp)
+		{
+			entry = { (U32)scratch.records.Size(), scratch.stamp };
+			scratch.records.Push({ tile, U32_MAX, F32_MAX, false });
+			return entry.record;
+		}
+
+		if (scratch.records[entry.record].tile == tile) { return entry.record; }
+	}
+}
+
+bool Pathfinding::HierarchicalSearch(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, SearchScratch& scratch, Vector<Vector2Int>& path)
+{
+	U32 startCluster = ClusterOf(grid, start);
+	U32 goalCluster = ClusterOf(grid, goal);
+
+	const PathCluster& first = grid.clusters[startCluster];
+	const PathCluster& last = grid.clusters[goalCluster];
+
+	//The start and goal join the graph through the nodes of their clusters they can reach without leaving them
+	LocalCosts(grid, startCluster, start, 0, scratch);
+	Vector2Int origin = { (I32)(startCluster % grid.clusterCount.x) * ClusterSize, (I32)(startCluster / grid.clusterCount.x) * ClusterSize };
+	scratch.startCosts.Resize(first.nodes.Size());
+	for (U32 i = 0; i < first.nodes.Size(); ++i)
+	{
+		Vector2Int tile = grid.nodes[first.nodes[i]].tile - origin;
+		scratch.startCosts[i] = LocalCost(scratch.localCosts[tile.x + tile.y * ClusterSize]);
+	}
+
+	LocalCosts(grid, goalCluster, goal, 0, scratch);
+	origin = { (I32)(goalCluster % grid.clusterCount.x) * ClusterSize, (I32)(goalCluster / grid.clusterCount.x) * ClusterSize };
+	scratch.goalCosts.Resize(last.nodes.Size());
+	for (U32 i = 0; i < last.nodes.Size(); ++i)
+	{
+		Vector2Int tile = grid.nodes[last.nodes[i]].tile - origin;
+		scratch.goalCosts[i] = LocalCost(scratch.localCosts[tile.x + tile.y * ClusterSize]);
+	}
+
+	//The goal is one past the last node
+	U32 goalNode = (U32)grid.nodes.Size();
+	if (scratch.nodeStamps.Size() < goalNode + 1)
+	{
+		U64 previous = scratch.nodeStamps.Size();
+		scratch.nodeCosts.Resize(goalNode + 1);
+		scratch.nodeParents.Resize(goalNode + 1);
+		scratch.nodeStamps.Resize(goalNode + 1);
+		for (U64 i = previous; i < scratch.nodeStamps.Size(); ++i) { scratch.nodeStamps[i] = 0; }
+	}
+
+	//Each search takes two stamps, the second marks nodes that were already expanded
+	scratch.nodeStamp += 2;
+	if (scratch.nodeStamp >= U32_MAX - 1)
+	{
+		for (U32& stamp : scratch.nodeStamps) { stamp = 0; }
+		scratch.nodeStamp = 1;
+	}
+
+	U32 closed = scratch.nodeStamp + 1;
+
+	auto heuristic = [&](U32 node) { return node == goalNode ? 0.0f : Octile(goal.x - grid.nodes[node].tile.x, goal.y - grid.nodes[node].tile.y); };
+
+	auto relax = [&](U32 node, F32 cost, U32 parent)
+	{
+		if (scratch.nodeStamps[node] == closed || (scratch.nodeStamps[node] == scratch.nodeStamp && cost >= scratch.nodeCosts[node])) { return; }
+
+		scratch.nodeStamps[node] = scratch.nodeStamp;
+		scratch.nodeCosts[node] = cost;
+		scratch.nodeParents[node] = parent;
+		PushOpen(scratch.open, OpenEntry{ cost + heuristic(node), node });
+	};
+
+	scratch.open.Clear();
+	for (U32 i = 0; i < first.nodes.Size(); ++i)
+	{
+		if (scratch.startCosts[i] < F32_MAX) { relax(first.nodes[i], scratch.startCosts[i], U32_MAX); }
+	}
+
+	bool found = false;
+	while (!scratch.open.Empty())
+	{
+		OpenEntry entry = PopOpen(scratch.open);
+		U32 index = entry.index;
+
+		//Entries left behind by a cheaper path to the same node
+		if (scratch.nodeStamps[index] == closed || entry.score != scratch.nodeCosts[index] + heuristic(index)) { continue; }
+		if (index == goalNode) { found = true; break; }
+
+		scratch.nodeStamps[index] = closed;
+
+		const PathNode& node = grid.nodes[index];
+		const PathCluster& cluster = grid.clusters[node.cluster];
+		F32 cost = scratch.nodeCosts[index];
+
+		if (node.cluster == goalCluster && scratch.goalCosts[node.slot] < F32_MAX) { relax(goalNode, cost + scratch.goalCosts[node.slot], index); }
+
+		relax(node.twin, cost + 1.0f, index);
+
+		U32 count = (U32)cluster.nodes.Size();
+		const F32* costs = cluster.costs.Data() + node.slot * count;
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (i != node.slot && costs[i] < F32_MAX) { relax(cluster.nodes[i], cost + costs[i], index); }
+		}
+	}
+
+	if (!found) { return false; }
+
+	scratch.route.Clear();
+	for (U32 node = scratch.nodeParents[goalNode]; node != U32_MAX; node = scratch.nodeParents[node]) { scratch.route.Push(node); }
+
+	//Each hop is refined on its own, twins are neighbours and every other hop stays around one cluster
+	path.Clear();
+	path.Push(start);
+	Vector2Int from = start;
+
+	for (U64 i = scratch.route.Size() + 1; i-- > 0;)
+	{
+		Vector2Int to = i ? grid.nodes[scratch.route[i - 1]].tile : goal;
+		if (to == from) { continue; }
+
+		bool straight = to.x == from.x || to.y == from.y;
+		if (Math::Abs(to.x - from.x) <= 1 && Math::Abs(to.y - from.y) <= 1 && (straight || (!grid.rows.Solid(to.x, from.y) && !grid.rows.Solid(from.x, to.y))))
+		{
+			path.Push(to);
+		}
+		else
+		{
+			if (!JumpSearch(grid, from, to, U32_MAX, scratch, scratch.segment)) { return false; }
+			for (U64 j = 1; j < scratch.segment.Size(); ++j) { path.Push(scratch.segment[j]); }
+		}
+
+		from = to;
+	}
+
+	//Hops that continue in the same direction leave points in the middle of a straight line
+	U64 count = 1;
+	for (U64 i = 1; i < path.Size(); ++i)
+	{
+		if (i + 1 < path.Size())
+		{
+			const Vector2Int& previous = path[count - 1];
+			const Vector2Int& current = path[i];
+			const Vector2Int& next = path[i + 1];
+
+			if (Sign(current.x - previous.x) == Sign(next.x - current.x) && Sign(current.y - previous.y) == Sign(next.y - current.y)) { continue; }
+		}
+
+		path[count++] = path[i];
+	}
+
+	path.Resize(count);
+
+	return true;
+}
+
+void Pathfinding::LocalCosts(const PathGrid& grid, U32 cluster, const Vector2Int& source, U32 firstTarget, SearchScratch& scratch)
+{
+	I32 minX = (I32)(cluster % grid.clusterCount.x) * ClusterSize;
+	I32 minY = (I32)(cluster / grid.clusterCount.x) * ClusterSize;
+	I32 rows = Math::Min(ClusterSize, grid.dimensions.y - minY);
+
+	U32 open[ClusterSize];
+	for (I32 y = 0; y < rows; ++y) { open[y] = ~(U32)grid.rows.Bits(minX, minY + y); }
+
+	auto walkable = [&](I32 x, I32 y) { return x >= 0 && y >= 0 && x < ClusterSize && y < rows && ((open[y] >> x) & 1); };
+
+	//The search stops once the tiles of the cluster's nodes from firstTarget on are all settled, nodes can share a tile
+	U32 targets[ClusterSize] = {};
+	const Vector<U32>& nodes = grid.clusters[cluster].nodes;
+	for (U64 i = firstTarget; i < nodes.Size(); ++i)
+	{
+		const Vector2Int& tile = grid.nodes[nodes[i]].tile;
+		targets[tile.y - minY] |= 1u << (tile.x - minX);
+	}
+
+	U32 remaining = 0;
+	for (I32 y = 0; y < rows; ++y) { remaining += std::popcount(targets[y]); }
+
+	if (scratch.localCosts.Size() != ClusterSize * ClusterSize) { scratch.localCosts.Resize(ClusterSize * ClusterSize); }
+	U16* costs = scratch.localCosts.Data();
+	for (U32 i = 0; i < ClusterSize * ClusterSize; ++i) { costs[i] = U16_MAX; }
+
+	//Steps cost whole units, so a bucket per cost replaces the heap, buckets are reused once the search has moved past them
+	U16 first = (U16)((source.x - minX) + (source.y - minY) * ClusterSize);
+	costs[first] = 0;
+	for (Vector<U16>& bucket : scratch.buckets) { bucket.Clear(); }
+	scratch.buckets[0].Push(first);
+	U32 pending = 1;
+
+	for (U32 current = 0; pending && remaining; ++current)
+	{
+		Vector<U16>& bucket = scratch.buckets[current & (LocalBucketCount - 1)];
+
+		while (!bucket.Empty())
+		{
+			U16 index;
+			bucket.Pop(index);
+			--pending;
+
+			if (costs[index] != current) { continue; }
+
+			I32 x = index % ClusterSize;
+			I32 y = index / ClusterSize;
+
+			if ((targets[y] >> x) & 1 && !--remaining) { break; }
+
+			for (const I32* direction : Directions)
+			{
+				I32 nx = x + direction[0];
+				I32 ny = y + direction[1];
+				if (!walkable(nx, ny)) { continue; }
+
+				bool diagonal = direction[0] && direction[1];
+				if (diagonal && (!walkable(nx, y) || !walkable(x, ny))) { continue; }
+
+				U32 cost = current + (diagonal ? DiagonalUnits : StraightUnits);
+				U16 next = (U16)(nx + ny * ClusterSize);
+				if (cost >= costs[next]) { continue; }
+
+				costs[next] = (U16)cost;
+				scratch.buckets[cost & (LocalBucketCount - 1)].Push(next);
+				++pending;
+			}
+		}
+	}
+}
+
+void Pathfinding::Repair(PathGrid& grid)
+{
+	if (grid.dirtyClusters.Empty()) { return; }
+
+	ZoneScopedN("Pathfinding Repair");
+
+	U32 changed = (U32)grid.dirtyClusters.Size();
+	I32 countX = grid.clusterCount.x;
+	I32 countY = grid.clusterCount.y;
+
+	auto neighbours = [&](U32 cluster, auto&& callback)
+	{
+		I32 x = cluster % countX;
+		I32 y = cluster / countX;
+		if (x > 0) { callback(cluster - 1); }
+		if (y > 0) { callback(cluster - countX); }
+		if (x + 1 < countX) { callback(cluster + 1); }
+		if (y + 1 < countY) { callback(cluster + countX); }
+	};
+
+	//Every opening along the edges of a changed cluster is found again, an edge between two changed clusters only once
+	for (U32 i = 0; i < changed; ++i)
+	{
+		U32 cluster = grid.dirtyClusters[i];
+
+		neighbours(cluster, [&](U32 neighbour)
+		{
+			if (grid.clusters[neighbour].dirty && neighbour < cluster) { return; }
+
+			RemoveBorder(grid, cluster, neighbour);
+			BuildBorder(grid, Math::Min(cluster, neighbour), Math::Max(cluster, neighbour));
+		});
+	}
+
+	//Neighbours gained or lost nodes along the shared edge, so their costs are rebuilt too
+	for (U32 i = 0; i < changed; ++i)
+	{
+		neighbours(grid.dirtyClusters[i], [&](U32 neighbour) { MarkCluster(grid, neighbour); });
+	}
+
+	U32 count = (U32)grid.dirtyClusters.Size();
+	U32 threads = Jobs::ThreadCount();
+	while (scratches.Size() < threads) { scratches.Push({}); }
+
+	U32 batchSize = (count + threads - 1) / threads;
+	Jobs::ParallelFor(count, batchSize, [&grid, batchSize](U32 start, U32 end)
+	{
+		SearchScratch& scratch = scratches[start / batchSize];
+		for (U32 i = start; i < end; ++i) { BuildCosts(grid, grid.dirtyClusters[i], scratch); }
+	});
+
+	for (U32 cluster : grid.dirtyClusters) { grid.clusters[cluster].dirty = false; }
+	grid.dirtyClusters.Clear();
+
+	LabelComponents(grid);
+}
+
+void Pathfinding::LabelComponents(PathGrid& grid)
+{
+	ZoneScopedN("Pathfinding Components");
+
+	for (PathNode& node : grid.nodes) { node.component = U32_MAX; }
+
+	Vector<U32> stack;
+	U32 component = 0;
+
+	for (U32 seed = 0; seed < grid.nodes.Size(); ++seed)
+	{
+		if (grid.nodes[seed].cluster == U32_MAX || grid.nodes[seed].component != U32_MAX) { continue; }
+
+		grid.nodes[seed].component = component;
+		stack.Push(seed);
+
+		//A node's cost row already lists every node it reaches inside its cluster, those are labelled together and only their twins are pushed
+		while (!stack.Empty())
+		{
+			U32 index;
+			stack.Pop(index);
+
+			const PathNode& node = grid.nodes[index];
+			const PathCluster& cluster = grid.clusters[node.cluster];
+			U32 count = (U32)cluster.nodes.Size();
+			const F32* costs = cluster.costs.Data() + node.slot * count;
+
+			for (U32 i = 0; i < count; ++i)
+			{
+				PathNode& other = grid.nodes[cluster.nodes[i]];
+				if (costs[i] == F32_MAX || (other.component == component && i != node.slot)) { continue; }
+
+				other.component = component;
+
+				PathNode& twin = grid.nodes[other.twin];
+				if (twin.component == U32_MAX)
+				{
+					twin.component = component;
+					stack.Push(other.twin);
+				}
+			}
+		}
+
+		++component;
+	}
+}
+
+void Pathfinding::RemoveBorder(PathGrid& grid, U32 cluster, U32 neighbour)
+{
+	Vector<U32>& nodes = grid.clusters[cluster].nodes;
+
+	//Removing swaps the last node in, which was already visited going backwards
+	for (U64 i = nodes.Size(); i-- > 0;)
+	{
+		U32 node = nodes[i];
+		U32 twin = grid.nodes[node].twin;
+		if (grid.nodes[twin].cluster != neighbour) { continue; }
+
+		FreeNode(grid, twin);
+		FreeNode(grid, node);
+	}
+}
+
+void Pathfinding::BuildBorder(PathGrid& grid, U32 cluster, U32 neighbour)
+{
+	I32 clusterX = (I32)(cluster % grid.clusterCount.x) * ClusterSize;
+	I32 clusterY = (I32)(cluster / grid.clusterCount.x) * ClusterSize;
+
+	//The neighbour is either to the right, with the edge running down, or below, with the edge running right
+	bool right = neighbour == cluster + 1;
+	Vector2Int edge = right ? Vector2Int{ clusterX + ClusterSize - 1, clusterY } : Vector2Int{ clusterX, clusterY + ClusterSize - 1 };
+	Vector2Int step = right ? Vector2Int{ 0, 1 } : Vector2Int{ 1, 0 };
+	Vector2Int across = right ? Vector2Int{ 1, 0 } : Vector2Int{ 0, 1 };
+	I32 length = right ? Math::Min(ClusterSize, grid.dimensions.y - clusterY) : Math::Min(ClusterSize, grid.dimensions.x - clusterX);
+
+	auto open = [&](I32 i)
+	{
+		Vector2Int tile = edge + step * i;
+		Vector2Int other = tile + across;
+		return !grid.rows.Solid(tile.x, tile.y) && !grid.rows.Solid(other.x, other.y);
+	};
+
+	auto transition = [&](I32 i)
+	{
+		Vector2Int tile = edge + step * i;
+		U32 a = AddNode(grid, tile, cluster);
+		U32 b = AddNode(grid, tile + across, neighbour);
+		grid.nodes[a].twin = b;
+		grid.nodes[b].twin = a;
+	};
+
+	for (I32 i = 0; i < length;)
+	{
+		if (!open(i)) { ++i; continue; }
+
+		I32 runStart = i;
+		while (i < length && open(i)) { ++i; }
+		I32 runLength = i - runStart;
+
+		if (runLength < EntranceSplit) { transition(runStart + runLength / 2); }
+		else
+		{
+			transition(runStart);
+			transition(i - 1);
+		}
+	}
+}
+
+void Pathfinding::BuildCosts(PathGrid& grid, U32 index, SearchScratch& scratch)
+{
+	PathCluster& cluster = grid.clusters[index];
+	U32 count = (U32)cluster.nodes.Size();
+
+	cluster.costs.Resize(count * count);
+
+	Vector2Int origin = { (I32)(index % grid.clusterCount.x) * ClusterSize, (I32)(index / grid.clusterCount.x) * ClusterSize };
+	I32 rows = Math::Min(ClusterSize, grid.dimensions.y - origin.y);
+
+	bool open = true;
+	for (I32 y = 0; y < rows && open; ++y) { open = (U32)grid.rows.Bits(origin.x, origin.y + y) == 0; }
+
+	//Nothing is in the way of a cluster without solid tiles, so the cost is just the distance
+	if (open)
+	{
+		for (U32 i = 0; i < count; ++i)
+		{
+			const Vector2Int& a = grid.nodes[cluster.nodes[i]].tile;
+			for (U32 j = 0; j < count; ++j)
+			{
+				const Vector2Int& b = grid.nodes[cluster.nodes[j]].tile;
+				cluster.costs[i * count + j] = Octile(b.x - a.x, b.y - a.y);
+			}
+		}
+
+		return;
+	}
+
+	//Costs are symmetric, each search fills its row and column past the diagonal
+	for (U32 i = 0; i < count; ++i)
+	{
+		cluster.costs[i * count + i] = 0.0f;
+		if (i + 1 == count) { break; }
+
+		LocalCosts(grid, index, grid.nodes[cluster.nodes[i]].tile, i + 1, scratch);
+
+		for (U32 j = i + 1; j < count; ++j)
+		{
+			Vector2Int tile = grid.nodes[cluster.nodes[j]].tile - origin;
+			F32 cost = LocalCost(scratch.localCosts[tile.x + tile.y * ClusterSize]);
+			cluster.costs[i * count + j] = cost;
+			cluster.costs[j * count + i] = cost;
+		}
+	}
+}
+
+U32 Pathfinding::AddNode(PathGrid& grid, const Vector2Int& tile, U32 cluster)
+{
+	U32 id;
+	if (grid.freeNode != U32_MAX)
+	{
+		id = grid.freeNode;
+		grid.freeNode = grid.nodes[id].twin;
+	}
+	else
+	{
+		id = (U32)grid.nodes.Size();
+		grid.nodes.Push({});
+	}
+
+	Vector<U32>& nodes = grid.clusters[cluster].nodes;
+	grid.nodes[id] = { tile, cluster, U32_MAX, (U32)nodes.Size() };
+	nodes.Push(id);
+
+	return id;
+}
+
+void Pathfinding::FreeNode(PathGrid& grid, U32 id)
+{
+	PathNode& node = grid.nodes[id];
+	Vector<U32>& nodes = grid.clusters[node.cluster].nodes;
+
+	nodes[node.slot] = nodes.Back();
+	nodes.Pop();
+	if (node.slot < nodes.Size()) { grid.nodes[nodes[node.slot]].slot = node.slot; }
+
+	node.cluster = U32_MAX;
+	node.twin = grid.freeNode;
+	grid.freeNode = id;
+}
+
+void Pathfinding::ReadTiles(PathGrid& grid, const Vector2Int& min, const Vector2Int& max)
+{
+	const TileGrid& tiles = *grid.tiles;
+
+	//Uniform chunks are written a run at a time without reading their tiles
+	for (I32 chunkY = min.y >> TileGrid::ChunkShift; chunkY <= max.y >> TileGrid::ChunkShift; ++chunkY)
+	{
+		for (I32 chunkX = min.x >> TileGrid::ChunkShift; chunkX <= max.x >> TileGrid::ChunkShift; ++chunkX)
+		{
+			I32 startX = Math::Max(chunkX << TileGrid::ChunkShift, min.x);
+			I32 startY = Math::Max(chunkY << TileGrid::ChunkShift, min.y);
+			I32 endX = Math::Min(((chunkX + 1) << TileGrid::ChunkShift) - 1, max.x);
+			I32 endY = Math::Min(((chunkY + 1) << TileGrid::ChunkShift) - 1, max.y);
+
+			TileType type;
+			if (tiles.Uniform(chunkX, chunkY, type))
+			{
+				bool solid = type != TileType::Air;
+				for (I32 y = startY; y <= endY; ++y) { grid.rows.SetRun(startX, y, endX - startX + 1, solid); }
+				for (I32 x = startX; x <= endX; ++x) { grid.columns.SetRun(startY, x, endY - startY + 1, solid); }
+				continue;
+			}
+
+			for (I32 y = startY; y <= endY; ++y)
+			{
+				for (I32 x = startX; x <= endX; ++x)
+				{
+					bool solid = tiles.Get(x, y) != TileType::Air;
+					grid.rows.SetRun(x, y, 1, solid);
+					grid.columns.SetRun(y, x, 1, solid);
+				}
+			}
+		}
+	}
+}
+
+void Pathfinding::MarkCluster(PathGrid& grid, U32 cluster)
+{
+	if (grid.clusters[cluster].dirty) { return; }
+
+	grid.clusters[cluster].dirty = true;
+	grid.dirtyClusters.Push(cluster);
+}
+
+U32 Pathfinding::ClusterOf(const PathGrid& grid, const Vector2Int& tile)
+{
+	return tile.x / ClusterSize + (tile.y / ClusterSize) * grid.clusterCount.x;
+}
+
+U64 Pathfinding::Hash(U32 tile)
+{
+	U64 key = tile;
+	key ^= key >> 16;
+	key *= 0x45d9f3b;
+	key ^= key >> 16;
+
+	return key;
+}
+
+void Pathfinding::BitGrid::Create(I32 width, I32 height)
+{
+	//Everything starts solid, including the padding that's never cleared
+	stride = ((width + 63) >> 6) + 2;
+	words = Vector<U64>((U64)(height + 2) * stride + 1, U64_MAX);
+}
+
+void Pathfinding::BitGrid::SetRun(I32 x, I32 y, I32 count, bool solid)
+{
+	while (count > 0)
+	{
+		U32 bit = (U32)(x + 64);
+		U32 shift = bit & 63;
+		I32 length = Math::Min(count, 64 - (I32)shift);
+		U64 mask = (length == 64 ? U64_MAX : ((1ull << length) - 1)) << shift;
+
+		U64& word = words[(U64)(y + 1) * stride + (bit >> 6)];
+		word = solid ? word | mask : word & ~mask;
+
+		x += length;
+		count -= length;
+	}
+}
\ No newline at end of file
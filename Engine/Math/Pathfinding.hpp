@@ -0,0 +1,224 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Math.hpp"
+
+#include "Containers/Vector.hpp"
+
+class TileGrid;
+
+enum class NH_API PathStatus
+{
+	Pending,
+	Found,
+	NotFound
+};
+
+/// <summary>
+/// Finds paths over the air tiles of tile grids, moving in eight directions without cutting the corners of solid tiles.
+/// Short routes use Jump Point Search over a bitmap of the grid, long routes use HPA*: the grid is split into clusters,
+/// the walkable openings between clusters form a graph that's searched first and then refined into tiles one cluster at a time
+/// </summary>
+class NH_API Pathfinding
+{
+public:
+	static constexpr I32 ClusterSize = 32;				//Tiles along each side of a cluster
+	static constexpr I32 LongRouteDistance = 128;		//Routes spanning more tiles than this on either axis use HPA*
+	static constexpr U32 JumpPointLimit = 2048;			//Jump points a short route may visit before it's handed to HPA* instead
+	static constexpr I32 EntranceSplit = 6;				//Openings at least this wide get a transition at each end instead of one in the middle
+	static constexpr U32 RequestsPerThread = 4;			//Most requests each thread takes per round of Update
+	static constexpr F64 DefaultFrameBudget = 0.002;	//Seconds Update spends on requests each frame
+
+	/// <summary>
+	/// Builds the bitmap and cluster graph of tiles, the grid must stay alive until it's passed to RemoveGrid
+	/// </summary>
+	/// <returns>A stable id for the grid, valid until it's passed to RemoveGrid</returns>
+	static U32 AddGrid(const TileGrid* tiles);
+
+	/// <summary>
+	/// Re-reads the tiles from min to max, inclusive, clusters touching them are repaired before the next search
+	/// </summary>
+	static void UpdateGrid(U32 grid, const Vector2Int& min, const Vector2Int& max);
+	static void RemoveGrid(U32 grid);
+	static bool Walkable(U32 grid, const Vector2Int& tile);
+
+	/// <summary>
+	/// Finds a path right away, path is filled with the start, every turn along the way and the goal,
+	/// consecutive points are always on a straight or diagonal line
+	/// </summary>
+	/// <returns>true if a path was found</returns>
+	static bool FindPath(U32 grid, const Vector2Int& start, const Vector2Int& goal, Vector<Vector2Int>& path);
+
+	/// <summary>
+	/// Queues a path to be found during the following frames, requests are solved in order across the worker threads
+	/// until the frame budget runs out
+	/// </summary>
+	/// <returns>A request id, valid until it's passed to ReleasePath</returns>
+	static U32 RequestPath(U32 grid, const Vector2Int& start, const Vector2Int& goal);
+	static PathStatus Status(U32 request);
+
+	/// <summary>
+	/// The path of a request, empty until its status is Found
+	/// </summary>
+	static const Vector<Vector2Int>& Path(U32 request);
+	static void ReleasePath(U32 request);
+
+	/// <summary>
+	/// Sets how many seconds Update spends on requests each frame, a round that has started always finishes
+	/// </summary>
+	static void SetFrameBudget(F64 seconds);
+	static U32 PendingRequests();
+
+private:
+	static bool Initialize();
+	static void Shutdown();
+
+	static void Update();
+
+	//One bit per tile set if it's solid, rows are padded by a solid word on each side and a solid row above and below,
+	//so 64 tiles starting anywhere from -64 to the width can be read without bounds checks
+	struct BitGrid
+	{
+		Vector<U64> words;
+		I32 stride;			//Words per row
+
+		void Create(I32 width, I32 height);
+		void SetRun(I32 x, I32 y, I32 count, bool solid);
+		bool Solid(I32 x, I32 y) const;
+		U64 Bits(I32 x, I32 y) const;
+	};
+
+	//A tile on the edge of a cluster next to an opening into the neighbouring cluster
+	struct PathNode
+	{
+		Vector2Int tile;
+		U32 cluster;		//U32_MAX while unused
+		U32 twin;			//The node on the other side of the opening, next free node while unused
+		U32 slot;			//Index in its cluster's nodes
+		U32 component;		//Nodes sharing a component can reach each other
+	};
+
+	struct PathCluster
+	{
+		Vector<U32> nodes;
+		Vector<F32> costs;		//Cost between every pair of nodes staying inside the cluster, F32_MAX if there's no way
+		bool dirty;
+	};
+
+	struct PathGrid
+	{
+		const TileGrid* tiles;
+		Vector2Int dimensions;
+		Vector2Int clusterCount;
+		BitGrid rows;
+		BitGrid columns;		//Transposed copy of rows so vertical jumps are scanned the same way as horizontal ones
+		Vector<PathNode> nodes;
+		U32 freeNode;
+		Vector<PathCluster> clusters;
+		Vector<U32> dirtyClusters;
+	};
+
+	struct PathRequest
+	{
+		U32 grid;
+		Vector2Int start;
+		Vector2Int goal;
+		Vector<Vector2Int> path;
+		U32 nextFree;
+		PathStatus status;
+		bool alive;
+	};
+
+	struct JumpRecord
+	{
+		U32 tile;
+		U32 parent;			//Record the tile was reached from, U32_MAX for the start
+		F32 cost;
+		bool closed;
+	};
+
+	struct OpenEntry
+	{
+		F32 score;
+		U32 index;
+	};
+
+	struct RecordSlot
+	{
+		U32 record;
+		U32 stamp;
+	};
+
+	static constexpr U32 LocalBucketCount = 32;		//Power of two past the cost of a diagonal step, so a step never lands in the bucket being expanded
+
+	//Everything a search writes, one per thread so requests can be solved in parallel
+	struct SearchScratch
+	{
+		Vector<JumpRecord> records;
+		Vector<RecordSlot> table;		//Tile to record, slots from older searches have an older stamp
+		Vector<OpenEntry> open;
+		U32 stamp = 0;
+
+		Vector<U16> localCosts;					//Costs within a cluster in twelfths of a tile, U16_MAX if there's no way
+		Vector<U16> buckets[LocalBucketCount];	//Tiles waiting to be expanded, by cost modulo the bucket count
+
+		Vector<F32> nodeCosts;
+		Vector<U32> nodeParents;
+		Vector<U32> nodeStamps;
+		Vector<F32> startCosts;
+		Vector<F32> goalCosts;
+		Vector<U32> route;
+		Vector<Vector2Int> segment;
+		U32 nodeStamp = 0;
+	};
+
+	static bool Search(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, SearchScratch& scratch, Vector<Vector2Int>& path);
+	static bool Reachable(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal);
+	static void FloodCluster(const PathGrid& grid, const Vector2Int& tile, U32* mask);
+	static bool JumpSearch(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, U32 limit, SearchScratch& scratch, Vector<Vector2Int>& path);
+	static bool HierarchicalSearch(const PathGrid& grid, const Vector2Int& start, const Vector2Int& goal, SearchScratch& scratch, Vector<Vector2Int>& path);
+	static bool Jump(const PathGrid& grid, I32 x, I32 y, I32 dx, I32 dy, const Vector2Int& goal, Vector2Int& jumpPoint);
+	static U32 FindRecord(SearchScratch& scratch, U32 tile);
+	static void LocalCosts(const PathGrid& grid, U32 cluster, const Vector2Int& source, U32 firstTarget, SearchScratch& scratch);
+
+	static void Repair(PathGrid& grid);
+	static void RemoveBorder(PathGrid& grid, U32 cluster, U32 neighbour);
+	static void BuildBorder(PathGrid& grid, U32 cluster, U32 neighbour);
+	static void BuildCosts(PathGrid& grid, U32 cluster, SearchScratch& scratch);
+	static void LabelComponents(PathGrid& grid);
+	static U32 AddNode(PathGrid& grid, const Vector2Int& tile, U32 cluster);
+	static void FreeNode(PathGrid& grid, U32 node);
+	static void ReadTiles(PathGrid& grid, const Vector2Int& min, const Vector2Int& max);
+	static void MarkCluster(PathGrid& grid, U32 cluster);
+	static U32 ClusterOf(const PathGrid& grid, const Vector2Int& tile);
+	static U64 Hash(U32 tile);
+
+	static Vector<PathGrid> grids;
+	static Vector<PathRequest> requests;
+	static U32 freeRequest;
+	static Vector<U32> pendingRequests;
+	static U32 nextPending;
+	static Vector<SearchScratch> scratches;
+	static F64 frameBudget;
+	static F64 requestTime;
+
+	STATIC_CLASS(Pathfinding);
+	friend class Engine;
+	friend class Benchmarks;
+};
+
+inline bool Pathfinding::BitGrid::Solid(I32 x, I32 y) const
+{
+	U32 bit = (U32)(x + 64);
+	return (words[(U64)(y + 1) * stride + (bit >> 6)] >> (bit & 63)) & 1;
+}
+
+inline U64 Pathfinding::BitGrid::Bits(I32 x, I32 y) const
+{
+	U32 bit = (U32)(x + 64);
+	const U64* row = words.Data() + (U64)(y + 1) * stride + (bit >> 6);
+	U32 shift = bit & 63;
+
+	return shift ? (row[0] >> shift) | (row[1] << (64 - shift)) : row[0];
+}
\ No newline at end of file
@@ -3,14 +3,57 @@
 #include "Core/Time.hpp"
 #include "Core/Logger.hpp"
 #include "Platform/Memory.hpp"
+#include "Multithreading/Jobs.hpp"
 #include "Resources/Settings.hpp"
 #include "Resources/TilemapComponent.hpp"
 #include "Resources/TilemapColliderComponent.hpp"
 
 #include "tracy/Tracy.hpp"
 
-Vector<AABB> Physics::colliders;
+#if defined(__AVX__) || defined(__AVX2__)
+#	define NH_PHYSICS_AVX
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define NH_PHYSICS_SSE
+#	include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#	define NH_PHYSICS_NEON
+#	include <arm_neon.h>
+#endif
+
+Vector<Physics::ColliderProxy> Physics::colliders;
+U32 Physics::freeCollider = U32_MAX;
+SpatialHash Physics::staticColliders;
+DynamicTree Physics::movingColliders;
+Vector<F32> Physics::colliderMinX;
+Vector<F32> Physics::colliderMinY;
+Vector<F32> Physics::colliderMaxX;
+Vector<F32> Physics::colliderMaxY;
+Vector<U32> Physics::colliderCategories;
 Vector<GridCollider> Physics::tilemapColliders;
+Vector<U8> Physics::bandScratch;
+Vector<TileRect> Physics::bandRects;
+Vector<Physics::Body> Physics::bodies;
+U32 Physics::freeBody = U32_MAX;
+U32 Physics::bodyCount = 0;
+U32 Physics::awakeBodyCount = 0;
+Vector2 Physics::gravity = { 0.0f, -9.8f };
+F32 Physics::accumulator = 0.0f;
+Vector<Physics::Contact> Physics::contacts;
+Vector<Physics::Contact> Physics::previousContacts;
+Vector<Physics::ContactBatch> Physics::contactBatches;
+Vector<U32> Physics::contactStarts;
+Vector<U32> Physics::previousContactStarts;
+Vector<U32> Physics::islandRoots;
+Vector<U32> Physics::islandLookup;
+Vector<Physics::Island> Physics::islands;
+Vector<U32> Physics::islandBodies;
+Vector<U32> Physics::islandContacts;
+PairCache Physics::pairCache;
+Vector<ColliderPair> Physics::pairScratch;
+Vector<ColliderPair> Physics::beginContacts;
+Vector<ColliderPair> Physics::stayContacts;
+Vector<ColliderPair> Physics::endContacts;
 
 I32 AssertFcn(const C8* condition, const C8* fileName, I32 lineNumber)
 {
@@ -25,91 +68,1456 @@ bool Physics::Initialize()
 
 void Physics::Shutdown()
 {
+	colliders.Destroy();
+	freeCollider = U32_MAX;
+	staticColliders.Destroy();
+	movingColliders.Destroy();
+	colliderMinX.Destroy();
+	colliderMinY.Destroy();
+	colliderMaxX.Destroy();
+	colliderMaxY.Destroy();
+	colliderCategories.Destroy();
+	tilemapColliders.Destroy();
+	bandScratch.Destroy();
+	bandRects.Destroy();
+
+	bodies.Destroy();
+	freeBody = U32_MAX;
+	bodyCount = 0;
+	awakeBodyCount = 0;
+	contacts.Destroy();
+	previousContacts.Destroy();
+	contactBatches.Destroy();
+	contactStarts.Destroy();
+	previousContactStarts.Destroy();
+	islandRoots.Destroy();
+	islandLookup.Destroy();
+	islands.Destroy();
+	islandBodies.Destroy();
+	islandContacts.Destroy();
 
+	pairCache.Destroy();
+	pairScratch.Destroy();
+	beginContacts.Destroy();
+	stayContacts.Destroy();
+	endContacts.Destroy();
 }
 
 void Physics::Update()
 {
 	ZoneScopedN("Physics");
+
+	accumulator += (F32)Time::DeltaTime();
+
+	beginContacts.Clear();
+	stayContacts.Clear();
+	endContacts.Clear();
+
+	U32 steps = 0;
+	while (accumulator >= TimeStep && steps < MaxSteps)
+	{
+		Step(TimeStep);
+		UpdateContactEvents();
+		accumulator -= TimeStep;
+		++steps;
+	}
+
+	if (accumulator >= TimeStep) { accumulator = 0.0f; }
+
+	TracyPlot("Awake Bodies", (I64)awakeBodyCount);
+	TracyPlot("Contacts", (I64)contacts.Size());
+	TracyPlot("Contact Pairs", (I64)pairCache.Count());
+}
+
+void Physics::UpdateContactEvents()
+{
+	ZoneScopedN("Physics Contact Events");
+
+	pairScratch.Clear();
+	QueryPairs(pairScratch);
+
+	pairCache.Begin();
+
+	for (const ColliderPair& pair : pairScratch)
+	{
+		if (pairCache.Add(pair.a, pair.b)) { beginContacts.Push(pair); }
+		else { stayContacts.Push(pair); }
+	}
+
+	pairCache.End([](U32 a, U32 b) { endContacts.Push({ a, b }); });
+}
+
+const Vector<ColliderPair>& Physics::BeginContacts()
+{
+	return beginContacts;
+}
+
+const Vector<ColliderPair>& Physics::StayContacts()
+{
+	return stayContacts;
 }
 
-U32 Physics::AddCollider(const AABB& collider)
+const Vector<ColliderPair>& Physics::EndContacts()
 {
-	U32 index = (U32)colliders.Size();
-	colliders.Push(collider);
+	return endContacts;
+}
+
+U32 Physics::AddCollider(const AABB& collider, BodyType type, const CollisionFilter& filter)
+{
+	U32 index;
+	if (freeCollider != U32_MAX)
+	{
+		index = freeCollider;
+		freeCollider = colliders[index].nextFree;
+	}
+	else
+	{
+		index = (U32)colliders.Size();
+		colliders.Push({});
+		colliderMinX.Push(0.0f);
+		colliderMinY.Push(0.0f);
+		colliderMaxX.Push(0.0f);
+		colliderMaxY.Push(0.0f);
+		colliderCategories.Push(0);
+	}
+
+	ColliderProxy& proxy = colliders[index];
+	proxy.bounds = collider;
+	proxy.nextFree = U32_MAX;
+	proxy.body = U32_MAX;
+	proxy.filter = filter;
+	proxy.type = type;
+	proxy.alive = true;
+	SetColliderBounds(index, collider);
+	colliderCategories[index] = filter.category;
+
+	if (type == BodyType::Static) { proxy.handle = staticColliders.Insert(collider, index, filter.category, filter.mask); }
+	else { proxy.handle = movingColliders.Insert(collider, index, filter.category, filter.mask); }
 
 	return index;
 }
 
-U32 Physics::AddTilemapCollider(const ComponentRef<TilemapCollider>& tilemapCollider)
+U32 Physics::AddTilemapCollider(const ComponentRef<TilemapCollider>& tilemapCollider, const CollisionFilter& filter)
 {
-	GridCollider collider{};
+	//Slots of removed grids are reused, the ids handed out before them stay put
+	U32 index = 0;
+	while (index < tilemapColliders.Size() && tilemapColliders[index].tilemap) { ++index; }
+	if (index == tilemapColliders.Size()) { tilemapColliders.Push({}); }
+
+	GridCollider& collider = tilemapColliders[index];
+	collider.filter = filter;
 	collider.dimensions = tilemapCollider->dimensions;
 	collider.tileSize = tilemapCollider->tileSize;
 	collider.offset = tilemapCollider->offset;
-	collider.tileArray = tilemapCollider->tiles;
+	collider.tilemap = tilemapCollider->tilemap;
 
-	U32 index = (U32)tilemapColliders.Size();
-	tilemapColliders.Push(collider);
+	I32 bandCount = (collider.dimensions.y + TileBand::Height - 1) / TileBand::Height;
+	collider.bands.Resize(bandCount, {});
+
+	for (I32 band = 0; band < bandCount; ++band) { BuildBand(collider, band); }
 
 	return index;
 }
 
+void Physics::UpdateCollider(U32 index, const AABB& collider)
+{
+	if (index >= colliders.Size() || !colliders[index].alive) { return; }
+
+	ColliderProxy& proxy = colliders[index];
+
+	if (proxy.type == BodyType::Static) { staticColliders.Update(proxy.handle, collider); }
+	else { movingColliders.Move(proxy.handle, collider, collider.Center() - proxy.bounds.Center()); }
+
+	proxy.bounds = collider;
+	SetColliderBounds(index, collider);
+}
+
+void Physics::SetColliderFilter(U32 index, const CollisionFilter& filter)
+{
+	if (index >= colliders.Size() || !colliders[index].alive) { return; }
+
+	ColliderProxy& proxy = colliders[index];
+	proxy.filter = filter;
+	colliderCategories[index] = filter.category;
+
+	if (proxy.type == BodyType::Static) { staticColliders.SetFilter(proxy.handle, filter.category, filter.mask); }
+	else { movingColliders.SetFilter(proxy.handle, filter.category, filter.mask); }
+}
+
 void Physics::RemoveCollider(U32 index)
 {
+	if (index >= colliders.Size() || !colliders[index].alive) { return; }
+
+	ColliderProxy& proxy = colliders[index];
+
+	if (proxy.type == BodyType::Static) { staticColliders.Remove(proxy.handle); }
+	else { movingColliders.Remove(proxy.handle); }
+
+	proxy.alive = false;
+	proxy.nextFree = freeCollider;
+	freeCollider = index;
+
+	SetColliderBounds(index, { { -F32_MAX, -F32_MAX }, { F32_MAX, F32_MAX } });
+	colliderCategories[index] = 0;
+}
+
+void Physics::SetColliderBounds(U32 index, const AABB& bounds)
+{
+	colliderMinX[index] = bounds.lowerBound.x;
+	colliderMinY[index] = bounds.lowerBound.y;
+	colliderMaxX[index] = bounds.upperBound.x;
+	colliderMaxY[index] = bounds.upperBound.y;
+}
+
+void Physics::UpdateTilemapCollider(U32 index, const Vector2Int& min, const Vector2Int& max)
+{
+	GridCollider& grid = tilemapColliders[index];
+	if (!GridTiles(grid)) { return; }
 
+	I32 first = Math::Max(min.y, 0) / TileBand::Height;
+	I32 last = Math::Min(max.y, grid.dimensions.y - 1) / TileBand::Height;
+
+	for (I32 band = first; band <= last; ++band) { BuildBand(grid, band); }
 }
 
 void Physics::RemoveTilemapCollider(U32 index)
 {
+	//Indices are handed out to components, so the slot stays and is skipped by queries
+	GridCollider& grid = tilemapColliders[index];
+	grid.tilemap = nullptr;
+	grid.bands.Destroy();
+}
+
+const TileGrid* Physics::GridTiles(const GridCollider& grid)
+{
+	//Tiles are looked up through the component each time, a tilemap removed before its collider leaves nothing to hit
+	const Tilemap* tilemap = grid.tilemap.Get();
+	if (!tilemap || tilemap->EntityIndex() == U32_MAX) { return nullptr; }
+
+	return &tilemap->GetTiles();
+}
+
+void Physics::BuildBand(GridCollider& grid, I32 band)
+{
+	static_assert(TileGrid::ChunkSize % TileBand::Height == 0, "Bands must not cross a chunk row");
 
+	I32 width = grid.dimensions.x;
+	I32 top = band * TileBand::Height;
+	I32 height = Math::Min(TileBand::Height, grid.dimensions.y - top);
+
+	const TileGrid& tiles = *GridTiles(grid);
+
+	bandScratch.Resize(width * height, 0);
+
+	auto open = [&](I32 x, I32 y) { return tiles.Get(x, top + y) == TileType::Full && !bandScratch[x + y * width]; };
+
+	//Bands never cross a chunk row, so a chunk of uniform air skips a whole chunk of columns
+	I32 chunkY = top >> TileGrid::ChunkShift;
+
+	//Walking columns first emits rectangles already sorted by minX
+	bandRects.Clear();
+	for (I32 x = 0; x < width; ++x)
+	{
+		TileType uniform;
+		if (!(x & (TileGrid::ChunkSize - 1)) && tiles.Uniform(x >> TileGrid::ChunkShift, chunkY, uniform) && uniform == TileType::Air)
+		{
+			x += TileGrid::ChunkSize - 1;
+			continue;
+		}
+
+		for (I32 y = 0; y < height; ++y)
+		{
+			if (!open(x, y)) { continue; }
+
+			I32 h = 1;
+			while (y + h < height && open(x, y + h)) { ++h; }
+
+			I32 w = 1;
+			for (; x + w < width; ++w)
+			{
+				bool full = true;
+				for (I32 i = 0; i < h && full; ++i) { full = open(x + w, y + i); }
+				if (!full) { break; }
+			}
+
+			for (I32 j = 0; j < h; ++j)
+			{
+				for (I32 i = 0; i < w; ++i) { bandScratch[x + i + (y + j) * width] = 1; }
+			}
+
+			bandRects.Push({ x, top + y, x + w - 1, top + y + h - 1 });
+
+			y += h - 1;
+		}
+	}
+
+	//Copied into every row they cover in order, which keeps each row sorted
+	TileBand& tileBand = grid.bands[band];
+
+	for (I32 y = 0; y <= TileBand::Height; ++y) { tileBand.rowStarts[y] = 0; }
+
+	for (const TileRect& rect : bandRects)
+	{
+		for (I32 y = rect.minY - top; y <= rect.maxY - top; ++y) { ++tileBand.rowStarts[y + 1]; }
+	}
+
+	for (I32 y = 0; y < TileBand::Height; ++y) { tileBand.rowStarts[y + 1] += tileBand.rowStarts[y]; }
+
+	tileBand.rects.Resize(tileBand.rowStarts[TileBand::Height], {});
+
+	U32 cursors[TileBand::Height];
+	for (I32 y = 0; y < TileBand::Height; ++y) { cursors[y] = tileBand.rowStarts[y]; }
+
+	for (const TileRect& rect : bandRects)
+	{
+		for (I32 y = rect.minY - top; y <= rect.maxY - top; ++y) { tileBand.rects[cursors[y]++] = rect; }
+	}
 }
 
+template<class Callback>
+void Physics::QueryGrid(const GridCollider& col, const AABB& bounds, Callback&& callback)
+{
+	const TileGrid* tiles = GridTiles(col);
+	if (!tiles) { return; }
+
+	I32 minX = Math::Max((I32)Math::Floor((bounds.lowerBound.x - col.offset.x) / col.tileSize.x), 0);
+	I32 maxX = Math::Min((I32)Math::Floor((bounds.upperBound.x - col.offset.x) / col.tileSize.x), col.dimensions.x - 1);
+	I32 minY = Math::Max((I32)Math::Floor((col.offset.y - bounds.upperBound.y) / col.tileSize.y), 0);
+	I32 maxY = Math::Min((I32)Math::Ceiling((col.offset.y - bounds.lowerBound.y) / col.tileSize.y), col.dimensions.y - 1);
+
+	if (minX > maxX || minY > maxY) { return; }
+
+	//Most queries are in open air, a window inside chunks that are all air never reads the bands
+	bool open = true;
+	TileType type;
+	for (I32 chunkY = minY >> TileGrid::ChunkShift; open && chunkY <= maxY >> TileGrid::ChunkShift; ++chunkY)
+	{
+		for (I32 chunkX = minX >> TileGrid::ChunkShift; open && chunkX <= maxX >> TileGrid::ChunkShift; ++chunkX)
+		{
+			open = tiles->Uniform(chunkX, chunkY, type) && type == TileType::Air;
+		}
+	}
+
+	if (open) { return; }
+
+	for (I32 y = minY; y <= maxY; ++y)
+	{
+		const TileBand& tileBand = col.bands[y / TileBand::Height];
+		I32 row = y % TileBand::Height;
+
+		//Rectangles in a row don't overlap, so sorting by minX sorts by maxX too
+		U32 lo = tileBand.rowStarts[row];
+		U32 hi = tileBand.rowStarts[row + 1];
+		U32 end = hi;
+		while (lo < hi)
+		{
+			U32 mid = (lo + hi) / 2;
+			if (tileBand.rects[mid].maxX < minX) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+
+		for (U32 i = lo; i < end; ++i)
+		{
+			const TileRect& rect = tileBand.rects[i];
+			if (rect.minX > maxX) { break; }
 
-Collision Physics::CheckCollision(const AABB& collider)
+			//Rectangles covering several rows are only reported from the first row they share with bounds
+			if (y != Math::Max(minY, rect.minY)) { continue; }
+
+			AABB aabb{};
+			aabb.upperBound = { (rect.maxX + 1) * col.tileSize.x + col.offset.x, -rect.minY * col.tileSize.y + col.offset.y + col.tileSize.y };
+			aabb.lowerBound = { rect.minX * col.tileSize.x + col.offset.x, -rect.maxY * col.tileSize.y + col.offset.y };
+
+			if (aabb.Overlaps(bounds) && !callback(rect, aabb)) { return; }
+		}
+	}
+}
+
+bool Physics::CheckGrid(const GridCollider& col, const AABB& collider, AABB& hit)
+{
+	bool found = false;
+
+	QueryGrid(col, collider, [&](const TileRect& rect, const AABB& aabb)
+	{
+		hit = aabb;
+		found = true;
+		return false;
+	});
+
+	return found;
+}
+
+Collision Physics::CheckCollision(const AABB& collider, U32 mask)
 {
-	Vector2 center = collider.lowerBound + (collider.upperBound - collider.lowerBound) * 0.5f;
-	center.y = -center.y;
+	AABB hit;
 
 	for (const GridCollider& col : tilemapColliders)
 	{
-		Vector2 tilemapPosition = (center - Vector2{ col.offset.x, -col.offset.y }) / col.tileSize;
+		if ((col.filter.category & mask) && CheckGrid(col, collider, hit)) { return { hit, true }; }
+	}
+
+	return CheckColliders(collider, mask);
+}
+
+Collision Physics::CheckColliders(const AABB& collider, U32 mask)
+{
+	if (colliders.Size() <= LinearScanLimit)
+	{
+		U32 index = ScanColliders(collider, mask);
+		if (index != U32_MAX) { return { colliders[index].bounds, true }; }
+
+		return { {}, false };
+	}
+
+	//An empty hash still probes every cell the query covers, skipped so maps made only of tiles don't pay for it
+	U32 proxy;
+	if (staticColliders.Count() && staticColliders.QueryAny(collider, proxy, mask)) { return { staticColliders.Bounds(proxy), true }; }
+
+	Collision result{ {}, false };
+	if (!movingColliders.Count()) { return result; }
+
+	movingColliders.Query(collider, [&](U32 proxy)
+	{
+		const AABB& bounds = colliders[movingColliders.UserData(proxy)].bounds;
+		if (!bounds.Overlaps(collider)) { return true; }
 
-		Vector2Int xy = { (I32)Math::Floor(tilemapPosition.x), (I32)Math::Floor(tilemapPosition.y) };
+		result = { bounds, true };
+		return false;
+	}, mask);
 
-		U32 width = (U32)Math::Ceiling((collider.upperBound.x - collider.lowerBound.x) / col.tileSize.x);
-		U32 height = (U32)Math::Ceiling((collider.upperBound.y - collider.lowerBound.y) / col.tileSize.y);
+	return result;
+}
+
+U32 Physics::ScanColliders(const AABB& collider, U32 filter)
+{
+	const F32* minX = colliderMinX.Data();
+	const F32* minY = colliderMinY.Data();
+	const F32* maxX = colliderMaxX.Data();
+	const F32* maxY = colliderMaxY.Data();
+	const U32* categories = colliderCategories.Data();
+
+	U32 count = (U32)colliders.Size();
+	U32 i = 0;
 
-		for (I32 x = (I32)(tilemapPosition.x - width); x < (I32)(tilemapPosition.x + width); ++x)
+#if defined(NH_PHYSICS_AVX)
+	__m256 queryMinX = _mm256_set1_ps(collider.lowerBound.x);
+	__m256 queryMinY = _mm256_set1_ps(collider.lowerBound.y);
+	__m256 queryMaxX = _mm256_set1_ps(collider.upperBound.x);
+	__m256 queryMaxY = _mm256_set1_ps(collider.upperBound.y);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX + i), queryMaxX, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(maxX + i), queryMinX, _CMP_GT_OQ));
+		__m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY + i), queryMaxY, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(maxY + i), queryMinY, _CMP_GT_OQ));
+
+		//Few boxes overlap, so the categories are only read for the ones that do
+		for (U32 mask = (U32)_mm256_movemask_ps(_mm256_and_ps(x, y)); mask; mask &= mask - 1)
 		{
-			for (I32 y = (I32)(tilemapPosition.y - height); y < (I32)(tilemapPosition.y + height); ++y)
-			{
-				//TODO: switch statement with a different check for each type
-				if (x < col.dimensions.x && x >= 0 && y < col.dimensions.y && y >= 0 && col.tileArray[x + y * col.dimensions.x] == TileType::Full)
-				{
-					AABB aabb{};
+			U32 index = i + (U32)std::countr_zero(mask);
+			if (categories[index] & filter) { return index; }
+		}
+	}
+#elif defined(NH_PHYSICS_SSE)
+	__m128 queryMinX = _mm_set1_ps(collider.lowerBound.x);
+	__m128 queryMinY = _mm_set1_ps(collider.lowerBound.y);
+	__m128 queryMaxX = _mm_set1_ps(collider.upperBound.x);
+	__m128 queryMaxY = _mm_set1_ps(collider.upperBound.y);
 
-					aabb.upperBound = { x * col.tileSize.x + col.offset.x + col.tileSize.x, -y * col.tileSize.y + col.offset.y + col.tileSize.y };
-					aabb.lowerBound = { x * col.tileSize.x + col.offset.x, -y * col.tileSize.y + col.offset.y };
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minX + i), queryMaxX), _mm_cmpgt_ps(_mm_loadu_ps(maxX + i), queryMinX));
+		__m128 y = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + i), queryMaxY), _mm_cmpgt_ps(_mm_loadu_ps(maxY + i), queryMinY));
 
-					if (collider.lowerBound.x < aabb.upperBound.x && collider.upperBound.x > aabb.lowerBound.x &&
-						collider.lowerBound.y < aabb.upperBound.y && collider.upperBound.y > aabb.lowerBound.y)
-					{
-						return { aabb, true };
-					}
-				}
+		for (U32 mask = (U32)_mm_movemask_ps(_mm_and_ps(x, y)); mask; mask &= mask - 1)
+		{
+			U32 index = i + (U32)std::countr_zero(mask);
+			if (categories[index] & filter) { return index; }
+		}
+	}
+#elif defined(NH_PHYSICS_NEON)
+	float32x4_t queryMinX = vdupq_n_f32(collider.lowerBound.x);
+	float32x4_t queryMinY = vdupq_n_f32(collider.lowerBound.y);
+	float32x4_t queryMaxX = vdupq_n_f32(collider.upperBound.x);
+	float32x4_t queryMaxY = vdupq_n_f32(collider.upperBound.y);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		uint32x4_t x = vandq_u32(vcltq_f32(vld1q_f32(minX + i), queryMaxX), vcgtq_f32(vld1q_f32(maxX + i), queryMinX));
+		uint32x4_t y = vandq_u32(vcltq_f32(vld1q_f32(minY + i), queryMaxY), vcgtq_f32(vld1q_f32(maxY + i), queryMinY));
+
+		uint32x4_t overlap = vandq_u32(x, y);
+		if (vmaxvq_u32(overlap))
+		{
+			U32 lanes[4];
+			vst1q_u32(lanes, overlap);
+
+			for (U32 lane = 0; lane < 4; ++lane)
+			{
+				if (lanes[lane] && (categories[i + lane] & filter)) { return i + lane; }
 			}
 		}
 	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if ((categories[i] & filter) && minX[i] < collider.upperBound.x && maxX[i] > collider.lowerBound.x &&
+			minY[i] < collider.upperBound.y && maxY[i] > collider.lowerBound.y) { return i; }
+	}
+
+	return U32_MAX;
+}
+
+U32 Physics::QueryColliders(const AABB& bounds, Vector<U32>& hits, U32 mask)
+{
+	U32 count = 0;
+
+	staticColliders.Query(bounds, [&](U32 proxy)
+	{
+		hits.Push(staticColliders.UserData(proxy));
+		++count;
+		return true;
+	}, mask);
+
+	movingColliders.Query(bounds, [&](U32 proxy)
+	{
+		U32 index = movingColliders.UserData(proxy);
+		if (colliders[index].bounds.Overlaps(bounds))
+		{
+			hits.Push(index);
+			++count;
+		}
+
+		return true;
+	}, mask);
+
+	return count;
+}
+
+const AABB& Physics::ColliderBounds(U32 index)
+{
+	return colliders[index].bounds;
+}
+
+U32 Physics::QueryPairs(Vector<ColliderPair>& pairs)
+{
+	ZoneScopedN("Physics Pairs");
+
+	U32 count = 0;
+
+	auto addPair = [&](U32 a, U32 b)
+	{
+		if (!colliders[a].bounds.Overlaps(colliders[b].bounds)) { return; }
+
+		pairs.Push(a < b ? ColliderPair{ a, b } : ColliderPair{ b, a });
+		++count;
+	};
+
+	//The tree and the hash already skipped anything the filters reject
+	movingColliders.QueryPairs([&](U32 proxyA, U32 proxyB)
+	{
+		addPair(movingColliders.UserData(proxyA), movingColliders.UserData(proxyB));
+	});
+
+	for (U32 i = 0; i < colliders.Size(); ++i)
+	{
+		const ColliderProxy& proxy = colliders[i];
+		if (!proxy.alive || proxy.type == BodyType::Static) { continue; }
+
+		staticColliders.Query(proxy.bounds, [&](U32 other)
+		{
+			if (staticColliders.Mask(other) & proxy.filter.category) { addPair(i, staticColliders.UserData(other)); }
+			return true;
+		}, proxy.filter.mask);
+	}
+
+	return count;
+}
+
+void Physics::CheckCollisions(const AABB* queries, U32 count, Collision* results, U32 mask)
+{
+	ZoneScopedN("Physics Batch Query");
+
+	for (U32 i = 0; i < count; ++i) { results[i].valid = false; }
+
+	for (const GridCollider& col : tilemapColliders)
+	{
+		if (!(col.filter.category & mask)) { continue; }
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (!results[i].valid) { results[i].valid = CheckGrid(col, queries[i], results[i].aabb); }
+		}
+	}
+
+	if (!staticColliders.Count() && !movingColliders.Count()) { return; }
+
+	for (U32 i = 0; i < count; ++i)
+	{
+		if (!results[i].valid) { results[i] = CheckColliders(queries[i], mask); }
+	}
+}
+
+bool Physics::CheckTile(const Vector2& point, U32 mask)
+{
+	for (const GridCollider& col : tilemapColliders)
+	{
+		if (!(col.filter.category & mask)) { continue; }
+
+		I32 x = (I32)Math::Floor((point.x - col.offset.x) / col.tileSize.x);
+		I32 y = (I32)Math::Ceiling((col.offset.y - point.y) / col.tileSize.y);
+
+		const TileGrid* tiles = GridTiles(col);
+		if (tiles && tiles->Get(x, y) == TileType::Full) { return true; }
+	}
+
+	return false;
+}
+
+RaycastHit Physics::Raycast(const Vector2& start, const Vector2& end, U32 mask)
+{
+	RaycastHit hit{ end, Vector2::Zero, 1.0f, U32_MAX, U32_MAX, false };
+
+	for (U32 i = 0; i < tilemapColliders.Size(); ++i)
+	{
+		if (tilemapColliders[i].filter.category & mask) { RaycastGrid(tilemapColliders[i], i, start, end, hit); }
+	}
+
+	RaycastColliders(start, end, hit, mask);
+
+	if (hit.valid) { hit.point = start + (end - start) * hit.fraction; }
+
+	return hit;
+}
+
+RaycastHit Physics::ShapeCast(const AABB& shape, const Vector2& displacement, U32 mask)
+{
+	RaycastHit hit{ shape.Center() + displacement, Vector2::Zero, 1.0f, U32_MAX, U32_MAX, false };
+	AABB hitBounds;
+
+	AABB swept = shape.Merged(shape + displacement);
 
-	for (const AABB& col : colliders)
+	auto test = [&](const AABB& target, U32 collider, U32 tilemap)
 	{
-		if (collider.lowerBound.x < col.upperBound.x && collider.upperBound.x > col.lowerBound.x &&
-			collider.lowerBound.y < col.upperBound.y && collider.upperBound.y > col.lowerBound.y)
+		F32 fraction;
+		Vector2 normal;
+		if (target.Sweep(shape, displacement, hit.fraction, fraction, normal) && (!hit.valid || fraction < hit.fraction))
 		{
-			return { col, true };
+			hit = { hit.point, normal, fraction, collider, tilemap, true };
+			hitBounds = target;
 		}
+	};
+
+	for (U32 i = 0; i < tilemapColliders.Size(); ++i)
+	{
+		if (!(tilemapColliders[i].filter.category & mask)) { continue; }
+
+		QueryGrid(tilemapColliders[i], swept, [&](const TileRect& rect, const AABB& aabb)
+		{
+			test(aabb, U32_MAX, i);
+			return true;
+		});
+	}
+
+	staticColliders.Query(swept, [&](U32 proxy)
+	{
+		U32 index = staticColliders.UserData(proxy);
+		test(colliders[index].bounds, index, U32_MAX);
+		return true;
+	}, mask);
+
+	movingColliders.Query(swept, [&](U32 proxy)
+	{
+		U32 index = movingColliders.UserData(proxy);
+		test(colliders[index].bounds, index, U32_MAX);
+		return true;
+	}, mask);
+
+	if (hit.valid)
+	{
+		hit.point = shape.Center() + displacement * hit.fraction;
+
+		//Snapped flush against the face that was hit so the next cast from here starts touching it instead of a rounding error away
+		Vector2 extents = shape.Extents();
+		if (hit.normal.x > 0.0f) { hit.point.x = hitBounds.upperBound.x + extents.x; }
+		else if (hit.normal.x < 0.0f) { hit.point.x = hitBounds.lowerBound.x - extents.x; }
+		if (hit.normal.y > 0.0f) { hit.point.y = hitBounds.upperBound.y + extents.y; }
+		else if (hit.normal.y < 0.0f) { hit.point.y = hitBounds.lowerBound.y - extents.y; }
 	}
 
-	return { {}, false };
+	return hit;
+}
+
+void Physics::Raycasts(const Ray* rays, U32 count, RaycastHit* results, U32 mask)
+{
+	ZoneScopedN("Raycasts");
+
+	Jobs::ParallelFor(count, RayBatchSize, [rays, results, mask](U32 start, U32 end)
+	{
+		for (U32 i = start; i < end; ++i) { results[i] = Raycast(rays[i].start, rays[i].end, mask); }
+	});
+}
+
+void Physics::ShapeCasts(const AABB* shapes, const Vector2* displacements, U32 count, RaycastHit* results, U32 mask)
+{
+	ZoneScopedN("Shape Casts");
+
+	Jobs::ParallelFor(count, RayBatchSize, [shapes, displacements, results, mask](U32 start, U32 end)
+	{
+		for (U32 i = start; i < end; ++i) { results[i] = ShapeCast(shapes[i], displacements[i], mask); }
+	});
+}
+
+void Physics::RaycastGrid(const GridCollider& grid, U32 index, const Vector2& start, const Vector2& end, RaycastHit& hit)
+{
+	const TileGrid* tiles = GridTiles(grid);
+	if (!tiles) { return; }
+
+	//Tile space, x runs right and y runs down one unit per tile
+	F32 u = (start.x - grid.offset.x) / grid.tileSize.x;
+	F32 v = (grid.offset.y + grid.tileSize.y - start.y) / grid.tileSize.y;
+	F32 du = (end.x - start.x) / grid.tileSize.x;
+	F32 dv = (start.y - end.y) / grid.tileSize.y;
+
+	//Clip the ray to the grid so rays starting outside of it begin at its edge
+	AABB bounds{ { (F32)grid.dimensions.x, (F32)grid.dimensions.y }, Vector2::Zero };
+	F32 t;
+	Vector2 entry;
+	if (!bounds.RayCast({ u, v }, { du, dv }, hit.fraction, t, entry)) { return; }
+
+	I32 width = grid.dimensions.x;
+	I32 x = Math::Clamp((I32)Math::Floor(u + du * t), 0, width - 1);
+	I32 y = Math::Clamp((I32)Math::Floor(v + dv * t), 0, grid.dimensions.y - 1);
+
+	I32 stepX = du > 0.0f ? 1 : -1;
+	I32 stepY = dv > 0.0f ? 1 : -1;
+	F32 deltaX = du != 0.0f ? Math::Abs(1.0f / du) : F32_MAX;
+	F32 deltaY = dv != 0.0f ? Math::Abs(1.0f / dv) : F32_MAX;
+	F32 nextX = du != 0.0f ? (x + (stepX > 0 ? 1 : 0) - u) / du : F32_MAX;
+	F32 nextY = dv != 0.0f ? (y + (stepY > 0 ? 1 : 0) - v) / dv : F32_MAX;
+
+	//Tile space y is flipped, so is the normal
+	Vector2 normal = { entry.x, -entry.y };
+
+	while (true)
+	{
+		if (tiles->Get(x, y) == TileType::Full)
+		{
+			hit = { start, normal, t, U32_MAX, index, true };
+			return;
+		}
+
+		if (nextX < nextY)
+		{
+			t = nextX;
+			x += stepX;
+			nextX += deltaX;
+			normal = { (F32)-stepX, 0.0f };
+
+			if (x < 0 || x >= width) { return; }
+		}
+		else
+		{
+			t = nextY;
+			y += stepY;
+			nextY += deltaY;
+			normal = { 0.0f, (F32)stepY };
+
+			if (y < 0 || y >= grid.dimensions.y) { return; }
+		}
+
+		if (t > hit.fraction) { return; }
+	}
+}
+
+void Physics::RaycastColliders(const Vector2& start, const Vector2& end, RaycastHit& hit, U32 mask)
+{
+	if (hit.fraction == 0.0f) { return; }
+
+	Vector2 delta = end - start;
+
+	//Returns the closest hit so far, which shrinks the broadphase's ray as hits are found
+	auto test = [&](U32 index)
+	{
+		F32 fraction;
+		Vector2 normal;
+		if (colliders[index].bounds.RayCast(start, delta, hit.fraction, fraction, normal) && (!hit.valid || fraction < hit.fraction))
+		{
+			hit = { start, normal, fraction, index, U32_MAX, true };
+		}
+
+		return hit.fraction;
+	};
+
+	if (colliders.Size() <= LinearScanLimit)
+	{
+		for (U32 i = 0; i < colliders.Size(); ++i)
+		{
+			if (colliders[i].alive && (colliders[i].filter.category & mask) && test(i) == 0.0f) { return; }
+		}
+
+		return;
+	}
+
+	//The broadphases only walk as far as the closest hit so far, their fractions are relative to that
+	F32 scale = hit.fraction;
+	staticColliders.RayCast(start, start + delta * scale, [&](U32 proxy, F32)
+	{
+		return test(staticColliders.UserData(proxy)) / scale;
+	}, mask);
+
+	scale = hit.fraction;
+	if (scale == 0.0f) { return; }
+
+	movingColliders.RayCast(start, start + delta * scale, [&](U32 proxy, F32)
+	{
+		return test(movingColliders.UserData(proxy)) / scale;
+	}, mask);
+}
+
+U32 Physics::CreateBody(const BodyInfo& info)
+{
+	U32 index;
+	if (freeBody != U32_MAX)
+	{
+		index = freeBody;
+		freeBody = bodies[index].nextFree;
+	}
+	else
+	{
+		index = (U32)bodies.Size();
+		bodies.Push({});
+	}
+
+	Body& body = bodies[index];
+	body.position = info.position;
+	body.velocity = info.type == BodyType::Static ? Vector2::Zero : info.velocity;
+	body.correction = Vector2::Zero;
+	body.force = Vector2::Zero;
+	body.halfExtents = info.halfExtents;
+	body.radius = info.radius;
+	body.friction = info.friction;
+	body.restitution = info.restitution;
+	body.gravityScale = info.gravityScale;
+	body.sleepTime = 0.0f;
+	body.nextFree = U32_MAX;
+	body.type = info.type;
+	body.shape = info.shape;
+	body.awake = true;
+	body.alive = true;
+
+	F32 area = info.shape == ShapeType::Box ? 4.0f * info.halfExtents.x * info.halfExtents.y : (F32)Pi * info.radius * info.radius;
+	F32 mass = info.density * area;
+	body.inverseMass = info.type == BodyType::Dynamic ? 1.0f / (mass > 0.0f ? mass : 1.0f) : 0.0f;
+
+	body.collider = AddCollider(BodyBounds(body), info.type, info.filter);
+	colliders[body.collider].body = index;
+
+	++bodyCount;
+
+	return index;
+}
+
+void Physics::DestroyBody(U32 index)
+{
+	if (index >= bodies.Size() || !bodies[index].alive) { return; }
+
+	//Anything resting on the body has to notice it's gone
+	for (const Contact& contact : contacts)
+	{
+		if (contact.bodyA == index && contact.bodyB != U32_MAX) { WakeBody(contact.bodyB); }
+		else if (contact.bodyB == index) { WakeBody(contact.bodyA); }
+	}
+
+	Body& body = bodies[index];
+	RemoveCollider(body.collider);
+
+	body.alive = false;
+	body.awake = false;
+	body.nextFree = freeBody;
+	freeBody = index;
+
+	--bodyCount;
+}
+
+const Vector2& Physics::BodyPosition(U32 body)
+{
+	return bodies[body].position;
+}
+
+const Vector2& Physics::BodyVelocity(U32 body)
+{
+	return bodies[body].velocity;
+}
+
+void Physics::SetBodyPosition(U32 index, const Vector2& position)
+{
+	Body& body = bodies[index];
+	body.position = position;
+	UpdateCollider(body.collider, BodyBounds(body));
+
+	WakeBody(index);
+}
+
+void Physics::SetBodyVelocity(U32 index, const Vector2& velocity)
+{
+	Body& body = bodies[index];
+	if (body.type == BodyType::Static) { return; }
+
+	body.velocity = velocity;
+	WakeBody(index);
+}
+
+void Physics::ApplyImpulse(U32 index, const Vector2& impulse)
+{
+	Body& body = bodies[index];
+	body.velocity += impulse * body.inverseMass;
+	WakeBody(index);
+}
+
+void Physics::ApplyForce(U32 index, const Vector2& force)
+{
+	Body& body = bodies[index];
+	body.force += force;
+	WakeBody(index);
+}
+
+bool Physics::BodyAwake(U32 body)
+{
+	return bodies[body].awake;
+}
+
+void Physics::WakeBody(U32 index)
+{
+	Body& body = bodies[index];
+	if (!body.alive || body.type != BodyType::Dynamic) { return; }
+
+	body.awake = true;
+	body.sleepTime = 0.0f;
+}
+
+void Physics::SetGravity(const Vector2& value)
+{
+	gravity = value;
+}
+
+U32 Physics::BodyCount()
+{
+	return bodyCount;
+}
+
+U32 Physics::AwakeBodyCount()
+{
+	return awakeBodyCount;
+}
+
+AABB Physics::BodyBounds(const Body& body)
+{
+	Vector2 extents = body.shape == ShapeType::Box ? body.halfExtents : Vector2{ body.radius, body.radius };
+	return { body.position + extents, body.position - extents };
+}
+
+void Physics::Step(F32 dt)
+{
+	ZoneScopedN("Physics Step");
+
+	if (!bodyCount) { return; }
+
+	Jobs::ParallelFor((U32)bodies.Size(), BodyBatchSize, [dt](U32 start, U32 end)
+	{
+		for (U32 i = start; i < end; ++i)
+		{
+			Body& body = bodies[i];
+			if (!body.alive || body.type != BodyType::Dynamic || !body.awake) { continue; }
+
+			body.velocity += (gravity * body.gravityScale + body.force * body.inverseMass) * dt;
+			body.force = Vector2::Zero;
+		}
+	});
+
+	FindContacts(dt);
+	BuildIslands();
+
+	{
+		ZoneScopedN("Physics Solve");
+
+		//Islands share no dynamic bodies, so they can be solved in any order on any thread
+		Jobs::ParallelFor((U32)islands.Size(), IslandBatchSize, [dt](U32 start, U32 end)
+		{
+			for (U32 i = start; i < end; ++i) { SolveIsland(islands[i], dt); }
+		});
+	}
+
+	//The broadphase is only touched once every island is done
+	for (U32 index : islandBodies)
+	{
+		Body& body = bodies[index];
+		UpdateCollider(body.collider, BodyBounds(body));
+	}
+
+	awakeBodyCount = 0;
+	for (Body& body : bodies)
+	{
+		if (!body.alive) { continue; }
+
+		if (body.type == BodyType::Kinematic && (body.velocity.x != 0.0f || body.velocity.y != 0.0f))
+		{
+			body.position += body.velocity * dt;
+			UpdateCollider(body.collider, BodyBounds(body));
+		}
+
+		if (body.type == BodyType::Dynamic && body.awake) { ++awakeBodyCount; }
+	}
+}
+
+void Physics::FindContacts(F32 dt)
+{
+	ZoneScopedN("Physics Contacts");
+
+	Swap(contacts, previousContacts);
+	Swap(contactStarts, previousContactStarts);
+	contactStarts.Resize(bodies.Size() + 1, 0);
+
+	//Batches are a fixed size so contacts come out in the same order no matter how many threads there are
+	U32 batchCount = (U32)((bodies.Size() + BodyBatchSize - 1) / BodyBatchSize);
+	if (contactBatches.Size() < batchCount)
+	{
+		//Batches already there keep their buffers, only the new ones are constructed
+		U64 oldSize = contactBatches.Size();
+		contactBatches.Resize(batchCount);
+
+		for (U64 i = oldSize; i < batchCount; ++i) { Construct(contactBatches.Data() + i); }
+	}
+
+	Jobs::ParallelFor(batchCount, 1, [dt](U32 start, U32 end)
+	{
+		for (U32 batch = start; batch < end; ++batch) { FindContacts(contactBatches[batch], batch * BodyBatchSize, dt); }
+	});
+
+	//Sleeping bodies that got touched are only woken now, so no batch saw another batch's wakes
+	U32 count = 0;
+	for (U32 batch = 0; batch < batchCount; ++batch)
+	{
+		ContactBatch& contactBatch = contactBatches[batch];
+		contactBatch.start = count;
+		count += (U32)contactBatch.contacts.Size();
+
+		for (U32 body : contactBatch.wakes) { WakeBody(body); }
+	}
+
+	contacts.Resize(count);
+
+	Jobs::ParallelFor(batchCount, 1, [](U32 start, U32 end)
+	{
+		for (U32 batch = start; batch < end; ++batch)
+		{
+			const ContactBatch& contactBatch = contactBatches[batch];
+			CopyData(contacts.Data() + contactBatch.start, contactBatch.contacts.Data(), contactBatch.contacts.Size());
+
+			U32 last = Math::Min((batch + 1) * BodyBatchSize, (U32)bodies.Size());
+			for (U32 i = batch * BodyBatchSize; i < last; ++i) { contactStarts[i] += contactBatch.start; }
+		}
+	});
+
+	contactStarts[bodies.Size()] = count;
+}
+
+void Physics::FindContacts(ContactBatch& batch, U32 first, F32 dt)
+{
+	batch.contacts.Clear();
+	batch.wakes.Clear();
+
+	U32 last = Math::Min(first + BodyBatchSize, (U32)bodies.Size());
+
+	for (U32 i = first; i < last; ++i)
+	{
+		contactStarts[i] = (U32)batch.contacts.Size();
+
+		const Body& body = bodies[i];
+		if (!body.alive || body.type != BodyType::Dynamic || !body.awake) { continue; }
+
+		AABB bounds = BodyBounds(body).Expanded(Skin);
+		const CollisionFilter& filter = colliders[body.collider].filter;
+		Vector2 normal;
+		F32 penetration;
+
+		//Colliders without a body and static bodies don't move
+		auto collideStatic = [&](U32 collider)
+		{
+			const ColliderProxy& proxy = colliders[collider];
+			if (!(proxy.filter.mask & filter.category) || !proxy.bounds.Overlaps(bounds)) { return; }
+
+			bool collided;
+			if (proxy.body != U32_MAX)
+			{
+				const Body& other = bodies[proxy.body];
+				collided = Collide(body, other.position, other.halfExtents, other.radius, other.shape, normal, penetration);
+			}
+			else { collided = Collide(body, proxy.bounds.Center(), proxy.bounds.Extents(), 0.0f, ShapeType::Box, normal, penetration); }
+
+			if (collided) { AddContact(batch.contacts, i, U32_MAX, ((U64)i << 32) | 0x80000000 | collider, normal, penetration, body.friction, body.restitution, dt); }
+		};
+
+		//The broadphases skip anything not in the body's mask, the other side of the filter is checked per collider
+
+		movingColliders.Query(bounds, [&](U32 proxy)
+		{
+			U32 collider = movingColliders.UserData(proxy);
+			U32 j = colliders[collider].body;
+
+			if (j == U32_MAX) { collideStatic(collider); return true; }
+			if (j == i || !(colliders[collider].filter.mask & filter.category)) { return true; }
+
+			const Body& other = bodies[j];
+
+			//Pairs of awake bodies are found by the lower index, pairs with a sleeping body are found by the awake one
+			bool sleeping = other.type == BodyType::Dynamic && !other.awake;
+			if (other.type == BodyType::Dynamic && other.awake && j < i) { return true; }
+
+			if (Collide(body, other.position, other.halfExtents, other.radius, other.shape, normal, penetration))
+			{
+				//A sleeping body holds still like a static one this step, it has no contacts of its own to push back with,
+				//and it's only woken by a body moving into it so a body resting against it can fall asleep too
+				if (sleeping && body.velocity.SqrMagnitude() > SleepVelocity * SleepVelocity) { batch.wakes.Push(j); }
+
+				U64 key = i < j ? ((U64)i << 32) | j : ((U64)j << 32) | i;
+				AddContact(batch.contacts, i, sleeping ? U32_MAX : j, key, normal, penetration, Math::Sqrt(body.friction * other.friction), Math::Max(body.restitution, other.restitution), dt);
+			}
+
+			return true;
+		}, filter.mask);
+
+		staticColliders.Query(bounds, [&](U32 proxy)
+		{
+			collideStatic(staticColliders.UserData(proxy));
+			return true;
+		}, filter.mask);
+
+		for (U32 g = 0; g < tilemapColliders.Size(); ++g)
+		{
+			const CollisionFilter& gridFilter = tilemapColliders[g].filter;
+			if (!(gridFilter.category & filter.mask) || !(gridFilter.mask & filter.category)) { continue; }
+
+			QueryGrid(tilemapColliders[g], bounds, [&](const TileRect& rect, const AABB& aabb)
+			{
+				if (Collide(body, aabb.Center(), aabb.Extents(), 0.0f, ShapeType::Box, normal, penetration))
+				{
+					U32 feature = (g * 73856093u) ^ ((U32)rect.minX * 19349663u) ^ ((U32)rect.minY * 83492791u);
+					AddContact(batch.contacts, i, U32_MAX, ((U64)i << 32) | 0xC0000000 | (feature & 0x3FFFFFFF), normal, penetration, body.friction, body.restitution, dt);
+				}
+
+				return true;
+			});
+		}
+	}
+}
+
+void Physics::AddContact(Vector<Contact>& output, U32 bodyA, U32 bodyB, U64 key, const Vector2& normal, F32 penetration, F32 friction, F32 restitution, F32 dt)
+{
+	const Body& a = bodies[bodyA];
+	Vector2 velocityB = bodyB != U32_MAX ? bodies[bodyB].velocity : Vector2::Zero;
+	F32 inverseMassB = bodyB != U32_MAX ? bodies[bodyB].inverseMass : 0.0f;
+
+	Contact& contact = output.Push({});
+	contact.key = key;
+	contact.bodyA = bodyA;
+	contact.bodyB = bodyB;
+	contact.normal = normal;
+	contact.penetration = penetration;
+	contact.friction = friction;
+	contact.restitution = restitution;
+	contact.mass = 1.0f / (a.inverseMass + inverseMassB);
+	contact.normalImpulse = 0.0f;
+	contact.tangentImpulse = 0.0f;
+	contact.correctionImpulse = 0.0f;
+
+	//Only bounce off of fast impacts, resting contacts would jitter otherwise, shapes more than Slop apart may close the gap this step, closer ones already rest on each other
+	F32 normalVelocity = (velocityB - a.velocity).Dot(normal);
+	if (normalVelocity < -1.0f && restitution > 0.0f) { contact.velocityBias = -restitution * normalVelocity; }
+	else { contact.velocityBias = Math::Min(penetration + Slop, 0.0f) / dt; }
+
+	//Warm start from the same pair last step
+	if (bodyA + 1 < previousContactStarts.Size())
+	{
+		for (U32 i = previousContactStarts[bodyA]; i < previousContactStarts[bodyA + 1]; ++i)
+		{
+			const Contact& previous = previousContacts[i];
+			if (previous.key == key)
+			{
+				contact.normalImpulse = previous.normalImpulse;
+				contact.tangentImpulse = previous.tangentImpulse;
+				break;
+			}
+		}
+	}
+}
+
+bool Physics::Collide(const Body& a, const Vector2& positionB, const Vector2& halfExtentsB, F32 radiusB, ShapeType shapeB, Vector2& normal, F32& penetration)
+{
+	if (a.shape == ShapeType::Box && shapeB == ShapeType::Box)
+	{
+		Vector2 offset = positionB - a.position;
+		F32 overlapX = a.halfExtents.x + halfExtentsB.x - Math::Abs(offset.x);
+		F32 overlapY = a.halfExtents.y + halfExtentsB.y - Math::Abs(offset.y);
+
+		//Boxes apart along one axis within Skin are facing each other, apart along both only share a corner
+		if (overlapX <= -Skin || overlapY <= -Skin || (overlapX <= 0.0f && overlapY <= 0.0f)) { return false; }
+
+		if (overlapX < overlapY)
+		{
+			normal = { offset.x < 0.0f ? -1.0f : 1.0f, 0.0f };
+			penetration = overlapX;
+		}
+		else
+		{
+			normal = { 0.0f, offset.y < 0.0f ? -1.0f : 1.0f };
+			penetration = overlapY;
+		}
+
+		return true;
+	}
+
+	if (a.shape == ShapeType::Circle && shapeB == ShapeType::Circle)
+	{
+		Vector2 offset = positionB - a.position;
+		F32 radii = a.radius + radiusB;
+		F32 distanceSq = offset.SqrMagnitude();
+		if (distanceSq >= (radii + Skin) * (radii + Skin)) { return false; }
+
+		F32 distance = Math::Sqrt(distanceSq);
+		normal = distance > 0.0001f ? offset / distance : Vector2{ 0.0f, 1.0f };
+		penetration = radii - distance;
+
+		return true;
+	}
+
+	//Circle against box is worked out from the box's side, then flipped if the circle is A
+	bool circleA = a.shape == ShapeType::Circle;
+	Vector2 center = circleA ? a.position : positionB;
+	F32 radius = circleA ? a.radius : radiusB;
+	Vector2 boxCenter = circleA ? positionB : a.position;
+	Vector2 extents = circleA ? halfExtentsB : a.halfExtents;
+
+	Vector2 local = center - boxCenter;
+	Vector2 toCircle;
+
+	if (Math::Abs(local.x) < extents.x && Math::Abs(local.y) < extents.y)
+	{
+		F32 depthX = extents.x - Math::Abs(local.x);
+		F32 depthY = extents.y - Math::Abs(local.y);
+
+		if (depthX < depthY)
+		{
+			toCircle = { local.x < 0.0f ? -1.0f : 1.0f, 0.0f };
+			penetration = depthX + radius;
+		}
+		else
+		{
+			toCircle = { 0.0f, local.y < 0.0f ? -1.0f : 1.0f };
+			penetration = depthY + radius;
+		}
+	}
+	else
+	{
+		Vector2 closest = { Math::Clamp(local.x, -extents.x, extents.x), Math::Clamp(local.y, -extents.y, extents.y) };
+		Vector2 offset = local - closest;
+		F32 distanceSq = offset.SqrMagnitude();
+		if (distanceSq >= (radius + Skin) * (radius + Skin)) { return false; }
+
+		F32 distance = Math::Sqrt(distanceSq);
+		toCircle = distance > 0.0001f ? offset / distance : Vector2{ 0.0f, 1.0f };
+		penetration = radius - distance;
+	}
+
+	normal = circleA ? -toCircle : toCircle;
+
+	return true;
+}
+
+U32 Physics::FindRoot(U32 body)
+{
+	while (islandRoots[body] != body)
+	{
+		islandRoots[body] = islandRoots[islandRoots[body]];
+		body = islandRoots[body];
+	}
+
+	return body;
+}
+
+void Physics::BuildIslands()
+{
+	ZoneScopedN("Physics Islands");
+
+	islandRoots.Resize(bodies.Size(), 0);
+	islandLookup.Resize(bodies.Size(), U32_MAX);
+	for (U32 i = 0; i < bodies.Size(); ++i) { islandRoots[i] = i; }
+
+	//Static and kinematic bodies don't carry impulses, so they don't join islands
+	for (const Contact& contact : contacts)
+	{
+		if (contact.bodyB == U32_MAX || bodies[contact.bodyB].type != BodyType::Dynamic) { continue; }
+
+		U32 rootA = FindRoot(contact.bodyA);
+		U32 rootB = FindRoot(contact.bodyB);
+		if (rootA != rootB) { islandRoots[Math::Max(rootA, rootB)] = Math::Min(rootA, rootB); }
+	}
+
+	islands.Clear();
+
+	for (U32 i = 0; i < bodies.Size(); ++i)
+	{
+		const Body& body = bodies[i];
+		if (!body.alive || body.type != BodyType::Dynamic || !body.awake) { continue; }
+
+		U32 root = FindRoot(i);
+		if (islandLookup[root] == U32_MAX)
+		{
+			islandLookup[root] = (U32)islands.Size();
+			islands.Push({ 0, 0, 0, 0 });
+		}
+
+		++islands[islandLookup[root]].bodyCount;
+	}
+
+	for (const Contact& contact : contacts) { ++islands[islandLookup[FindRoot(contact.bodyA)]].contactCount; }
+
+	U32 bodyTotal = 0;
+	U32 contactTotal = 0;
+	for (Island& island : islands)
+	{
+		island.bodyStart = bodyTotal;
+		island.contactStart = contactTotal;
+		bodyTotal += island.bodyCount;
+		contactTotal += island.contactCount;
+		island.bodyCount = 0;
+		island.contactCount = 0;
+	}
+
+	islandBodies.Resize(bodyTotal, 0);
+	islandContacts.Resize(contactTotal, 0);
+
+	for (U32 i = 0; i < bodies.Size(); ++i)
+	{
+		const Body& body = bodies[i];
+		if (!body.alive || body.type != BodyType::Dynamic || !body.awake) { continue; }
+
+		Island& island = islands[islandLookup[FindRoot(i)]];
+		islandBodies[island.bodyStart + island.bodyCount++] = i;
+	}
+
+	for (U32 i = 0; i < contacts.Size(); ++i)
+	{
+		Island& island = islands[islandLookup[FindRoot(contacts[i].bodyA)]];
+		islandContacts[island.contactStart + island.contactCount++] = i;
+	}
+}
+
+void Physics::SolveIsland(const Island& island, F32 dt)
+{
+	F32 inverseDt = 1.0f / dt;
+	const U32* islandContact = islandContacts.Data() + island.contactStart;
+	const U32* islandBody = islandBodies.Data() + island.bodyStart;
+
+	for (U32 i = 0; i < island.contactCount; ++i)
+	{
+		const Contact& contact = contacts[islandContact[i]];
+		Vector2 tangent = { -contact.normal.y, contact.normal.x };
+		Vector2 impulse = contact.normal * contact.normalImpulse + tangent * contact.tangentImpulse;
+
+		Body& a = bodies[contact.bodyA];
+		a.velocity -= impulse * a.inverseMass;
+
+		if (contact.bodyB != U32_MAX && bodies[contact.bodyB].type == BodyType::Dynamic)
+		{
+			Body& b = bodies[contact.bodyB];
+			b.velocity += impulse * b.inverseMass;
+		}
+	}
+
+	for (U32 iteration = 0; iteration < VelocityIterations; ++iteration)
+	{
+		for (U32 i = 0; i < island.contactCount; ++i)
+		{
+			Contact& contact = contacts[islandContact[i]];
+			Body& a = bodies[contact.bodyA];
+			Vector2 tangent = { -contact.normal.y, contact.normal.x };
+
+			//Kinematic and static bodies are shared between islands, they're only ever read
+			Body* b = nullptr;
+			Vector2 velocityB = Vector2::Zero;
+			if (contact.bodyB != U32_MAX)
+			{
+				Body& other = bodies[contact.bodyB];
+				if (other.type == BodyType::Dynamic) { b = &other; }
+				else { velocityB = other.velocity; }
+			}
+
+			//Friction first so it's bounded by the normal impulse of the last iteration
+			Vector2 relative = (b ? b->velocity : velocityB) - a.velocity;
+			F32 maxFriction = contact.friction * contact.normalImpulse;
+			F32 tangentImpulse = Math::Clamp(contact.tangentImpulse - contact.mass * relative.Dot(tangent), -maxFriction, maxFriction);
+			Vector2 impulse = tangent * (tangentImpulse - contact.tangentImpulse);
+			contact.tangentImpulse = tangentImpulse;
+
+			a.velocity -= impulse * a.inverseMass;
+			if (b) { b->velocity += impulse * b->inverseMass; }
+
+			relative = (b ? b->velocity : velocityB) - a.velocity;
+			F32 normalImpulse = Math::Max(contact.normalImpulse + contact.mass * (contact.velocityBias - relative.Dot(contact.normal)), 0.0f);
+			impulse = contact.normal * (normalImpulse - contact.normalImpulse);
+			contact.normalImpulse = normalImpulse;
+
+			a.velocity -= impulse * a.inverseMass;
+			if (b) { b->velocity += impulse * b->inverseMass; }
+		}
+	}
+
+	//Overlaps are pushed apart with a separate velocity that's dropped after this step, folding it into the real velocity
+	//would launch bodies out of deep overlaps and keep tall piles bouncing forever
+	for (U32 iteration = 0; iteration < PositionIterations; ++iteration)
+	{
+		for (U32 i = 0; i < island.contactCount; ++i)
+		{
+			Contact& contact = contacts[islandContact[i]];
+			Body& a = bodies[contact.bodyA];
+
+			Body* b = nullptr;
+			if (contact.bodyB != U32_MAX && bodies[contact.bodyB].type == BodyType::Dynamic) { b = &bodies[contact.bodyB]; }
+
+			Vector2 relative = (b ? b->correction : Vector2::Zero) - a.correction;
+			F32 target = Baumgarte * inverseDt * Math::Max(contact.penetration - Slop, 0.0f);
+			F32 correctionImpulse = Math::Max(contact.correctionImpulse + contact.mass * (target - relative.Dot(contact.normal)), 0.0f);
+			Vector2 impulse = contact.normal * (correctionImpulse - contact.correctionImpulse);
+			contact.correctionImpulse = correctionImpulse;
+
+			a.correction -= impulse * a.inverseMass;
+			if (b) { b->correction += impulse * b->inverseMass; }
+		}
+	}
+
+	F32 minSleepTime = F32_MAX;
+
+	for (U32 i = 0; i < island.bodyCount; ++i)
+	{
+		Body& body = bodies[islandBody[i]];
+		body.position += (body.velocity + body.correction) * dt;
+		body.correction = Vector2::Zero;
+
+		if (body.velocity.SqrMagnitude() > SleepVelocity * SleepVelocity) { body.sleepTime = 0.0f; }
+		else { body.sleepTime += dt; }
+
+		minSleepTime = Math::Min(minSleepTime, body.sleepTime);
+	}
+
+	if (minSleepTime >= TimeToSleep)
+	{
+		for (U32 i = 0; i < island.bodyCount; ++i)
+		{
+			Body& body = bodies[islandBody[i]];
+			body.awake = false;
+			body.velocity = Vector2::Zero;
+			body.force = Vector2::Zero;
+		}
+	}
 }
\ No newline at end of file
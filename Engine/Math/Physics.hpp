@@ -3,6 +3,10 @@
 #include "Defines.hpp"
 
 #include "Math.hpp"
+#include "AABB.hpp"
+#include "SpatialHash.hpp"
+#include "DynamicTree.hpp"
+#include "PairCache.hpp"
 
 #include "Resources/Component.hpp"
 #include "Containers/Vector.hpp"
@@ -14,24 +18,73 @@ enum class NH_API BodyType
 	Dynamic = 2
 };
 
-struct NH_API AABB
+enum class NH_API ShapeType
 {
-	Vector2 upperBound;
-	Vector2 lowerBound;
-
-	AABB operator+(const Vector2& v) const { return { upperBound + v, lowerBound + v }; }
-	AABB operator-(const Vector2& v) const { return { upperBound - v, lowerBound - v }; }
+	Box,
+	Circle
 };
 
-enum class TileType;
+class TileGrid;
+class Tilemap;
 class TilemapCollider;
 
+/// <summary>
+/// Layers a collider is on and layers it collides with, two colliders only collide if each one's category is in the other's mask
+/// </summary>
+struct NH_API CollisionFilter
+{
+	U32 category = 1;
+	U32 mask = U32_MAX;
+};
+
+/// <summary>
+/// Description of a rigid body, bodies don't rotate so boxes stay axis aligned
+/// </summary>
+struct NH_API BodyInfo
+{
+	BodyType type = BodyType::Dynamic;
+	ShapeType shape = ShapeType::Box;
+	Vector2 position = Vector2::Zero;
+	Vector2 velocity = Vector2::Zero;
+	Vector2 halfExtents = { 0.5f, 0.5f };		//Boxes only
+	F32 radius = 0.5f;							//Circles only
+	F32 density = 1.0f;
+	F32 friction = 0.4f;
+	F32 restitution = 0.0f;
+	F32 gravityScale = 1.0f;
+	CollisionFilter filter;
+};
+
+struct NH_API TileRect
+{
+	I32 minX;
+	I32 minY;
+	I32 maxX;		//Inclusive
+	I32 maxY;		//Inclusive
+};
+
+/// <summary>
+/// Merged rectangles of Height tile rows, every row holds a copy of the rectangles covering it so a query only reads the rows it touches
+/// </summary>
+struct NH_API TileBand
+{
+	static constexpr I32 Height = 16;
+
+	Vector<TileRect> rects;				//Each row sorted by minX
+	U32 rowStarts[Height + 1]{};		//Where each row starts in rects
+};
+
+/// <summary>
+/// Solid tiles are greedily merged into rectangles, rectangles never cross a band so an edit only rebuilds its band
+/// </summary>
 struct NH_API GridCollider
 {
 	Vector2Int dimensions;
 	Vector2 tileSize;
 	Vector2 offset;
-	const TileType* tileArray;
+	ComponentRef<Tilemap> tilemap;
+	Vector<TileBand> bands;
+	CollisionFilter filter;
 };
 
 //struct NH_API Collider
@@ -50,27 +103,283 @@ struct NH_API Collision
 	operator bool() const { return valid; }
 };
 
+struct NH_API Ray
+{
+	Vector2 start;
+	Vector2 end;
+};
+
+struct NH_API RaycastHit
+{
+	Vector2 point;
+	Vector2 normal;			//Zero if the cast started inside what it hit
+	F32 fraction;			//How far along the cast the hit is, from 0 to 1
+	U32 collider;			//U32_MAX if a tilemap was hit
+	U32 tilemap;			//U32_MAX if a collider was hit
+	bool valid;
+
+	operator bool() const { return valid; }
+};
+
+struct NH_API ColliderPair
+{
+	U32 a;
+	U32 b;
+};
+
 class NH_API Physics
 {
 public:
-	static U32 AddCollider(const AABB& collider);
-	static U32 AddTilemapCollider(const ComponentRef<TilemapCollider>& tilemapCollider);
+	/// <summary>
+	/// Static colliders go in a spatial hash, kinematic and dynamic ones in a bounding volume tree that's cheap to move through
+	/// </summary>
+	/// <returns>A stable id for the collider, valid until it's passed to RemoveCollider</returns>
+	static U32 AddCollider(const AABB& collider, BodyType type = BodyType::Static, const CollisionFilter& filter = {});
+	static U32 AddTilemapCollider(const ComponentRef<TilemapCollider>& tilemapCollider, const CollisionFilter& filter = {});
+	static void UpdateCollider(U32 index, const AABB& collider);
+	static void SetColliderFilter(U32 index, const CollisionFilter& filter);
+
+	/// <summary>
+	/// Rebuilds the merged rectangles of every band touching the tiles from min to max, inclusive
+	/// </summary>
+	static void UpdateTilemapCollider(U32 index, const Vector2Int& min, const Vector2Int& max);
 	static void RemoveCollider(U32 index);
 	static void RemoveTilemapCollider(U32 index);
 
-	static Collision CheckCollision(const AABB& collider);
+	/// <summary>
+	/// Queries only test tilemaps and colliders with a category in mask, everything else is skipped before any bounds are compared
+	/// </summary>
+	static Collision CheckCollision(const AABB& collider, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Appends the id of every collider overlapping bounds to hits, tilemaps aren't included
+	/// </summary>
+	/// <returns>The amount of colliders found</returns>
+	static U32 QueryColliders(const AABB& bounds, Vector<U32>& hits, U32 mask = AllCategories);
+	static const AABB& ColliderBounds(U32 index);
+
+	/// <summary>
+	/// Appends every overlapping pair of colliders where at least one of the two isn't static and their filters accept each other,
+	/// a is always less than b
+	/// </summary>
+	/// <returns>The amount of pairs found</returns>
+	static U32 QueryPairs(Vector<ColliderPair>& pairs);
+
+	/// <summary>
+	/// Pairs from QueryPairs that started touching, kept touching or stopped touching during the last update, in step order,
+	/// these are rebuilt every update so read them all at once instead of per object, ended pairs can hold colliders removed since
+	/// </summary>
+	static const Vector<ColliderPair>& BeginContacts();
+	static const Vector<ColliderPair>& StayContacts();
+	static const Vector<ColliderPair>& EndContacts();
+
+	/// <summary>
+	/// Tests count colliders at once, each grid is walked once for the whole batch instead of once per query,
+	/// while there are few colliders they're scanned directly several boxes per instruction instead of going through the broadphase
+	/// </summary>
+	static void CheckCollisions(const AABB* queries, U32 count, Collision* results, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Checks if point is inside of a solid tile, only tilemap colliders are tested
+	/// </summary>
+	static bool CheckTile(const Vector2& point, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Finds the first tile or collider the segment from start to end hits, tilemaps are walked tile by tile
+	/// </summary>
+	static RaycastHit Raycast(const Vector2& start, const Vector2& end, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Finds the first tile or collider shape hits while moving by displacement, the hit point is where shape's center stops,
+	/// flush against the face that was hit, see AABB::Sweep for shapes that start touching or inside something
+	/// </summary>
+	static RaycastHit ShapeCast(const AABB& shape, const Vector2& displacement, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Casts count rays spread across the worker threads, results[i] is the hit of rays[i]
+	/// </summary>
+	static void Raycasts(const Ray* rays, U32 count, RaycastHit* results, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Casts count shapes spread across the worker threads, results[i] is the hit of shapes[i] moving by displacements[i]
+	/// </summary>
+	static void ShapeCasts(const AABB* shapes, const Vector2* displacements, U32 count, RaycastHit* results, U32 mask = AllCategories);
+
+	/// <summary>
+	/// Creates a rigid body with a collider of its own, dynamic bodies collide with other bodies, colliders and tilemaps
+	/// </summary>
+	/// <returns>A stable id for the body, valid until it's passed to DestroyBody</returns>
+	static U32 CreateBody(const BodyInfo& info);
+	static void DestroyBody(U32 body);
+
+	static const Vector2& BodyPosition(U32 body);
+	static const Vector2& BodyVelocity(U32 body);
+	static void SetBodyPosition(U32 body, const Vector2& position);
+	static void SetBodyVelocity(U32 body, const Vector2& velocity);
+	static void ApplyImpulse(U32 body, const Vector2& impulse);
+	static void ApplyForce(U32 body, const Vector2& force);
+	static bool BodyAwake(U32 body);
+	static void WakeBody(U32 body);
+
+	static void SetGravity(const Vector2& gravity);
+	static U32 BodyCount();
+	static U32 AwakeBodyCount();
+
+	static constexpr U32 DefaultCategory = 1;
+	static constexpr U32 AllCategories = U32_MAX;
+
+	static constexpr F32 TimeStep = 1.0f / 60.0f;
+	static constexpr U32 MaxSteps = 4;				//Steps taken in one frame at most, the rest of a long frame is dropped
+	static constexpr U32 VelocityIterations = 8;
+	static constexpr U32 PositionIterations = 3;
+	static constexpr F32 TimeToSleep = 0.5f;		//Seconds an island has to stay still before it sleeps
+	static constexpr F32 SleepVelocity = 0.05f;
 
 private:
 	static bool Initialize();
 	static void Shutdown();
 
 	static void Update();
+	static void Step(F32 dt);
+	static void UpdateContactEvents();
+
+	static bool CheckGrid(const GridCollider& grid, const AABB& collider, AABB& hit);
+	static void RaycastGrid(const GridCollider& grid, U32 index, const Vector2& start, const Vector2& end, RaycastHit& hit);
+	static void RaycastColliders(const Vector2& start, const Vector2& end, RaycastHit& hit, U32 mask);
+	static void BuildBand(GridCollider& grid, I32 band);
+	static const TileGrid* GridTiles(const GridCollider& grid);
+	static Collision CheckColliders(const AABB& collider, U32 mask);
+	static U32 ScanColliders(const AABB& collider, U32 mask);
+	static void SetColliderBounds(U32 index, const AABB& bounds);
 
-	static Vector<AABB> colliders;
+	static constexpr U32 LinearScanLimit = 64;		//Below this many colliders a vectorized scan beats the broadphase, see the ColliderScan benchmark
+	static constexpr F32 Slop = 0.01f;				//Penetration left alone so resting contacts persist
+	static constexpr F32 Skin = 0.02f;				//Gap under which shapes already get a contact, so a resting body can't lose its support for a step
+	static constexpr F32 Baumgarte = 0.2f;			//Fraction of penetration resolved each step
+	static constexpr U32 BodyBatchSize = 64;		//Bodies per job, fixed so results don't depend on the thread count
+	static constexpr U32 IslandBatchSize = 4;
+	static constexpr U32 RayBatchSize = 64;
+
+	struct ColliderProxy
+	{
+		AABB bounds;
+		U32 handle;			//Id in staticColliders or movingColliders
+		U32 nextFree;
+		U32 body;			//Body owning this collider, U32_MAX if none
+		CollisionFilter filter;
+		BodyType type;
+		bool alive;
+	};
+
+	struct Body
+	{
+		Vector2 position;
+		Vector2 velocity;
+		Vector2 correction;	//Velocity that only pushes out of overlaps, moves the body for one step and is never kept
+		Vector2 force;
+		Vector2 halfExtents;
+		F32 radius;
+		F32 inverseMass;
+		F32 friction;
+		F32 restitution;
+		F32 gravityScale;
+		F32 sleepTime;
+		U32 collider;
+		U32 nextFree;
+		BodyType type;
+		ShapeType shape;
+		bool awake;
+		bool alive;
+	};
+
+	//Contacts have no point, without rotation the impulse along the normal is all that matters
+	struct Contact
+	{
+		U64 key;			//Identifies the pair across steps for warm starting
+		U32 bodyA;			//Always dynamic
+		U32 bodyB;			//U32_MAX for colliders, tiles and sleeping bodies
+		Vector2 normal;		//From A to B
+		F32 penetration;	//Negative for shapes less than Skin apart
+		F32 friction;
+		F32 restitution;
+		F32 mass;
+		F32 velocityBias;
+		F32 normalImpulse;
+		F32 tangentImpulse;
+		F32 correctionImpulse;
+	};
+
+	//Contacts found by one batch of bodies, merged in batch order once every batch is done
+	struct ContactBatch
+	{
+		Vector<Contact> contacts;
+		Vector<U32> wakes;			//Sleeping bodies touched by the batch
+		U32 start;					//Where the batch's contacts go in contacts
+	};
+
+	struct Island
+	{
+		U32 bodyStart;
+		U32 bodyCount;
+		U32 contactStart;
+		U32 contactCount;
+	};
+
+	static AABB BodyBounds(const Body& body);
+	static void FindContacts(F32 dt);
+	static void FindContacts(ContactBatch& batch, U32 first, F32 dt);
+	static void AddContact(Vector<Contact>& output, U32 bodyA, U32 bodyB, U64 key, const Vector2& normal, F32 penetration, F32 friction, F32 restitution, F32 dt);
+	static bool Collide(const Body& a, const Vector2& positionB, const Vector2& halfExtentsB, F32 radiusB, ShapeType shapeB, Vector2& normal, F32& penetration);
+	static void BuildIslands();
+	static void SolveIsland(const Island& island, F32 dt);
+	static U32 FindRoot(U32 body);
+
+	template<class Callback>
+	static void QueryGrid(const GridCollider& grid, const AABB& bounds, Callback&& callback);
+
+	static Vector<ColliderProxy> colliders;
+	static U32 freeCollider;
+	static SpatialHash staticColliders;
+	static DynamicTree movingColliders;
+
+	//Collider bounds mirrored as a struct of arrays for ScanColliders, removed colliders hold inverted bounds that never overlap
+	static Vector<F32> colliderMinX;
+	static Vector<F32> colliderMinY;
+	static Vector<F32> colliderMaxX;
+	static Vector<F32> colliderMaxY;
+	static Vector<U32> colliderCategories;
 	static Vector<GridCollider> tilemapColliders;
+	static Vector<U8> bandScratch;
+	static Vector<TileRect> bandRects;
+
+	static Vector<Body> bodies;
+	static U32 freeBody;
+	static U32 bodyCount;
+	static U32 awakeBodyCount;
+	static Vector2 gravity;
+	static F32 accumulator;
+
+	static Vector<Contact> contacts;
+	static Vector<Contact> previousContacts;
+	static Vector<ContactBatch> contactBatches;
+	static Vector<U32> contactStarts;			//Where each body's contacts start in contacts, indexed by bodyA
+	static Vector<U32> previousContactStarts;
+
+	static Vector<U32> islandRoots;				//Union find over dynamic bodies touching each other
+	static Vector<U32> islandLookup;			//Island of each root
+	static Vector<Island> islands;
+	static Vector<U32> islandBodies;
+	static Vector<U32> islandContacts;
+
+	static PairCache pairCache;
+	static Vector<ColliderPair> pairScratch;
+	static Vector<ColliderPair> beginContacts;
+	static Vector<ColliderPair> stayContacts;
+	static Vector<ColliderPair> endContacts;
 
 	STATIC_CLASS(Physics);
 
 	friend class Engine;
 	friend class RigidBody;
+	friend class Benchmarks;
 };
\ No newline at end of file
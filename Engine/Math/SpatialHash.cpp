@@ -0,0 +1,280 @@
+#include "SpatialHash.hpp"
+
+SpatialHash::SpatialHash(F32 cellSize) : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {}
+
+SpatialHash::~SpatialHash()
+{
+	Destroy();
+}
+
+void SpatialHash::Destroy()
+{
+	proxies.Destroy();
+	entries.Destroy();
+	cells.Destroy();
+
+	freeProxy = U32_MAX;
+	freeEntry = U32_MAX;
+	proxyCount = 0;
+	usedCells = 0;
+}
+
+void SpatialHash::SetCellSize(F32 size)
+{
+	for (U32 i = 0; i < proxies.Size(); ++i) { if (proxies[i].alive) { Unlink(i); } }
+
+	cellSize = size;
+	inverseCellSize = 1.0f / size;
+
+	for (Cell& cell : cells) { cell.used = false; }
+	usedCells = 0;
+
+	for (U32 i = 0; i < proxies.Size(); ++i) { if (proxies[i].alive) { Link(i); } }
+}
+
+U32 SpatialHash::Insert(const AABB& bounds, U32 userData, U32 category, U32 mask)
+{
+	U32 id;
+	if (freeProxy != U32_MAX)
+	{
+		id = freeProxy;
+		freeProxy = proxies[id].nextFree;
+	}
+	else
+	{
+		id = (U32)proxies.Size();
+		proxies.Push({});
+	}
+
+	Proxy& proxy = proxies[id];
+	proxy.bounds = bounds;
+	proxy.userData = userData;
+	proxy.category = category;
+	proxy.mask = mask;
+	proxy.nextFree = U32_MAX;
+	proxy.alive = true;
+
+	Link(id);
+	++proxyCount;
+
+	return id;
+}
+
+void SpatialHash::Remove(U32 id)
+{
+	if (!Valid(id)) { return; }
+
+	Unlink(id);
+
+	Proxy& proxy = proxies[id];
+	proxy.alive = false;
+	proxy.nextFree = freeProxy;
+	freeProxy = id;
+	--proxyCount;
+}
+
+void SpatialHash::Update(U32 id, const AABB& bounds)
+{
+	if (!Valid(id)) { return; }
+
+	Proxy& proxy = proxies[id];
+
+	//Moves that stay within the same cells don't touch the cell lists
+	if (CellCoord(bounds.lowerBound.x) == proxy.minX && CellCoord(bounds.lowerBound.y) == proxy.minY &&
+		CellCoord(bounds.upperBound.x) == proxy.maxX && CellCoord(bounds.upperBound.y) == proxy.maxY)
+	{
+		proxy.bounds = bounds;
+		return;
+	}
+
+	Unlink(id);
+	proxies[id].bounds = bounds;
+	Link(id);
+}
+
+void SpatialHash::SetFilter(U32 id, U32 category, U32 mask)
+{
+	if (!Valid(id)) { return; }
+
+	Unlink(id);
+	proxies[id].category = category;
+	proxies[id].mask = mask;
+	Link(id);
+}
+
+bool SpatialHash::Valid(U32 proxy) const
+{
+	return proxy < proxies.Size() && proxies[proxy].alive;
+}
+
+const AABB& SpatialHash::Bounds(U32 proxy) const
+{
+	return proxies[proxy].bounds;
+}
+
+U32 SpatialHash::UserData(U32 proxy) const
+{
+	return proxies[proxy].userData;
+}
+
+U32 SpatialHash::Category(U32 proxy) const
+{
+	return proxies[proxy].category;
+}
+
+U32 SpatialHash::Mask(U32 proxy) const
+{
+	return proxies[proxy].mask;
+}
+
+U32 SpatialHash::Count() const
+{
+	return proxyCount;
+}
+
+bool SpatialHash::QueryAny(const AABB& bounds, U32& proxy, U32 mask) const
+{
+	bool found = false;
+
+	Query(bounds, [&](U32 id)
+	{
+		proxy = id;
+		found = true;
+		return false;
+	}, mask);
+
+	return found;
+}
+
+U32 SpatialHash::QueryAll(const AABB& bounds, Vector<U32>& results, U32 mask) const
+{
+	U32 count = 0;
+
+	Query(bounds, [&](U32 id)
+	{
+		results.Push(id);
+		++count;
+		return true;
+	}, mask);
+
+	return count;
+}
+
+U32 SpatialHash::FindOrAddCell(I32 x, I32 y)
+{
+	if ((usedCells + 1) * 2 > cells.Size()) { GrowCells(); }
+
+	U64 mask = cells.Size() - 1;
+	for (U64 i = HashCell(x, y) & mask;; i = (i + 1) & mask)
+	{
+		Cell& cell = cells[i];
+		if (cell.used && cell.x == x && cell.y == y) { return (U32)i; }
+
+		if (!cell.used)
+		{
+			cell = { x, y, U32_MAX, true };
+			++usedCells;
+			return (U32)i;
+		}
+	}
+}
+
+void SpatialHash::RemoveCell(U32 index)
+{
+	U64 mask = cells.Size() - 1;
+	U64 hole = index;
+
+	//Backward shift deletion, later cells of the probe run move into the hole unless that would put them before their home slot
+	for (U64 i = (hole + 1) & mask; cells[i].used; i = (i + 1) & mask)
+	{
+		U64 home = HashCell(cells[i].x, cells[i].y) & mask;
+
+		if (((i - home) & mask) >= ((i - hole) & mask))
+		{
+			cells[hole] = cells[i];
+			hole = i;
+		}
+	}
+
+	cells[hole] = { 0, 0, U32_MAX, false };
+	--usedCells;
+}
+
+void SpatialHash::GrowCells()
+{
+	Vector<Cell> old = Move(cells);
+
+	U64 capacity = old.Size() ? old.Size() * 2 : 256;
+	cells = Vector<Cell>(capacity, Cell{ 0, 0, U32_MAX, false });
+	usedCells = 0;
+
+	U64 mask = capacity - 1;
+	for (const Cell& cell : old)
+	{
+		if (!cell.used) { continue; }
+
+		U64 i = HashCell(cell.x, cell.y) & mask;
+		while (cells[i].used) { i = (i + 1) & mask; }
+
+		cells[i] = cell;
+		++usedCells;
+	}
+}
+
+void SpatialHash::Link(U32 id)
+{
+	Proxy& proxy = proxies[id];
+	proxy.minX = CellCoord(proxy.bounds.lowerBound.x);
+	proxy.minY = CellCoord(proxy.bounds.lowerBound.y);
+	proxy.maxX = CellCoord(proxy.bounds.upperBound.x);
+	proxy.maxY = CellCoord(proxy.bounds.upperBound.y);
+
+	for (I32 y = proxy.minY; y <= proxy.maxY; ++y)
+	{
+		for (I32 x = proxy.minX; x <= proxy.maxX; ++x)
+		{
+			U32 e;
+			if (freeEntry != U32_MAX)
+			{
+				e = freeEntry;
+				freeEntry = entries[e].next;
+			}
+			else
+			{
+				e = (U32)entries.Size();
+				entries.Push({});
+			}
+
+			U32 cell = FindOrAddCell(x, y);
+			entries[e] = { id, cells[cell].head, proxy.category };
+			cells[cell].head = e;
+		}
+	}
+}
+
+void SpatialHash::Unlink(U32 id)
+{
+	const Proxy& proxy = proxies[id];
+
+	for (I32 y = proxy.minY; y <= proxy.maxY; ++y)
+	{
+		for (I32 x = proxy.minX; x <= proxy.maxX; ++x)
+		{
+			U32 cell = FindCell(x, y);
+			if (cell == U32_MAX) { continue; }
+
+			U32* link = &cells[cell].head;
+			while (*link != U32_MAX && entries[*link].proxy != id) { link = &entries[*link].next; }
+
+			if (*link != U32_MAX)
+			{
+				U32 e = *link;
+				*link = entries[e].next;
+				entries[e].next = freeEntry;
+				freeEntry = e;
+
+				if (cells[cell].head == U32_MAX) { RemoveCell(cell); }
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "AABB.hpp"
+
+#include "Containers/Vector.hpp"
+
+/// <summary>
+/// Uniform grid broadphase, cells are allocated on demand in an open addressed table and dropped once empty so the world can be unbounded,
+/// every proxy is linked into each cell its bounds touch and queries only visit the cells covered by the query bounds
+/// </summary>
+class NH_API SpatialHash
+{
+public:
+	SpatialHash(F32 cellSize = 4.0f);
+	~SpatialHash();
+	void Destroy();
+
+	/// <summary>
+	/// Changes the cell size, every proxy is re-inserted
+	/// </summary>
+	void SetCellSize(F32 cellSize);
+
+	/// <summary>
+	/// category holds the layers the proxy is on, mask the layers it collides with
+	/// </summary>
+	/// <returns>A proxy id that stays valid until it's removed</returns>
+	U32 Insert(const AABB& bounds, U32 userData = 0, U32 category = 1, U32 mask = U32_MAX);
+	void Remove(U32 proxy);
+	void Update(U32 proxy, const AABB& bounds);
+	void SetFilter(U32 proxy, U32 category, U32 mask);
+
+	bool Valid(U32 proxy) const;
+	const AABB& Bounds(U32 proxy) const;
+	U32 UserData(U32 proxy) const;
+	U32 Category(U32 proxy) const;
+	U32 Mask(U32 proxy) const;
+	U32 Count() const;
+
+	/// <summary>
+	/// Calls callback(proxy) once for every proxy on a layer in mask overlapping bounds, return false from callback to stop early
+	/// </summary>
+	template<class Callback>
+	void Query(const AABB& bounds, Callback&& callback, U32 mask = U32_MAX) const;
+
+	/// <summary>
+	/// Walks the cells the segment from start to end passes through, calling callback(proxy, maxFraction) for every proxy in them,
+	/// proxies spanning several cells can be reported more than once, callback returns the new max fraction like DynamicTree::RayCast
+	/// </summary>
+	template<class Callback>
+	void RayCast(const Vector2& start, const Vector2& end, Callback&& callback, U32 mask = U32_MAX) const;
+
+	/// <returns>true if any proxy on a layer in mask overlaps bounds, the first one found is written to proxy</returns>
+	bool QueryAny(const AABB& bounds, U32& proxy, U32 mask = U32_MAX) const;
+
+	/// <summary>
+	/// Appends every proxy on a layer in mask overlapping bounds to proxies
+	/// </summary>
+	/// <returns>The amount of proxies found</returns>
+	U32 QueryAll(const AABB& bounds, Vector<U32>& proxies, U32 mask = U32_MAX) const;
+
+private:
+	struct Proxy
+	{
+		AABB bounds;
+		I32 minX, minY;
+		I32 maxX, maxY;
+		U32 userData;
+		U32 category;
+		U32 mask;
+		U32 nextFree;
+		bool alive;
+	};
+
+	//The category is copied here so filtered out proxies are skipped without touching them
+	struct Entry
+	{
+		U32 proxy;
+		U32 next;
+		U32 category;
+	};
+
+	struct Cell
+	{
+		I32 x, y;
+		U32 head;
+		bool used;
+	};
+
+	I32 CellCoord(F32 value) const;
+	U32 FindCell(I32 x, I32 y) const;
+	U32 FindOrAddCell(I32 x, I32 y);
+	void RemoveCell(U32 cell);
+	void GrowCells();
+	void Link(U32 proxy);
+	void Unlink(U32 proxy);
+
+	static U64 HashCell(I32 x, I32 y);
+
+	F32 cellSize;
+	F32 inverseCellSize;
+
+	Vector<Proxy> proxies;
+	U32 freeProxy = U32_MAX;
+	U32 proxyCount = 0;
+
+	Vector<Entry> entries;
+	U32 freeEntry = U32_MAX;
+
+	Vector<Cell> cells;
+	U32 usedCells = 0;
+
+	friend class Benchmarks;
+};
+
+inline I32 SpatialHash::CellCoord(F32 value) const
+{
+	return (I32)Math::Floor(value * inverseCellSize);
+}
+
+inline U64 SpatialHash::HashCell(I32 x, I32 y)
+{
+	U64 key = ((U64)(U32)x << 32) | (U32)y;
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+
+	return key;
+}
+
+inline U32 SpatialHash::FindCell(I32 x, I32 y) const
+{
+	if (cells.Empty()) { return U32_MAX; }
+
+	U64 mask = cells.Size() - 1;
+	for (U64 i = HashCell(x, y) & mask;; i = (i + 1) & mask)
+	{
+		const Cell& cell = cells[i];
+		if (!cell.used) { return U32_MAX; }
+		if (cell.x == x && cell.y == y) { return (U32)i; }
+	}
+}
+
+template<class Callback>
+inline void SpatialHash::Query(const AABB& bounds, Callback&& callback, U32 mask) const
+{
+	I32 minX = CellCoord(bounds.lowerBound.x);
+	I32 minY = CellCoord(bounds.lowerBound.y);
+	I32 maxX = CellCoord(bounds.upperBound.x);
+	I32 maxY = CellCoord(bounds.upperBound.y);
+
+	//Queries spanning more cells than exist are cheaper as a scan over every proxy
+	if ((U64)(maxX - minX + 1) * (U64)(maxY - minY + 1) > usedCells)
+	{
+		for (U32 i = 0; i < proxies.Size(); ++i)
+		{
+			const Proxy& proxy = proxies[i];
+			if (proxy.alive && (proxy.category & mask) && proxy.bounds.Overlaps(bounds) && !callback(i)) { return; }
+		}
+
+		return;
+	}
+
+	for (I32 y = minY; y <= maxY; ++y)
+	{
+		for (I32 x = minX; x <= maxX; ++x)
+		{
+			U32 cell = FindCell(x, y);
+			if (cell == U32_MAX) { continue; }
+
+			for (U32 e = cells[cell].head; e != U32_MAX; e = entries[e].next)
+			{
+				if (!(entries[e].category & mask)) { continue; }
+
+				U32 id = entries[e].proxy;
+				const Proxy& proxy = proxies[id];
+
+				//A proxy spanning several cells is only reported from the first cell it shares with the query
+				if (x != Math::Max(minX, proxy.minX) || y != Math::Max(minY, proxy.minY)) { continue; }
+
+				if (proxy.bounds.Overlaps(bounds) && !callback(id)) { return; }
+			}
+		}
+	}
+}
+
+template<class Callback>
+inline void SpatialHash::RayCast(const Vector2& start, const Vector2& end, Callback&& callback, U32 mask) const
+{
+	if (!proxyCount) { return; }
+
+	Vector2 ray = end - start;
+	F32 maxFraction = 1.0f;
+
+	auto report = [&](U32 id)
+	{
+		F32 fraction = callback(id, maxFraction);
+		if (fraction > 0.0f && fraction < maxFraction) { maxFraction = fraction; }
+
+		return fraction != 0.0f;
+	};
+
+	I32 x = CellCoord(start.x);
+	I32 y = CellCoord(start.y);
+
+	//Rays crossing more cells than exist are cheaper as a scan over every proxy
+	if ((U64)Math::Abs(CellCoord(end.x) - x) + (U64)Math::Abs(CellCoord(end.y) - y) + 1 > usedCells)
+	{
+		for (U32 i = 0; i < proxies.Size(); ++i)
+		{
+			if (proxies[i].alive && (proxies[i].category & mask) && !report(i)) { return; }
+		}
+
+		return;
+	}
+
+	//Amanatides-Woo traversal, next is the fraction along the ray where the next cell boundary on each axis is crossed
+	I32 stepX = ray.x > 0.0f ? 1 : -1;
+	I32 stepY = ray.y > 0.0f ? 1 : -1;
+	F32 deltaX = ray.x != 0.0f ? Math::Abs(cellSize / ray.x) : F32_MAX;
+	F32 deltaY = ray.y != 0.0f ? Math::Abs(cellSize / ray.y) : F32_MAX;
+	F32 nextX = ray.x != 0.0f ? ((x + (stepX > 0 ? 1 : 0)) * cellSize - start.x) / ray.x : F32_MAX;
+	F32 nextY = ray.y != 0.0f ? ((y + (stepY > 0 ? 1 : 0)) * cellSize - start.y) / ray.y : F32_MAX;
+
+	while (true)
+	{
+		U32 cell = FindCell(x, y);
+		if (cell != U32_MAX)
+		{
+			for (U32 e = cells[cell].head; e != U32_MAX; e = entries[e].next)
+			{
+				if ((entries[e].category & mask) && !report(entries[e].proxy)) { return; }
+			}
+		}
+
+		if (nextX < nextY)
+		{
+			if (nextX > maxFraction) { return; }
+			x += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			if (nextY > maxFraction) { return; }
+			y += stepY;
+			nextY += deltaY;
+		}
+	}
+}
\ No newline at end of file
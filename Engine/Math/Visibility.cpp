@@ -0,0 +1,443 @@
+#include "Visibility.hpp"
+
+#include "Multithreading/Jobs.hpp"
+#include "Resources/TileGrid.hpp"
+
+#include "tracy/Tracy.hpp"
+
+//floor(numerator / denominator) for a positive denominator
+static I32 FloorDivide(I32 numerator, I32 denominator)
+{
+	return numerator >= 0 ? numerator / denominator : -((denominator - 1 - numerator) / denominator);
+}
+
+static I32 SquareRoot(I32 value)
+{
+	I32 root = (I32)Math::Sqrt((F32)value);
+	while (root * root > value) { --root; }
+	while ((root + 1) * (root + 1) <= value) { ++root; }
+
+	return root;
+}
+
+//64 bits of a line starting at bit first, anything before or after the line reads as set
+static U64 ReadBits(const U64* line, U32 words, I32 first)
+{
+	I32 word = first >> 6;
+	U32 shift = (U32)first & 63;
+
+	U64 low = word >= 0 && word < (I32)words ? line[word] : ~0ull;
+	if (!shift) { return low; }
+
+	U64 high = word + 1 >= 0 && word + 1 < (I32)words ? line[word + 1] : ~0ull;
+	return (low >> shift) | (high << (64 - shift));
+}
+
+//Sets bits first to last of a line, inclusive
+static void SetBits(U64* line, I32 first, I32 last)
+{
+	I32 firstWord = first >> 6;
+	I32 lastWord = last >> 6;
+
+	for (I32 word = firstWord; word <= lastWord; ++word)
+	{
+		U64 mask = ~0ull;
+		if (word == firstWord) { mask &= ~0ull << (first & 63); }
+		if (word == lastWord) { mask &= ~0ull >> (63 - (last & 63)); }
+
+		line[word] |= mask;
+	}
+}
+
+Visibility::Visibility() : tiles(nullptr), dimensions(Vector2Int::Zero), stride(0), columnStride(0), freeViewer(U32_MAX), changed(false) {}
+
+Visibility::~Visibility()
+{
+	Destroy();
+}
+
+void Visibility::Destroy()
+{
+	opaque.Destroy();
+	opaqueColumns.Destroy();
+	visible.Destroy();
+	viewers.Destroy();
+	dirtyViewers.Destroy();
+
+	tiles = nullptr;
+	dimensions = Vector2Int::Zero;
+	stride = 0;
+	columnStride = 0;
+	freeViewer = U32_MAX;
+	changed = false;
+}
+
+void Visibility::Create(const TileGrid* grid)
+{
+	Destroy();
+
+	tiles = grid;
+	dimensions = grid->Dimensions();
+	stride = (U32)(dimensions.x + 63) >> 6;
+	columnStride = (U32)(dimensions.y + 63) >> 6;
+
+	opaque = Vector<U64>((U64)stride * dimensions.y, 0ull);
+	opaqueColumns = Vector<U64>((U64)columnStride * dimensions.x, 0ull);
+	visible = Vector<U64>((U64)stride * dimensions.y, 0ull);
+
+	//Tiles past the end of a line block sight like the ones off the grid
+	if (dimensions.x & 63)
+	{
+		for (I32 y = 0; y < dimensions.y; ++y) { opaque[(U64)y * stride + stride - 1] = ~0ull << (dimensions.x & 63); }
+	}
+
+	if (dimensions.y & 63)
+	{
+		for (I32 x = 0; x < dimensions.x; ++x) { opaqueColumns[(U64)x * columnStride + columnStride - 1] = ~0ull << (dimensions.y & 63); }
+	}
+
+	for (I32 y = 0; y < dimensions.y; ++y)
+	{
+		for (I32 x = 0; x < dimensions.x; ++x)
+		{
+			if (grid->Get(x, y) != TileType::Air)
+			{
+				opaque[(U64)y * stride + (x >> 6)] |= 1ull << (x & 63);
+				opaqueColumns[(U64)x * columnStride + (y >> 6)] |= 1ull << (y & 63);
+			}
+		}
+	}
+}
+
+U32 Visibility::AddViewer(const Vector2Int& position, I32 radius)
+{
+	U32 id;
+	if (freeViewer != U32_MAX)
+	{
+		id = freeViewer;
+		freeViewer = viewers[id].nextFree;
+	}
+	else
+	{
+		id = (U32)viewers.Size();
+		viewers.Push({});
+	}
+
+	Viewer& viewer = viewers[id];
+	viewer.position = position;
+	viewer.radius = Math::Max(radius, 0);
+	viewer.nextFree = U32_MAX;
+	viewer.alive = true;
+
+	MarkViewer(id);
+
+	return id;
+}
+
+void Visibility::MoveViewer(U32 id, const Vector2Int& position)
+{
+	if (id >= viewers.Size() || !viewers[id].alive || viewers[id].position == position) { return; }
+
+	viewers[id].position = position;
+	MarkViewer(id);
+}
+
+void Visibility::SetRadius(U32 id, I32 radius)
+{
+	radius = Math::Max(radius, 0);
+	if (id >= viewers.Size() || !viewers[id].alive || viewers[id].radius == radius) { return; }
+
+	viewers[id].radius = radius;
+	MarkViewer(id);
+}
+
+void Visibility::RemoveViewer(U32 id)
+{
+	if (id >= viewers.Size() || !viewers[id].alive) { return; }
+
+	//The id may still be marked, a viewer reusing the slot is cast by that entry
+	Viewer& viewer = viewers[id];
+	viewer.alive = false;
+	viewer.nextFree = freeViewer;
+	freeViewer = id;
+
+	changed = true;
+}
+
+void Visibility::UpdateTiles(const Vector2Int& min, const Vector2Int& max)
+{
+	if (!tiles) { return; }
+
+	Vector2Int start = { Math::Max(min.x, 0), Math::Max(min.y, 0) };
+	Vector2Int end = { Math::Min(max.x, dimensions.x - 1), Math::Min(max.y, dimensions.y - 1) };
+	if (start.x > end.x || start.y > end.y) { return; }
+
+	bool edited = false;
+
+	for (I32 y = start.y; y <= end.y; ++y)
+	{
+		for (I32 x = start.x; x <= end.x; ++x)
+		{
+			U64 bit = 1ull << (x & 63);
+			U64& word = opaque[(U64)y * stride + (x >> 6)];
+
+			bool solid = tiles->Get(x, y) != TileType::Air;
+			if (((word & bit) != 0) == solid) { continue; }
+
+			edited = true;
+			word ^= bit;
+			opaqueColumns[(U64)x * columnStride + (y >> 6)] ^= 1ull << (y & 63);
+		}
+	}
+
+	if (!edited) { return; }
+
+	//Sight never reaches past a viewer's radius, so only viewers whose square overlaps the tiles can be affected
+	for (U32 i = 0; i < viewers.Size(); ++i)
+	{
+		const Viewer& viewer = viewers[i];
+		if (!viewer.alive) { continue; }
+
+		if (viewer.position.x + viewer.radius >= start.x && viewer.position.x - viewer.radius <= end.x &&
+			viewer.position.y + viewer.radius >= start.y && viewer.position.y - viewer.radius <= end.y)
+		{
+			MarkViewer(i);
+		}
+	}
+}
+
+void Visibility::Update()
+{
+	if (dirtyViewers.Empty() && !changed) { return; }
+
+	ZoneScopedN("Visibility");
+
+	U32 count = (U32)dirtyViewers.Size();
+	U32 threads = Jobs::ThreadCount();
+	U32 batchSize = Math::Max((count + threads - 1) / threads, 1u);
+
+	//Each viewer only writes its own bits, so they can all be cast at once
+	Jobs::ParallelFor(count, batchSize, [this](U32 first, U32 last)
+	{
+		for (U32 i = first; i < last; ++i)
+		{
+			Viewer& viewer = viewers[dirtyViewers[i]];
+			viewer.dirty = false;
+
+			if (viewer.alive) { Cast(viewer); }
+		}
+	});
+
+	TracyPlot("Visibility Casts", (I64)count);
+
+	dirtyViewers.Clear();
+
+	U64* words = visible.Data();
+	for (U64 i = 0; i < visible.Size(); ++i) { words[i] = 0; }
+
+	for (const Viewer& viewer : viewers)
+	{
+		if (viewer.alive) { Merge(viewer); }
+	}
+
+	changed = false;
+}
+
+bool Visibility::Visible(const Vector2Int& tile) const
+{
+	if (tile.x < 0 || tile.y < 0 || tile.x >= dimensions.x || tile.y >= dimensions.y) { return false; }
+
+	return (visible[(U64)tile.y * stride + (tile.x >> 6)] >> (tile.x & 63)) & 1;
+}
+
+bool Visibility::Sees(U32 id, const Vector2Int& tile) const
+{
+	if (id >= viewers.Size() || !viewers[id].alive) { return false; }
+
+	const Viewer& viewer = viewers[id];
+	I32 x = tile.x - viewer.position.x + viewer.radius;
+	I32 y = tile.y - viewer.position.y + viewer.radius;
+	I32 side = viewer.radius * 2 + 1;
+
+	if (x < 0 || y < 0 || x >= side || y >= side || viewer.bits.Size() < (U64)side * viewer.stride) { return false; }
+
+	return (viewer.bits[(U64)y * viewer.stride + (x >> 6)] >> (x & 63)) & 1;
+}
+
+const Vector<U64>& Visibility::Bits() const
+{
+	return visible;
+}
+
+U32 Visibility::Stride() const
+{
+	return stride;
+}
+
+void Visibility::Cast(Viewer& viewer) const
+{
+	I32 side = viewer.radius * 2 + 1;
+	viewer.stride = (U32)(side + 63) >> 6;
+	viewer.bits.Resize((U64)side * viewer.stride, 0ull);
+
+	Reveal(viewer, 0, 0, 0, 0);
+
+	//The four quadrants are cast the same way, scanning rows moving away from the viewer between the slopes -1 and 1
+	for (U8 quadrant = 0; quadrant < 4; ++quadrant)
+	{
+		Scan(viewer, quadrant, 1, { -1, 1 }, { 1, 1 });
+	}
+}
+
+void Visibility::Scan(Viewer& viewer, U8 quadrant, I32 depth, Slope start, Slope end) const
+{
+	I32 limit = viewer.radius * viewer.radius;
+
+	//Rows go on until the last tile of one is a wall, every run of walls splits off the rest of the row into its own scan
+	for (; depth <= viewer.radius; ++depth)
+	{
+		//Columns whose centers are on or inside the slopes, rounding ties outward
+		I32 minColumn = FloorDivide(2 * depth * start.numerator + start.denominator, 2 * start.denominator);
+		I32 maxColumn = -FloorDivide(end.denominator - 2 * depth * end.numerator, 2 * end.denominator);
+		if (minColumn > maxColumn) { return; }
+
+		//Walls are always seen, floor tiles only if their center is between the slopes, which keeps sight symmetric
+		I32 lowest = -FloorDivide(-depth * start.numerator, start.denominator);
+		I32 highest = FloorDivide(depth * end.numerator, end.denominator);
+		I32 reach = SquareRoot(limit - depth * depth);
+
+		I32 previous = -1;	//-1 before the first tile, then whether the last tile was a wall
+
+		for (I32 first = minColumn; first <= maxColumn; first += 64)
+		{
+			I32 count = Math::Min(maxColumn - first + 1, 64);
+			U64 mask = count == 64 ? ~0ull : (1ull << count) - 1;
+			U64 walls = Line(viewer, quadrant, depth, first) & mask;
+
+			//Tiles are handled a run of walls or floor at a time, a run starts wherever a tile differs from the one before it
+			U64 starts = ((walls ^ ((walls << 1) | (previous == 1))) & mask) | 1;
+
+			while (starts)
+			{
+				I32 begin = std::countr_zero(starts);
+				starts &= starts - 1;
+
+				I32 column = first + begin;
+				I32 last = first + (starts ? std::countr_zero(starts) : count) - 1;
+				I32 wall = (walls >> begin) & 1;
+
+				if (wall)
+				{
+					if (previous == 0) { Scan(viewer, quadrant, depth + 1, start, { 2 * column - 1, 2 * depth }); }
+
+					Reveal(viewer, quadrant, depth, Math::Max(column, -reach), Math::Min(last, reach));
+				}
+				else
+				{
+					if (previous == 1)
+					{
+						start = { 2 * column - 1, 2 * depth };
+						lowest = column;
+					}
+
+					Reveal(viewer, quadrant, depth, Math::Max(column, lowest, -reach), Math::Min(last, highest, reach));
+				}
+
+				previous = wall;
+			}
+		}
+
+		if (previous != 0) { return; }
+	}
+}
+
+U64 Visibility::Line(const Viewer& viewer, U8 quadrant, I32 depth, I32 first) const
+{
+	//Quadrants 0 and 1 scan rows below and above the viewer, 2 and 3 scan columns to its right and left
+	I32 offset = quadrant & 1 ? -depth : depth;
+
+	if (quadrant < 2)
+	{
+		I32 y = viewer.position.y + offset;
+		if (y < 0 || y >= dimensions.y) { return ~0ull; }
+
+		return ReadBits(opaque.Data() + (U64)y * stride, stride, viewer.position.x + first);
+	}
+
+	I32 x = viewer.position.x + offset;
+	if (x < 0 || x >= dimensions.x) { return ~0ull; }
+
+	return ReadBits(opaqueColumns.Data() + (U64)x * columnStride, columnStride, viewer.position.y + first);
+}
+
+void Visibility::Reveal(Viewer& viewer, U8 quadrant, I32 depth, I32 first, I32 last) const
+{
+	I32 offset = quadrant & 1 ? -depth : depth;
+
+	if (quadrant < 2)
+	{
+		I32 y = viewer.position.y + offset;
+		first = Math::Max(first, -viewer.position.x);
+		last = Math::Min(last, dimensions.x - 1 - viewer.position.x);
+		if (y < 0 || y >= dimensions.y || first > last) { return; }
+
+		SetBits(viewer.bits.Data() + (U64)(offset + viewer.radius) * viewer.stride, first + viewer.radius, last + viewer.radius);
+		return;
+	}
+
+	I32 x = viewer.position.x + offset;
+	first = Math::Max(first, -viewer.position.y);
+	last = Math::Min(last, dimensions.y - 1 - viewer.position.y);
+	if (x < 0 || x >= dimensions.x || first > last) { return; }
+
+	U32 column = (U32)(offset + viewer.radius);
+	U64* bits = viewer.bits.Data() + (column >> 6);
+	U64 bit = 1ull << (column & 63);
+
+	for (I32 i = first; i <= last; ++i) { bits[(U64)(i + viewer.radius) * viewer.stride] |= bit; }
+}
+
+void Visibility::Merge(const Viewer& viewer)
+{
+	I32 side = viewer.radius * 2 + 1;
+	I32 left = viewer.position.x - viewer.radius;
+	I32 top = viewer.position.y - viewer.radius;
+
+	//Viewers never reveal tiles off the grid, so bits shifted past either side of a row are always clear
+	for (I32 row = Math::Max(-top, 0); row < side && top + row < dimensions.y; ++row)
+	{
+		const U64* source = viewer.bits.Data() + (U64)row * viewer.stride;
+		U64* destination = visible.Data() + (U64)(top + row) * stride;
+
+		for (U32 word = 0; word < viewer.stride; ++word)
+		{
+			U64 bits = source[word];
+			if (!bits) { continue; }
+
+			I32 x = left + (I32)(word << 6);
+			if (x < 0)
+			{
+				bits >>= -x;
+				x = 0;
+			}
+
+			U32 index = (U32)x >> 6;
+			U32 shift = (U32)x & 63;
+
+			destination[index] |= bits << shift;
+			if (shift && index + 1 < stride) { destination[index + 1] |= bits >> (64 - shift); }
+		}
+	}
+}
+
+void Visibility::MarkViewer(U32 id)
+{
+	Viewer& viewer = viewers[id];
+	if (!viewer.dirty)
+	{
+		viewer.dirty = true;
+		dirtyViewers.Push(id);
+	}
+
+	changed = true;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Math.hpp"
+
+#include "Containers/Vector.hpp"
+
+class TileGrid;
+
+/// <summary>
+/// Which tiles of a tile grid can be seen by any of a set of viewers, found with symmetric shadowcasting: a viewer sees a tile
+/// exactly when the tile would see it back, only air tiles are see-through. Each viewer keeps its own bitmap of what it sees,
+/// only viewers that moved or had tiles change near them are cast again, then all of them are merged into one bitmap of the grid
+/// </summary>
+class NH_API Visibility
+{
+public:
+	Visibility();
+	~Visibility();
+	void Destroy();
+
+	/// <summary>
+	/// Reads the tiles of grid, the grid must stay alive until Destroy
+	/// </summary>
+	void Create(const TileGrid* grid);
+
+	/// <summary>
+	/// Adds a viewer that sees tiles within radius of position, nothing is cast until Update
+	/// </summary>
+	/// <returns>A viewer id, valid until it's passed to RemoveViewer</returns>
+	U32 AddViewer(const Vector2Int& position, I32 radius);
+	void MoveViewer(U32 viewer, const Vector2Int& position);
+	void SetRadius(U32 viewer, I32 radius);
+	void RemoveViewer(U32 viewer);
+
+	/// <summary>
+	/// Re-reads the tiles from min to max, inclusive, viewers that can reach any of them are cast again during the next Update
+	/// </summary>
+	void UpdateTiles(const Vector2Int& min, const Vector2Int& max);
+
+	/// <summary>
+	/// Casts every viewer that changed across the worker threads, then rebuilds the shared bitmap if anything did
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// Whether any viewer sees tile, as of the last Update
+	/// </summary>
+	bool Visible(const Vector2Int& tile) const;
+
+	/// <summary>
+	/// Whether a single viewer sees tile, as of the last Update
+	/// </summary>
+	bool Sees(U32 viewer, const Vector2Int& tile) const;
+
+	/// <summary>
+	/// The shared bitmap, one bit per tile, row after row with Stride words to a row, tile x of row y is bit x % 64 of word y * Stride + x / 64
+	/// </summary>
+	const Vector<U64>& Bits() const;
+	U32 Stride() const;
+
+private:
+	//A slope through the corner of a tile, kept as a fraction so tiles are never misjudged by rounding
+	struct Slope
+	{
+		I32 numerator;
+		I32 denominator;
+	};
+
+	struct Viewer
+	{
+		Vector2Int position;
+		I32 radius;
+		U32 stride;				//Words per row of bits
+		Vector<U64> bits;		//One bit per tile of the square around position reaching radius tiles out
+		U32 nextFree;
+		bool alive;
+		bool dirty;
+	};
+
+	void Cast(Viewer& viewer) const;
+	void Scan(Viewer& viewer, U8 quadrant, I32 depth, Slope start, Slope end) const;
+	U64 Line(const Viewer& viewer, U8 quadrant, I32 depth, I32 first) const;
+	void Reveal(Viewer& viewer, U8 quadrant, I32 depth, I32 first, I32 last) const;
+	void Merge(const Viewer& viewer);
+	void MarkViewer(U32 viewer);
+
+	const TileGrid* tiles;
+	Vector2Int dimensions;
+	U32 stride;
+	U32 columnStride;
+
+	Vector<U64> opaque;			//Set for tiles that block sight, laid out like visible, bits past the last column are set
+	Vector<U64> opaqueColumns;	//Transposed copy of opaque so runs along a column are read the same way as runs along a row
+	Vector<U64> visible;
+
+	Vector<Viewer> viewers;
+	U32 freeViewer;
+	Vector<U32> dirtyViewers;
+	bool changed;
+};
\ No newline at end of file
@@ -3,8 +3,130 @@
 #include "Core/Time.hpp"
 
 #include <xthreads.h>
+#include <atomic>
+#include <thread>
+
+static constexpr U32 MaxWorkers = 63;
+
+struct Job
+{
+	JobFn function;
+	void* data;
+	U32 count;
+	U32 batchSize;
+	U32 batchCount;
+	std::atomic<U32> nextBatch;
+	std::atomic<U32> finishedBatches;
+};
+
+static Job job;
+static std::thread workers[MaxWorkers];
+static U32 workerCount = 0;
+static std::atomic<U32> generation = 0;
+static std::atomic<U32> idleWorkers = 0;
+static std::atomic<bool> running = false;
+static thread_local bool insideJob = false;
+
+//Returns once there are no batches left to take, they may still be running on other threads
+static void RunBatches()
+{
+	insideJob = true;
+
+	U32 batch;
+	while ((batch = job.nextBatch.fetch_add(1, std::memory_order_relaxed)) < job.batchCount)
+	{
+		U32 start = batch * job.batchSize;
+		U32 end = start + job.batchSize < job.count ? start + job.batchSize : job.count;
+		job.function(job.data, start, end);
+
+		job.finishedBatches.fetch_add(1, std::memory_order_release);
+	}
+
+	insideJob = false;
+}
+
+//seen is read before the thread starts, a job dispatched before the thread first runs is still picked up
+static void WorkerLoop(U32 seen)
+{
+	while (true)
+	{
+		generation.wait(seen, std::memory_order_acquire);
+		if (!running.load(std::memory_order_acquire)) { return; }
+
+		seen = generation.load(std::memory_order_acquire);
+		RunBatches();
+
+		idleWorkers.fetch_add(1, std::memory_order_release);
+	}
+}
+
+bool Jobs::Initialize()
+{
+	SetThreadCount(0);
+
+	return true;
+}
+
+void Jobs::Shutdown()
+{
+	running.store(false, std::memory_order_release);
+	generation.fetch_add(1, std::memory_order_release);
+	generation.notify_all();
+
+	for (U32 i = 0; i < workerCount; ++i) { workers[i].join(); }
+	workerCount = 0;
+}
 
 void Jobs::Yield()
 {
 	_Thrd_yield();
+}
+
+U32 Jobs::ThreadCount()
+{
+	return workerCount + 1;
+}
+
+void Jobs::SetThreadCount(U32 count)
+{
+	Shutdown();
+
+	if (count == 0) { count = std::thread::hardware_concurrency(); }
+	workerCount = count > 1 ? count - 1 : 0;
+	if (workerCount > MaxWorkers) { workerCount = MaxWorkers; }
+
+	running.store(true, std::memory_order_release);
+	U32 seen = generation.load(std::memory_order_acquire);
+	for (U32 i = 0; i < workerCount; ++i) { workers[i] = std::thread(WorkerLoop, seen); }
+}
+
+void Jobs::Dispatch(U32 count, U32 batchSize, JobFn function, void* data)
+{
+	if (count == 0) { return; }
+	if (batchSize == 0) { batchSize = 1; }
+
+	//Nothing to share the work with
+	if (insideJob || workerCount == 0 || count <= batchSize)
+	{
+		function(data, 0, count);
+		return;
+	}
+
+	job.function = function;
+	job.data = data;
+	job.count = count;
+	job.batchSize = batchSize;
+	job.batchCount = (count + batchSize - 1) / batchSize;
+	job.finishedBatches.store(0, std::memory_order_relaxed);
+	job.nextBatch.store(0, std::memory_order_relaxed);
+	idleWorkers.store(0, std::memory_order_relaxed);
+
+	generation.fetch_add(1, std::memory_order_release);
+	generation.notify_all();
+
+	RunBatches();
+
+	//Every worker has to be done with this job before the next one can overwrite it
+	while (job.finishedBatches.load(std::memory_order_acquire) < job.batchCount ||
+		idleWorkers.load(std::memory_order_acquire) < workerCount) { _Thrd_yield(); }
 }
\ No newline at end of file
@@ -4,13 +4,42 @@
 
 #undef Yield
 
+using JobFn = void(*)(void* data, U32 start, U32 end);
+
 class NH_API Jobs
 {
 public:
 	static void Yield();
 
+	/// <summary>
+	/// Splits [0, count) into batches of batchSize and runs function(start, end) on each across the worker threads,
+	/// the calling thread helps out and this returns once every batch has finished, calls made from inside a batch run inline.
+	/// Only call this from the main thread, there's a single static job that a call from any other thread would overwrite while it runs,
+	/// Physics, Pathfinding, FlowField and Visibility all call it from the engine update
+	/// </summary>
+	template<class Function>
+	static void ParallelFor(U32 count, U32 batchSize, Function&& function);
+
+	/// <returns>The amount of threads batches run on, including the calling thread</returns>
+	static U32 ThreadCount();
+
+	/// <summary>
+	/// Restarts the workers so batches run on count threads, 0 uses every hardware thread
+	/// </summary>
+	static void SetThreadCount(U32 count);
+
 private:
+	static bool Initialize();
+	static void Shutdown();
 
+	static void Dispatch(U32 count, U32 batchSize, JobFn function, void* data);
 
 	STATIC_CLASS(Jobs);
-};
\ No newline at end of file
+	friend class Engine;
+};
+
+template<class Function>
+inline void Jobs::ParallelFor(U32 count, U32 batchSize, Function&& function)
+{
+	Dispatch(count, batchSize, [](void* data, U32 start, U32 end) { (*(Function*)data)(start, end); }, (void*)&function);
+}
\ No newline at end of file
@@ -13,6 +13,8 @@ void MemoryRegion::Create(U8* pointer, U32 regionSize, U32 cap, U32* indices)
 
 bool MemoryRegion::Allocate(void** pointer)
 {
+	LockGuard lock(spinLock);
+
 	if (Full()) { return false; }
 
 	U32 index = GetFree();
@@ -65,8 +67,10 @@ void MemoryRegion::Free(void** pointer)
 	memset(*pointer, 0, regionSize);
 
 	U32 index = (U32)(((U8*)*pointer - region) / regionSize);
-	Release(index);
 	*pointer = nullptr;
+
+	LockGuard lock(spinLock);
+	Release(index);
 }
 
 bool MemoryRegion::WithinRegion(void* pointer)
@@ -74,19 +78,17 @@ bool MemoryRegion::WithinRegion(void* pointer)
 	return pointer > region && pointer < region + capacity * regionSize;
 }
 
+//Only called with spinLock held, a count and its slot in freeIndices have to change together
 U32 MemoryRegion::GetFree()
 {
-	U32 index = ThreadSafety::SafeDecrement32((L32*)&freeCount);
-
-	if (index < capacity) { return freeIndices[index]; }
+	if (freeCount) { return freeIndices[--freeCount]; }
 
-	++freeCount;
-	return ThreadSafety::SafeIncrement32((L32*)&lastFree) - 1;
+	return lastFree++;
 }
 
 void MemoryRegion::Release(U32 index)
 {
-	freeIndices[ThreadSafety::SafeIncrement32((L32*)&freeCount) - 1] = index;
+	freeIndices[freeCount++] = index;
 }
 
 bool MemoryRegion::Full()
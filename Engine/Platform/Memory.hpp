@@ -149,6 +149,7 @@ private:
 	U32 regionSize = 0;
 	U32* freeIndices = nullptr;
 	U8* region = nullptr;
+	SpinLock spinLock;			//Vectors grow from job threads too
 
 	friend class Memory;
 };
@@ -9,6 +9,14 @@
 
 #include "vma/vk_mem_alloc.h"
 
+#include "tracy/Tracy.hpp"
+
+U64 Buffer::frameUploadBytes = 0;
+U64 Buffer::lastFrameUploadBytes = 0;
+
+//Copy regions of one range upload, too many to keep on the stack, uploads only happen on the main thread
+static VkBufferCopy rangeCopies[DirtyRanges::MaxRanges];
+
 bool Buffer::Create(BufferType type, U64 size)
 {
 	this->type = type;
@@ -123,6 +131,8 @@ bool Buffer::UploadVertexData(const void* vertexData, U64 size, U64 offset)
 	vmaUnmapMemory(Renderer::vmaAllocator, stagingBufferAllocation);
 	vmaFlushAllocation(Renderer::vmaAllocator, stagingBufferAllocation, 0, size);
 
+	frameUploadBytes += bufferSize;
+
 	VkBufferMemoryBarrier2 readBarrier{
 		.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
 		.pNext = nullptr,
@@ -154,6 +164,80 @@ bool Buffer::UploadVertexData(const void* vertexData, U64 size, U64 offset)
 	return true;
 }
 
+bool Buffer::UploadVertexRanges(const void* vertexData, U64 size, const DirtyRanges& ranges, U64 stride)
+{
+	dataStart = 0;
+	dataEnd = Math::Max(dataEnd, size);
+
+	//A recreated buffer has no previous contents to keep, everything has to go up
+	if (bufferSize < size)
+	{
+		Destroy();
+
+		if (!Create(type, size)) { return false; }
+
+		return UploadVertexData(vertexData, size, 0);
+	}
+
+	if (ranges.Empty()) { return true; }
+
+	//Once most of the span between the first and last range is dirty anyway, one copy of all of it is cheaper than many small ones
+	DirtyRange span{ ranges.begin()->start, (ranges.end() - 1)->end };
+	bool whole = ranges.Elements() >= (span.end - span.start) * WholeSpanFraction;
+	const DirtyRange* first = whole ? &span : ranges.begin();
+	const DirtyRange* last = whole ? &span + 1 : ranges.end();
+
+	VkBufferCopy* copies = rangeCopies;
+	U32 copyCount = 0;
+	U64 copiedBytes = 0;
+
+	void* data;
+	VkValidateR(vmaMapMemory(Renderer::vmaAllocator, stagingBufferAllocation, &data));
+
+	for (const DirtyRange* range = first; range != last; ++range)
+	{
+		U64 start = range->start * stride;
+		U64 end = Math::Min(range->end * stride, size);
+		if (start >= end) { continue; }
+
+		memcpy((U8*)data + start, (const U8*)vertexData + start, end - start);
+		copies[copyCount++] = { .srcOffset = start, .dstOffset = start, .size = end - start };
+		copiedBytes += end - start;
+	}
+
+	vmaUnmapMemory(Renderer::vmaAllocator, stagingBufferAllocation);
+
+	if (!copyCount) { return true; }
+
+	vmaFlushAllocation(Renderer::vmaAllocator, stagingBufferAllocation, copies[0].srcOffset, copies[copyCount - 1].srcOffset + copies[copyCount - 1].size - copies[0].srcOffset);
+
+	frameUploadBytes += copiedBytes;
+
+	VkBufferMemoryBarrier2 readBarrier{
+		.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+		.pNext = nullptr,
+		.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
+		.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT,
+		.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.buffer = vkBuffer,
+		.offset = 0,
+		.size = bufferSize
+	};
+
+	CommandBuffer& commandBuffer = CommandBufferRing::GetWriteCommandBuffer(Renderer::imageIndex);
+
+	commandBuffer.Begin();
+	commandBuffer.BufferToBuffer(vkBufferStaging, vkBuffer, copyCount, copies);
+	commandBuffer.PipelineBarrier(0, 1, &readBarrier, 0, nullptr);
+	commandBuffer.End();
+	Renderer::commandBuffers[Renderer::imageIndex].Push(commandBuffer);
+
+	return true;
+}
+
 bool Buffer::UploadIndexData(const void* indexData, U64 size, U64 offset)
 {
 	dataStart = Math::Min(dataStart, offset);
@@ -174,6 +258,8 @@ bool Buffer::UploadIndexData(const void* indexData, U64 size, U64 offset)
 	vmaUnmapMemory(Renderer::vmaAllocator, stagingBufferAllocation);
 	vmaFlushAllocation(Renderer::vmaAllocator, stagingBufferAllocation, 0, size);
 
+	frameUploadBytes += bufferSize;
+
 	VkBufferMemoryBarrier2 indexBufferBarrier{
 		.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
 		.pNext = nullptr,
@@ -228,6 +314,51 @@ bool Buffer::UploadStorageData(const void* storageData, U64 size, U64 offset)
 	return bufferResized;
 }
 
+bool Buffer::UploadStorageRanges(const void* storageData, U64 size, const Vector<DirtyRange>& ranges, U64 stride)
+{
+	dataStart = 0;
+	dataEnd = Math::Max(dataEnd, size);
+
+	//A recreated buffer has no previous contents to keep, everything has to go up
+	if (bufferSize < size)
+	{
+		UploadStorageData(storageData, size, 0);
+		frameUploadBytes += size;
+		return true;
+	}
+
+	if (ranges.Empty()) { return true; }
+
+	U64 flushStart = U64_MAX;
+	U64 flushEnd = 0;
+	U64 copiedBytes = 0;
+
+	void* data;
+	VkValidateR(vmaMapMemory(Renderer::vmaAllocator, bufferAllocation, &data));
+
+	for (const DirtyRange& range : ranges)
+	{
+		U64 start = range.start * stride;
+		U64 end = Math::Min(range.end * stride, size);
+		if (start >= end) { continue; }
+
+		memcpy((U8*)data + start, (const U8*)storageData + start, end - start);
+		flushStart = Math::Min(flushStart, start);
+		flushEnd = Math::Max(flushEnd, end);
+		copiedBytes += end - start;
+	}
+
+	vmaUnmapMemory(Renderer::vmaAllocator, bufferAllocation);
+
+	if (!copiedBytes) { return true; }
+
+	vmaFlushAllocation(Renderer::vmaAllocator, bufferAllocation, flushStart, flushEnd - flushStart);
+
+	frameUploadBytes += copiedBytes;
+
+	return true;
+}
+
 bool Buffer::CheckForResize(U64 size)
 {
 	if (size > bufferSize)
@@ -293,6 +424,19 @@ U64 Buffer::Offset() const
 	return dataStart;
 }
 
+U64 Buffer::UploadedBytes()
+{
+	return lastFrameUploadBytes;
+}
+
+void Buffer::EndFrame()
+{
+	TracyPlot("Upload Bytes", (I64)frameUploadBytes);
+
+	lastFrameUploadBytes = frameUploadBytes;
+	frameUploadBytes = 0;
+}
+
 Buffer::operator VkBuffer_T* () const
 {
 	return vkBuffer;
@@ -4,6 +4,7 @@
 
 #include "Resources/ResourceDefines.hpp"
 #include "Containers/Vector.hpp"
+#include "Containers/DirtyRanges.hpp"
 #include "Math/Math.hpp"
 
 struct VmaAllocation_T;
@@ -36,8 +37,22 @@ public:
 	void Destroy();
 
 	bool UploadVertexData(const void* vertexData, U64 size, U64 offset = 0);
+
+	/// <summary>
+	/// Copies only the given ranges of vertexData into the buffer, ranges are in elements of stride bytes,
+	/// the buffer's contents outside of the ranges are expected to still be valid from earlier uploads
+	/// </summary>
+	/// <param name="size:">The size in bytes of all valid data in vertexData</param>
+	bool UploadVertexRanges(const void* vertexData, U64 size, const DirtyRanges& ranges, U64 stride);
 	bool UploadIndexData(const void* indexData, U64 size, U64 offset = 0);
 	bool UploadStorageData(const void* storageData, U64 size, U64 offset = 0);
+
+	/// <summary>
+	/// Copies only the given ranges of storageData into the buffer, ranges are in elements of stride bytes,
+	/// the buffer's contents outside of the ranges are expected to still be valid from earlier uploads
+	/// </summary>
+	/// <param name="size:">The size in bytes of all valid data in storageData</param>
+	bool UploadStorageRanges(const void* storageData, U64 size, const Vector<DirtyRange>& ranges, U64 stride);
 	bool UploadUniformData(const void* uniformData, U64 size, U64 offset = 0);
 	bool UploadStagingData(const void* stagingData, U64 size, U64 offset = 0);
 
@@ -47,11 +62,20 @@ public:
 	U64 Size() const;
 	U64 Offset() const;
 
+	/// <summary>
+	/// The amount of bytes copied to the GPU through staging buffers last frame
+	/// </summary>
+	static U64 UploadedBytes();
+
 	operator VkBuffer_T*() const;
 
 private:
+	static constexpr F32 WholeSpanFraction = 0.5f;	//Dirty share of the span from the first to the last range above which the span goes up as one copy
+
 	bool CheckForResize(U64 bufferSize);
 
+	static void EndFrame();
+
 	BufferType type;
 	U64 bufferSize = 0;
 	U64 stagingPointer = 0;
@@ -64,6 +88,10 @@ private:
 
 	VkDescriptorSet_T* descriptorSet = nullptr;
 
+	static U64 frameUploadBytes;
+	static U64 lastFrameUploadBytes;
+
 	friend class Renderer;
 	friend class Resources;
+	friend class Benchmarks;
 };
\ No newline at end of file
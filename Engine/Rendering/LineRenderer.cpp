@@ -103,4 +103,15 @@ void LineRenderer::DrawLine(const Vector<Vector2>& line, bool loop, const Vector
 		}
 	}
 #endif
+}
+
+void LineRenderer::DrawLines(const Vector<Vector2>& segments, const Vector4& color)
+{
+#ifdef NH_DEBUG
+	for (const Vector2& point : segments)
+	{
+		vertices.Push({ point, color });
+		indices.Push(nextIndex++);
+	}
+#endif
 }
\ No newline at end of file
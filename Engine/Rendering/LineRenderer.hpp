@@ -17,6 +17,11 @@ class NH_API LineRenderer
 public:
 	static void DrawLine(const Vector<Vector2>& line, bool loop = false, const Vector4& color = { 1.0f, 0.0f, 0.0f, 1.0f });
 
+	/// <summary>
+	/// Draws unconnected segments, every two points are one segment
+	/// </summary>
+	static void DrawLines(const Vector<Vector2>& segments, const Vector4& color = { 1.0f, 0.0f, 0.0f, 1.0f });
+
 private:
 	static bool Initialize();
 	static void Shutdown();
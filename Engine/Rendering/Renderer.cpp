@@ -11,6 +11,7 @@
 #include "Core/Logger.hpp"
 #include "Math/Math.hpp"
 #include "Resources/Resources.hpp"
+#include "Resources/Particles.hpp"
 
 #include "tracy/Tracy.hpp"
 
@@ -180,12 +181,14 @@ void Renderer::Update()
 
 	Resources::Update();
 	World::Update();
+	Particles::Update();
 #ifdef NH_DEBUG
 	LineRenderer::Update();
 #endif
 	UI::Update();
 
 	SubmitTransfer();
+	Buffer::EndFrame();
 
 	globalPushConstant.viewProjection = World::camera.ViewProjection();
 	
@@ -195,6 +198,7 @@ void Renderer::Update()
 	commandBuffer.BeginRenderpass(renderpass, swapchain.framebuffers[imageIndex]);
 
 	World::Render(commandBuffer);
+	Particles::Render(commandBuffer);
 
 #ifdef NH_DEBUG
 	LineRenderer::Render(commandBuffer);
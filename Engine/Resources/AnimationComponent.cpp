@@ -6,6 +6,8 @@
 
 Vector<Animation> Animation::components(64, {});
 Freelist Animation::freeComponents(64);
+Vector<U32> Animation::entityLookup;
+U32 Animation::version = 0;
 bool Animation::initialized = false;
 
 void AnimationClip::Create(const TextureAtlas& atlas, U32 startX, U32 startY, U32 countX, U32 countY, F32 frameTime)
@@ -42,8 +44,7 @@ bool Animation::Shutdown()
 ComponentRef<Animation> Animation::AddTo(const EntityRef& entity, const ComponentRef<Sprite>& sprite)
 {
 	U32 instanceId;
-	Animation& animation = Create(instanceId);
-	animation.entityIndex = entity.EntityId();
+	Animation& animation = Create(instanceId, entity.EntityId());
 	animation.sprite = sprite;
 
 	return { entity.EntityId(), instanceId };
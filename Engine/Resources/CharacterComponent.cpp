@@ -8,6 +8,8 @@
 
 Vector<Character> Character::components(1, {});
 Freelist Character::freeComponents(1);
+Vector<U32> Character::entityLookup;
+U32 Character::version = 0;
 bool Character::initialized = false;
 
 bool Character::Initialize()
@@ -33,8 +35,7 @@ bool Character::Shutdown()
 ComponentRef<Character> Character::AddTo(const EntityRef& entity, const Vector2& dimensions)
 {
 	U32 instanceId;
-	Character& character = Create(instanceId);
-	character.entityIndex = entity.EntityId();
+	Character& character = Create(instanceId, entity.EntityId());
 	character.position = entity->position;
 	character.collider = { dimensions, -dimensions };
 
@@ -140,32 +141,29 @@ void Character::Simulate()
 	velocity.y = Math::Max(velocity.y, -1.0f);
 
 	Vector2 frameVelocity = velocity * dt;
-	Vector2 target = position + frameVelocity;
-	Collision collision;
+	bool wasGrounded = grounded;
+	grounded = false;
 
-	if (collision = Physics::CheckCollision(collider + position + Vector2{ frameVelocity.x, 0.0f }))
+	//Each cast resolves the whole move, a second one only slides what's left of it along the surface the first one hit
+	for (U32 i = 0; i < 2 && (frameVelocity.x != 0.0f || frameVelocity.y != 0.0f); ++i)
 	{
-		if (velocity.x > 0.0f) { position.x = collision.aabb.lowerBound.x - collider.upperBound.x; }
-		if (velocity.x < 0.0f) { position.x = collision.aabb.upperBound.x + collider.upperBound.x; }
-		
-		velocity.x = 0.0f;
-	}
-	else
-	{
-		position.x = target.x;
-	}
+		RaycastHit hit = Physics::ShapeCast(collider + position, frameVelocity);
+		if (!hit)
+		{
+			position += frameVelocity;
+			break;
+		}
 
-	if (collision = Physics::CheckCollision(collider + position + Vector2{ 0.0f, frameVelocity.y }))
-	{
-		if (velocity.y > 0.0f) { position.y = collision.aabb.lowerBound.y - collider.upperBound.y; velocity.y *= 0.95f; }
-		if (velocity.y < 0.0f) { position.y = collision.aabb.upperBound.y + collider.upperBound.y; grounded = true; velocity.y = 0.0f; }
-	}
-	else
-	{
-		if (grounded) { jumpTimer = CoyoteTime; }
-		grounded = false;
-		position.y = target.y;
+		position = hit.point - collider.Center();
+		frameVelocity *= 1.0f - hit.fraction;
+
+		if (hit.normal.y > 0.0f) { grounded = true; velocity.y = 0.0f; frameVelocity.y = 0.0f; }
+		else if (hit.normal.y < 0.0f) { velocity.y *= 0.95f; frameVelocity.y = 0.0f; }
+		else if (hit.normal.x != 0.0f) { velocity.x = 0.0f; frameVelocity.x = 0.0f; }
+		else { break; }
 	}
+
+	if (wasGrounded && !grounded) { jumpTimer = CoyoteTime; }
 }
 
 void Character::AddForce(const Vector2& force)
@@ -7,6 +7,8 @@
 
 Vector<Collider> Collider::components(1000, {});
 Freelist Collider::freeComponents(1000);
+Vector<U32> Collider::entityLookup;
+U32 Collider::version = 0;
 bool Collider::initialized = false;
 
 bool Collider::Initialize()
@@ -29,24 +31,53 @@ bool Collider::Shutdown()
 	return false;
 }
 
-ComponentRef<Collider> Collider::AddTo(EntityRef entity)
+ComponentRef<Collider> Collider::AddTo(EntityRef entity, BodyType type, const CollisionFilter& filter)
 {
 	U32 instanceId;
-	Collider& collider = Create(instanceId);
-	collider.entityIndex = entity.EntityId();
+	Collider& collider = Create(instanceId, entity.EntityId());
 	collider.upperBound = entity->position + entity->scale;
 	collider.lowerBound = entity->position - entity->scale;
+	collider.type = type;
 
-	Physics::AddCollider({ entity->position + entity->scale, entity->position - entity->scale });
+	collider.proxy = Physics::AddCollider({ collider.upperBound, collider.lowerBound }, type, filter);
 
 	return { entity.EntityId(), instanceId };
 }
 
+void Collider::RemoveFrom(const EntityRef& entity)
+{
+	ComponentRef<Collider> collider = GetRef(entity);
+	if (collider)
+	{
+		Physics::RemoveCollider(collider->proxy);
+		collider->proxy = U32_MAX;
+
+		Destroy(*collider);
+	}
+}
+
 bool Collider::Update(Camera& camera, Vector<Entity>& entities)
 {
+	for (Collider& collider : components)
+	{
+		if (collider.entityIndex == U32_MAX || collider.type == BodyType::Static) { continue; }
+
+		const Entity& entity = entities[collider.entityIndex];
+		Vector2 upperBound = entity.position + entity.scale;
+		Vector2 lowerBound = entity.position - entity.scale;
+
+		if (upperBound != collider.upperBound || lowerBound != collider.lowerBound)
+		{
+			collider.upperBound = upperBound;
+			collider.lowerBound = lowerBound;
+			Physics::UpdateCollider(collider.proxy, { upperBound, lowerBound });
+		}
+	}
+
 #ifdef NH_DEBUG
 	for (const Collider& collider : components)
 	{
+		if (collider.entityIndex == U32_MAX) { continue; }
 		LineRenderer::DrawLine({ collider.lowerBound, { collider.lowerBound.x, collider.upperBound.y }, collider.upperBound, { collider.upperBound.x, collider.lowerBound.y } }, true, { 0.0f, 1.0f, 0.0f, 1.0f });
 	}
 #endif
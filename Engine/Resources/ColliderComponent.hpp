@@ -2,6 +2,8 @@
 
 #include "Component.hpp"
 
+#include "Math/Physics.hpp"
+
 class RigidBody;
 
 class NH_API Collider
@@ -13,12 +15,19 @@ public:
 	static bool Initialize();
 	static bool Shutdown();
 
-	static ComponentRef<Collider> AddTo(EntityRef entity);
+	/// <summary>
+	/// Colliders that aren't static follow their entity every frame
+	/// </summary>
+	static ComponentRef<Collider> AddTo(EntityRef entity, BodyType type = BodyType::Static, const CollisionFilter& filter = {});
+	static void RemoveFrom(const EntityRef& entity);
 
 private:
 	static bool Update(Camera& camera, Vector<Entity>& entities);
 	static bool Render(CommandBuffer commandBuffer);
 
+	U32 proxy = U32_MAX;
+	BodyType type = BodyType::Static;
+
 	static bool initialized;
 
 	COMPONENT(Collider);
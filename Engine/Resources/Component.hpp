@@ -189,40 +189,104 @@ inline bool ComponentRef<Type>::operator!() const
 private:																			\
 	static Vector<Type> components;													\
 	static Freelist freeComponents;													\
+	static Vector<U32> entityLookup;												\
+	static U32 version;																\
 																					\
-	static Type& Create(U32& index)													\
+	static Type& Create(U32& index, U32 entityId)									\
 	{																				\
 		index = freeComponents.GetFree();											\
-		return components[index];													\
+		Type& component = components[index];										\
+		component.entityIndex = entityId;											\
+																					\
+		if (entityId >= entityLookup.Size())										\
+		{																			\
+			U64 size = entityLookup.Size();											\
+			entityLookup.Resize(entityId + 1 > size * 2 ? entityId + 1 : size * 2);	\
+			for (U64 i = size; i < entityLookup.Size(); ++i) { entityLookup[i] = U32_MAX; } \
+		}																			\
+																					\
+		Link(index, entityId);														\
+		++version;																	\
+																					\
+		return component;															\
+	}																				\
+																					\
+	static U32 CreateBatch(const U32* entityIds, U32 count, U32* indices)			\
+	{																				\
+		count = freeComponents.GetFree(count, indices);								\
+		if (count == 0) { return 0; }												\
+																					\
+		U32 maxEntity = 0;															\
+		for (U32 i = 0; i < count; ++i) { maxEntity = entityIds[i] > maxEntity ? entityIds[i] : maxEntity; } \
+																					\
+		if (maxEntity >= entityLookup.Size())										\
+		{																			\
+			U64 size = entityLookup.Size();											\
+			entityLookup.Resize(maxEntity + 1 > size * 2 ? maxEntity + 1 : size * 2);	\
+			for (U64 i = size; i < entityLookup.Size(); ++i) { entityLookup[i] = U32_MAX; } \
+		}																			\
+																					\
+		for (U32 i = 0; i < count; ++i)												\
+		{																			\
+			components[indices[i]].entityIndex = entityIds[i];						\
+			Link(indices[i], entityIds[i]);											\
+		}																			\
+																					\
+		++version;																	\
+		return count;																\
 	}																				\
 																					\
 	static void Destroy(Type& component)  											\
 	{																				\
+		if (component.entityIndex == U32_MAX) { return; }							\
+																					\
+		U32 index = (U32)(&component - components.Data());							\
+																					\
+		U32* link = &entityLookup[component.entityIndex];							\
+		while (*link != index) { link = &components[*link].nextOfEntity; }			\
+		*link = component.nextOfEntity;												\
+																					\
 		component.entityIndex = U32_MAX;											\
-		freeComponents.Release((U32)(&component - components.Data()));				\
+		component.nextOfEntity = U32_MAX;											\
+		freeComponents.Release(index);												\
+		++version;																	\
 	}																				\
 																					\
 	static void Clear()																\
 	{																				\
 		freeComponents.Reset();														\
 		components.Clear();															\
+		entityLookup.Clear();														\
+		++version;																	\
+	}																				\
+																					\
+	static void Link(U32 index, U32 entityId)										\
+	{																				\
+		components[index].nextOfEntity = U32_MAX;									\
+																					\
+		U32* link = &entityLookup[entityId];										\
+		while (*link != U32_MAX) { link = &components[*link].nextOfEntity; }		\
+		*link = index;																\
 	}																				\
 																					\
 	U32 entityIndex = U32_MAX;														\
+	U32 nextOfEntity = U32_MAX;														\
 																					\
 public:																				\
 	static Type* Get(U32 id) { return &components[id]; }							\
+	static U32 IndexOf(U32 entityId) { return entityId < entityLookup.Size() ? entityLookup[entityId] : U32_MAX; } \
+	static U32 NextOf(U32 id) { return components[id].nextOfEntity; }				\
+	static U32 SlotCount() { return freeComponents.Last(); }						\
+	static U32 FreeCount() { return freeComponents.Capacity() - freeComponents.Size(); } \
+	static U32 Version() { return version; }										\
+	static const void* Pool() { return &components; }								\
+	U32 EntityIndex() const { return entityIndex; }									\
 																					\
 	static ComponentRef<Type> GetRef(const EntityRef& entity)						\
 	{																				\
 		U32 entityId = entity.EntityId();											\
+		U32 index = IndexOf(entityId);												\
 																					\
-		U32 index = 0;																\
-		for (const Type& component : components)									\
-		{																			\
-			if (component.entityIndex == entityId) { return { entityId, index }; }	\
-			++index;																\
-		}																			\
-																					\
-		return nullptr;																\
+		if (index == U32_MAX) { return nullptr; }									\
+		return { entityId, index };													\
 	}
\ No newline at end of file
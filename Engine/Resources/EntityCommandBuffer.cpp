@@ -0,0 +1,89 @@
+#include "EntityCommandBuffer.hpp"
+
+#include "World.hpp"
+
+EntityCommandBuffer::EntityCommandBuffer() {}
+
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+	if (index != U32_MAX)
+	{
+		LockGuard lock(World::commandLock);
+		World::commandBuffers[index] = nullptr;
+		index = U32_MAX;
+	}
+
+	Destroy();
+}
+
+void EntityCommandBuffer::Destroy()
+{
+	Clear();
+
+	commands.Destroy();
+	payloads.Destroy();
+}
+
+void EntityCommandBuffer::DestroyEntity(const EntityRef& entity)
+{
+	Record(EntityCommandPhase::Destroy, nullptr, entity.EntityId(), entity.EntityId(), [](const EntityRef& e)
+	{
+		World::DestroyEntity(e);
+	});
+}
+
+bool EntityCommandBuffer::Empty() const
+{
+	return commands.Empty();
+}
+
+void EntityCommandBuffer::Clear()
+{
+	for (EntityCommand& command : commands) { command.destroy(command.payload); }
+
+	commands.Clear();
+	payloads.Reset();
+}
+
+EntityRef EntityCommandBuffer::CreateEntityInternal(const Vector2& position, const Vector2& scale, const Quaternion2& rotation)
+{
+	return World::CreateEntity(position, scale, rotation);
+}
+
+void* EntityCommandPayloads::Allocate(U64 size, U64 alignment)
+{
+	for (; page < pages.Size(); ++page, used = 0)
+	{
+		Page& current = pages[page];
+		U64 start = NextMultipleOf((U64)current.data + used, alignment) - (U64)current.data;
+
+		if (start + size <= current.capacity)
+		{
+			used = start + size;
+			return current.data + start;
+		}
+	}
+
+	Page& next = pages.Push({});
+	next.capacity = Memory::Allocate(&next.data, size + alignment > PageSize ? size + alignment : PageSize);
+
+	U64 start = NextMultipleOf((U64)next.data, alignment) - (U64)next.data;
+	used = start + size;
+
+	return next.data + start;
+}
+
+void EntityCommandPayloads::Reset()
+{
+	page = 0;
+	used = 0;
+}
+
+void EntityCommandPayloads::Destroy()
+{
+	for (Page& current : pages) { Memory::Free(&current.data); }
+
+	pages.Destroy();
+	page = 0;
+	used = 0;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Entity.hpp"
+
+#include "Containers/Vector.hpp"
+
+enum class NH_API EntityCommandPhase : U8
+{
+	Create,
+	Add,
+	Remove,
+	Destroy
+};
+
+using EntityCommandFn = void(*)(const EntityRef& entity, void* payload);
+using EntityCommandDestroyFn = void(*)(void* payload);
+
+struct NH_API EntityCommand
+{
+	U64 sortKey;				//Phase, then the component pool the command touches
+	U32 index;					//Slot in that pool, or entity id when there is no slot yet, so playback walks each pool in order
+	U32 sequence;
+	U32 entityId;
+	void* payload;
+	EntityCommandFn execute;	//Runs and destroys the payload
+	EntityCommandDestroyFn destroy;
+};
+
+/// <summary>
+/// Storage for recorded commands' captures, allocated in pages that never move so captures don't have to be trivially copyable
+/// </summary>
+struct NH_API EntityCommandPayloads
+{
+	static constexpr U64 PageSize = 16384;
+
+	struct Page
+	{
+		U8* data;
+		U64 capacity;
+	};
+
+	void* Allocate(U64 size, U64 alignment);
+
+	/// <summary>
+	/// Makes every page reusable, captures must have already been destroyed
+	/// </summary>
+	void Reset();
+	void Destroy();
+
+	Vector<Page> pages;
+	U32 page = 0;
+	U64 used = 0;
+};
+
+/// <summary>
+/// Records structural changes (create/destroy entity, add/remove component) so they can be applied at a single sync point,
+/// every thread gets its own buffer through World::Commands(), playback is done by World::FlushCommands()
+/// </summary>
+class NH_API EntityCommandBuffer
+{
+public:
+	EntityCommandBuffer();
+	~EntityCommandBuffer();
+	void Destroy();
+
+	/// <summary>
+	/// Queues the creation of an entity, initializer is called with the new EntityRef during playback
+	/// </summary>
+	template<class Initializer>
+	void CreateEntity(Vector2 position, Vector2 scale, Quaternion2 rotation, Initializer&& initializer);
+	void DestroyEntity(const EntityRef& entity);
+
+	/// <summary>
+	/// Queues Component::AddTo(entity, args...), args are captured by value and destroyed after playback or Clear
+	/// </summary>
+	template<class Component, class... Args>
+	void AddComponent(const EntityRef& entity, Args... args);
+	template<class Component>
+	void RemoveComponent(const EntityRef& entity);
+
+	bool Empty() const;
+
+	/// <summary>
+	/// Drops every pending command, their captures are destroyed without running them
+	/// </summary>
+	void Clear();
+
+private:
+	template<class Function>
+	void Record(EntityCommandPhase phase, const void* pool, U32 index, U32 entityId, Function&& function);
+
+	static U64 MakeKey(EntityCommandPhase phase, const void* pool);
+	static EntityRef CreateEntityInternal(const Vector2& position, const Vector2& scale, const Quaternion2& rotation);
+
+	Vector<EntityCommand> commands;
+	EntityCommandPayloads payloads;
+	U32 index = U32_MAX;
+
+	friend class World;
+};
+
+inline U64 EntityCommandBuffer::MakeKey(EntityCommandPhase phase, const void* pool)
+{
+	return ((U64)phase << 62) | ((U64)pool & 0x3FFFFFFFFFFFFFFF);
+}
+
+template<class Function>
+inline void EntityCommandBuffer::Record(EntityCommandPhase phase, const void* pool, U32 index, U32 entityId, Function&& function)
+{
+	using Type = RemoveQualsReference<Function>;
+
+	void* payload = payloads.Allocate(sizeof(Type), alignof(Type));
+	Construct<Type>((Type*)payload, Forward<Function>(function));
+
+	EntityCommand command{};
+	command.sortKey = MakeKey(phase, pool);
+	command.index = index;
+	command.sequence = (U32)commands.Size();
+	command.entityId = entityId;
+	command.payload = payload;
+	command.execute = [](const EntityRef& entity, void* payload)
+	{
+		Type* fn = (Type*)payload;
+		(*fn)(entity);
+		fn->~Type();
+	};
+	command.destroy = [](void* payload)
+	{
+		((Type*)payload)->~Type();
+	};
+
+	commands.Push(command);
+}
+
+template<class Initializer>
+inline void EntityCommandBuffer::CreateEntity(Vector2 position, Vector2 scale, Quaternion2 rotation, Initializer&& initializer)
+{
+	Record(EntityCommandPhase::Create, nullptr, (U32)commands.Size(), U32_MAX, [=](const EntityRef&) mutable
+	{
+		initializer(CreateEntityInternal(position, scale, rotation));
+	});
+}
+
+template<class Component, class... Args>
+inline void EntityCommandBuffer::AddComponent(const EntityRef& entity, Args... args)
+{
+	Record(EntityCommandPhase::Add, Component::Pool(), entity.EntityId(), entity.EntityId(), [=](const EntityRef& e) mutable
+	{
+		Component::AddTo(e, args...);
+	});
+}
+
+template<class Component>
+inline void EntityCommandBuffer::RemoveComponent(const EntityRef& entity)
+{
+	Record(EntityCommandPhase::Remove, Component::Pool(), Component::IndexOf(entity.EntityId()), entity.EntityId(), [](const EntityRef& e)
+	{
+		Component::RemoveFrom(e);
+	});
+}
\ No newline at end of file
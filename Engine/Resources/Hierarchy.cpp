@@ -0,0 +1,360 @@
+#include "Hierarchy.hpp"
+
+#include "World.hpp"
+
+#include "Core/Logger.hpp"
+
+#include "tracy/Tracy.hpp"
+
+Vector<HierarchyNode> Hierarchy::nodes;
+Vector<U32> Hierarchy::entityToNode;
+Vector<U32> Hierarchy::entityToParent;
+Vector<U32> Hierarchy::entityToFirstChild;
+Vector<U32> Hierarchy::entityToNextSibling;
+bool Hierarchy::orderDirty = false;
+
+void Hierarchy::Shutdown()
+{
+	nodes.Destroy();
+	entityToNode.Destroy();
+	entityToParent.Destroy();
+	entityToFirstChild.Destroy();
+	entityToNextSibling.Destroy();
+	orderDirty = false;
+}
+
+bool Hierarchy::SetParent(const EntityRef& child, const EntityRef& parent)
+{
+	if (!child.Valid() || !parent.Valid()) { return false; }
+
+	U32 childId = child.EntityId();
+	U32 parentId = parent.EntityId();
+
+	for (U32 id = parentId; id != U32_MAX; id = id < entityToParent.Size() ? entityToParent[id] : U32_MAX)
+	{
+		if (id == childId) { Logger::Error("Parenting entity ", childId, " to entity ", parentId, " would create a cycle!"); return false; }
+	}
+
+	AddNode(parentId);
+	HierarchyNode& node = nodes[AddNode(childId)];
+
+	const Entity& childEntity = World::GetEntity(childId);
+	const Entity& parentEntity = World::GetEntity(parentId);
+	Quaternion2 inverse = parentEntity.rotation.Inverse();
+
+	node.localPosition = ((childEntity.position - parentEntity.position) * inverse) / parentEntity.scale;
+	node.localScale = childEntity.scale / parentEntity.scale;
+	node.localRotation = inverse * childEntity.rotation;
+	node.dirty = true;
+
+	UnlinkChild(childId);
+	LinkChild(childId, parentId);
+	orderDirty = true;
+
+	return true;
+}
+
+void Hierarchy::ClearParent(const EntityRef& entity)
+{
+	HierarchyNode* node = Node(entity.EntityId());
+
+	if (!node || entityToParent[entity.EntityId()] == U32_MAX) { return; }
+
+	const Entity& e = World::GetEntity(entity.EntityId());
+	node->localPosition = e.position;
+	node->localScale = e.scale;
+	node->localRotation = e.rotation;
+	node->dirty = true;
+
+	UnlinkChild(entity.EntityId());
+	orderDirty = true;
+}
+
+EntityRef Hierarchy::GetParent(const EntityRef& entity)
+{
+	U32 entityId = entity.EntityId();
+
+	if (entityId >= entityToParent.Size() || entityToParent[entityId] == U32_MAX) { return nullptr; }
+
+	return EntityRef{ entityToParent[entityId] };
+}
+
+void Hierarchy::SetLocalTransform(const EntityRef& entity, const Vector2& position, const Vector2& scale, const Quaternion2& rotation)
+{
+	HierarchyNode* node = Node(entity.EntityId());
+
+	if (!node)
+	{
+		Entity& e = World::GetEntity(entity.EntityId());
+		e.position = position;
+		e.scale = scale;
+		e.rotation = rotation;
+		return;
+	}
+
+	node->localPosition = position;
+	node->localScale = scale;
+	node->localRotation = rotation;
+	node->dirty = true;
+}
+
+void Hierarchy::SetLocalPosition(const EntityRef& entity, const Vector2& position)
+{
+	HierarchyNode* node = Node(entity.EntityId());
+
+	if (!node) { World::GetEntity(entity.EntityId()).position = position; return; }
+
+	node->localPosition = position;
+	node->dirty = true;
+}
+
+void Hierarchy::SetLocalScale(const EntityRef& entity, const Vector2& scale)
+{
+	HierarchyNode* node = Node(entity.EntityId());
+
+	if (!node) { World::GetEntity(entity.EntityId()).scale = scale; return; }
+
+	node->localScale = scale;
+	node->dirty = true;
+}
+
+void Hierarchy::SetLocalRotation(const EntityRef& entity, const Quaternion2& rotation)
+{
+	HierarchyNode* node = Node(entity.EntityId());
+
+	if (!node) { World::GetEntity(entity.EntityId()).rotation = rotation; return; }
+
+	node->localRotation = rotation;
+	node->dirty = true;
+}
+
+U32 Hierarchy::NodeCount()
+{
+	return (U32)nodes.Size();
+}
+
+U32 Hierarchy::AddNode(U32 entityId)
+{
+	if (entityId >= entityToNode.Size())
+	{
+		U64 oldSize = entityToNode.Size();
+		U64 size = entityId + 1 > oldSize * 2 ? entityId + 1 : oldSize * 2;
+		entityToNode.Resize(size);
+		entityToParent.Resize(size);
+		entityToFirstChild.Resize(size);
+		entityToNextSibling.Resize(size);
+
+		for (U64 i = oldSize; i < size; ++i)
+		{
+			entityToNode[i] = U32_MAX;
+			entityToParent[i] = U32_MAX;
+			entityToFirstChild[i] = U32_MAX;
+			entityToNextSibling[i] = U32_MAX;
+		}
+	}
+
+	if (entityToNode[entityId] != U32_MAX) { return entityToNode[entityId]; }
+
+	const Entity& entity = World::GetEntity(entityId);
+
+	HierarchyNode node{};
+	node.entityId = entityId;
+	node.parent = U32_MAX;
+	node.localPosition = entity.position;
+	node.localScale = entity.scale;
+	node.localRotation = entity.rotation;
+	node.worldPosition = entity.position;
+	node.worldScale = entity.scale;
+	node.worldRotation = entity.rotation;
+
+	entityToNode[entityId] = (U32)nodes.Size();
+	nodes.Push(node);
+	orderDirty = true;
+
+	return entityToNode[entityId];
+}
+
+HierarchyNode* Hierarchy::Node(U32 entityId)
+{
+	if (entityId >= entityToNode.Size() || entityToNode[entityId] == U32_MAX) { return nullptr; }
+
+	return &nodes[entityToNode[entityId]];
+}
+
+void Hierarchy::LinkChild(U32 childId, U32 parentId)
+{
+	entityToParent[childId] = parentId;
+	entityToNextSibling[childId] = entityToFirstChild[parentId];
+	entityToFirstChild[parentId] = childId;
+}
+
+void Hierarchy::UnlinkChild(U32 childId)
+{
+	U32 parentId = entityToParent[childId];
+	if (parentId == U32_MAX) { return; }
+
+	U32* link = &entityToFirstChild[parentId];
+	while (*link != childId) { link = &entityToNextSibling[*link]; }
+	*link = entityToNextSibling[childId];
+
+	entityToParent[childId] = U32_MAX;
+	entityToNextSibling[childId] = U32_MAX;
+}
+
+void Hierarchy::RemoveEntity(U32 entityId)
+{
+	HierarchyNode* node = Node(entityId);
+
+	if (!node) { return; }
+
+	//Children of a destroyed entity become roots, keeping their last world transform
+	U32 childId = entityToFirstChild[entityId];
+	while (childId != U32_MAX)
+	{
+		HierarchyNode& child = nodes[entityToNode[childId]];
+		child.localPosition = child.worldPosition;
+		child.localScale = child.worldScale;
+		child.localRotation = child.worldRotation;
+		child.dirty = true;
+
+		U32 next = entityToNextSibling[childId];
+		entityToParent[childId] = U32_MAX;
+		entityToNextSibling[childId] = U32_MAX;
+		childId = next;
+	}
+
+	UnlinkChild(entityId);
+
+	node->entityId = U32_MAX;
+	entityToNode[entityId] = U32_MAX;
+	entityToFirstChild[entityId] = U32_MAX;
+	orderDirty = true;
+}
+
+void Hierarchy::Rebuild()
+{
+	ZoneScopedN("Hierarchy Rebuild");
+
+	orderDirty = false;
+
+	Vector<HierarchyNode> old = Move(nodes);
+	U32 count = (U32)old.Size();
+
+	if (count == 0) { return; }
+
+	Vector<U32> depths(count, U32_MAX);
+	Vector<U32> stack;
+	U32 maxDepth = 0;
+
+	for (U32 i = 0; i < count; ++i)
+	{
+		if (old[i].entityId == U32_MAX || depths[i] != U32_MAX) { continue; }
+
+		U32 index = i;
+		while (depths[index] == U32_MAX)
+		{
+			U32 parentId = entityToParent[old[index].entityId];
+			if (parentId == U32_MAX) { depths[index] = 0; break; }
+
+			stack.Push(index);
+			index = entityToNode[parentId];
+		}
+
+		U32 depth = depths[index];
+		while (stack.Size())
+		{
+			stack.Pop(index);
+			depths[index] = ++depth;
+		}
+
+		if (depth > maxDepth) { maxDepth = depth; }
+	}
+
+	//Counting sort by depth, parents always end up before their children
+	Vector<U32> offsets(maxDepth + 2, 0);
+	for (U32 i = 0; i < count; ++i)
+	{
+		const HierarchyNode& node = old[i];
+		if (node.entityId == U32_MAX) { continue; }
+
+		//Nodes with neither a parent nor children are dropped, they don't need resolving
+		if (entityToParent[node.entityId] == U32_MAX && entityToFirstChild[node.entityId] == U32_MAX) { entityToNode[node.entityId] = U32_MAX; continue; }
+
+		++offsets[depths[i] + 1];
+	}
+
+	for (U32 i = 1; i < offsets.Size(); ++i) { offsets[i] += offsets[i - 1]; }
+
+	nodes.Resize(offsets[maxDepth + 1]);
+
+	for (U32 i = 0; i < count; ++i)
+	{
+		const HierarchyNode& node = old[i];
+		if (node.entityId == U32_MAX || entityToNode[node.entityId] == U32_MAX) { continue; }
+
+		U32 index = offsets[depths[i]]++;
+		nodes[index] = node;
+		nodes[index].depth = depths[i];
+		entityToNode[node.entityId] = index;
+	}
+
+	for (HierarchyNode& node : nodes)
+	{
+		U32 parentId = entityToParent[node.entityId];
+		node.parent = parentId == U32_MAX ? U32_MAX : entityToNode[parentId];
+	}
+}
+
+void Hierarchy::Update(Vector<Entity>& entities)
+{
+	ZoneScopedN("Hierarchy");
+
+	if (orderDirty) { Rebuild(); }
+
+	for (HierarchyNode& node : nodes)
+	{
+		Entity& entity = entities[node.entityId];
+
+		if (node.parent == U32_MAX)
+		{
+			//Roots can be moved directly through their entity, pick those changes up as local changes
+			if (!node.dirty && (entity.position != node.worldPosition || entity.scale != node.worldScale ||
+				entity.rotation.x != node.worldRotation.x || entity.rotation.y != node.worldRotation.y))
+			{
+				node.localPosition = entity.position;
+				node.localScale = entity.scale;
+				node.localRotation = entity.rotation;
+				node.dirty = true;
+			}
+
+			if (node.dirty)
+			{
+				node.worldPosition = node.localPosition;
+				node.worldScale = node.localScale;
+				node.worldRotation = node.localRotation;
+			}
+		}
+		else
+		{
+			const HierarchyNode& parent = nodes[node.parent];
+			node.dirty |= parent.changed;
+
+			if (node.dirty)
+			{
+				node.worldPosition = parent.worldPosition + (node.localPosition * parent.worldScale) * parent.worldRotation;
+				node.worldScale = parent.worldScale * node.localScale;
+				node.worldRotation = parent.worldRotation * node.localRotation;
+			}
+		}
+
+		if (node.dirty)
+		{
+			entity.position = node.worldPosition;
+			entity.scale = node.worldScale;
+			entity.rotation = node.worldRotation;
+		}
+
+		node.changed = node.dirty;
+		node.dirty = false;
+	}
+}
\ No newline at end of file
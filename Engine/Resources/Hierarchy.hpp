@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Entity.hpp"
+
+#include "Containers/Vector.hpp"
+
+struct HierarchyNode
+{
+	U32 entityId;
+	U32 parent;			//Node index of the parent, U32_MAX for roots
+	U32 depth;
+
+	Vector2 localPosition;
+	Vector2 localScale;
+	Quaternion2 localRotation;
+
+	Vector2 worldPosition;
+	Vector2 worldScale;
+	Quaternion2 worldRotation;
+
+	bool dirty;
+	bool changed;
+};
+
+/// <summary>
+/// Parent/child relationships between entities, nodes are kept in breadth-first order in one contiguous array so a single
+/// linear pass per frame resolves every world transform, only subtrees under a dirty or moved node are recomputed
+/// </summary>
+class NH_API Hierarchy
+{
+public:
+	/// <summary>
+	/// Attaches child to parent, the child's current world transform is kept and converted to a local transform
+	/// </summary>
+	/// <returns>false if the link would create a cycle</returns>
+	static bool SetParent(const EntityRef& child, const EntityRef& parent);
+
+	/// <summary>
+	/// Detaches entity from its parent, the entity keeps its current world transform
+	/// </summary>
+	static void ClearParent(const EntityRef& entity);
+	static EntityRef GetParent(const EntityRef& entity);
+
+	/// <summary>
+	/// Sets the transform of entity relative to its parent, for entities without a parent this is the world transform,
+	/// children must be moved through these as their entity transform is overwritten every frame
+	/// </summary>
+	static void SetLocalTransform(const EntityRef& entity, const Vector2& position, const Vector2& scale, const Quaternion2& rotation);
+	static void SetLocalPosition(const EntityRef& entity, const Vector2& position);
+	static void SetLocalScale(const EntityRef& entity, const Vector2& scale);
+	static void SetLocalRotation(const EntityRef& entity, const Quaternion2& rotation);
+
+	static U32 NodeCount();
+
+private:
+	static void Shutdown();
+
+	static void Update(Vector<Entity>& entities);
+	static void Rebuild();
+	static void RemoveEntity(U32 entityId);
+
+	static U32 AddNode(U32 entityId);
+	static HierarchyNode* Node(U32 entityId);
+	static void LinkChild(U32 childId, U32 parentId);
+	static void UnlinkChild(U32 childId);
+
+	static Vector<HierarchyNode> nodes;
+	static Vector<U32> entityToNode;
+	static Vector<U32> entityToParent;
+	static Vector<U32> entityToFirstChild;	//Children of an entity are a list through entityToNextSibling, so removing one never scans all nodes
+	static Vector<U32> entityToNextSibling;
+	static bool orderDirty;
+
+	STATIC_CLASS(Hierarchy);
+	friend class World;
+	friend class Benchmarks;
+};
\ No newline at end of file
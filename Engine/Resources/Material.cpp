@@ -49,6 +49,7 @@ void Material::Destroy()
 	for (U32 i = 0; i < Renderer::imageCount; ++i)
 	{
 		instanceBuffers[i].Destroy();
+		pendingInstances[i].Destroy();
 	}
 
 	pipeline.Destroy();
@@ -112,6 +113,21 @@ void Material::UploadInstances(const void* data, U32 size, U32 offset)
 	else { Logger::Error("This Material Does Not Use Instances!"); }
 }
 
+void Material::UploadInstanceRanges(const void* data, U32 count, const DirtyRanges& dirty)
+{
+	if (!pipeline.InstanceSize()) { Logger::Error("This Material Does Not Use Instances!"); return; }
+
+	for (U32 i = 0; i < Renderer::imageCount; ++i)
+	{
+		pendingInstances[i].Mark(dirty);
+		pendingInstances[i].Clamp(count);
+	}
+
+	DirtyRanges& pending = pendingInstances[Renderer::imageIndex];
+	instanceBuffers[Renderer::imageIndex].UploadVertexRanges(data, (U64)count * pipeline.InstanceSize(), pending, pipeline.InstanceSize());
+	pending.Clear();
+}
+
 void Material::UploadInstancesAll(const void* data, U32 size, U32 offset)
 {
 	if (pipeline.InstanceSize())
@@ -55,6 +55,13 @@ public:
 	void UploadVertices(const void* data, U32 size, U32 offset);
 	void UploadInstances(const void* data, U32 size, U32 offset);
 	void UploadInstancesAll(const void* data, U32 size, U32 offset);
+
+	/// <summary>
+	/// Uploads only the instances marked in dirty to this frame's instance buffer, every swapchain image keeps its own pending ranges
+	/// so a change reaches all of them, data must always point to the full instance array
+	/// </summary>
+	/// <param name="count:">The total amount of instances in data</param>
+	void UploadInstanceRanges(const void* data, U32 count, const DirtyRanges& dirty);
 	void UploadIndices(const void* data, U32 size, U32 offset);
 
 	void ClearVertices();
@@ -72,6 +79,7 @@ private:
 	Buffer vertexBuffer;
 	Buffer indexBuffer;
 	Buffer instanceBuffers[MaxSwapchainImages];
+	DirtyRanges pendingInstances[MaxSwapchainImages];
 	Vector<VkDescriptorSet_T*> sets;
 	Vector<PushConstant> pushConstants;
 
@@ -1,56 +1,362 @@
 #include "Particles.hpp"
 
-#include "Entity.hpp"
-#include "World.hpp"
+#include "Resources.hpp"
 
-#include "Resources/SpriteComponent.hpp"
-#include "Resources/ProjectileComponent.hpp"
+#include "Rendering/VulkanInclude.hpp"
+#include "Rendering/Renderer.hpp"
+#include "Math/Physics.hpp"
+#include "Math/Random.hpp"
+#include "Platform/Memory.hpp"
+#include "Core/Time.hpp"
 
-bool OnHit(const EntityRef& entity, bool hitVertical)
+#include "tracy/Tracy.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define NH_PARTICLES_SSE
+#	include <immintrin.h>
+#endif
+
+Material Particles::material;
+Shader Particles::vertexShader;
+Shader Particles::fragmentShader;
+Vector<ParticleEmitter> Particles::emitters;
+Vector<SpriteInstance> Particles::instances;
+Vector<U32> Particles::spawnEmitters;
+U32 Particles::liveCount = 0;
+bool Particles::initialized = false;
+
+bool Particles::Initialize()
+{
+	if (initialized) { return true; }
+
+	initialized = true;
+
+	VkPushConstantRange pushConstant{};
+	pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstant.offset = 0;
+	pushConstant.size = sizeof(GlobalPushConstant);
+
+	PipelineLayout pipelineLayout;
+	pipelineLayout.Create({ Resources::DummyDescriptorSet(), Resources::BindlessTexturesDescriptorSet() }, { pushConstant });
+
+	//Particles are drawn as sprites, they only differ in how their instances are produced
+	vertexShader.Create("shaders/sprite.vert.spv", ShaderStage::Vertex);
+	fragmentShader.Create("shaders/sprite.frag.spv", ShaderStage::Fragment);
+
+	Vector<VkVertexInputBindingDescription> inputs = {
+		{ 0, sizeof(SpriteVertex), VK_VERTEX_INPUT_RATE_VERTEX },
+		{ 1, sizeof(SpriteInstance), VK_VERTEX_INPUT_RATE_INSTANCE}
+	};
+
+	Vector<VkVertexInputAttributeDescription> attributes = {
+		{ 0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteVertex, position) },
+		{ 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteVertex, texcoord) },
+
+		{ 2, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteInstance, position) },
+		{ 3, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteInstance, scale) },
+		{ 4, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteInstance, rotation) },
+		{ 5, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(SpriteInstance, instColor) },
+		{ 6, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteInstance, instTexcoord) },
+		{ 7, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteInstance, instTexcoordScale) },
+		{ 8, 1, VK_FORMAT_R32_UINT, offsetof(SpriteInstance, textureIndex) },
+		{ 9, 1, VK_FORMAT_R32_UINT, offsetof(SpriteInstance, spriteIndex) },
+	};
+
+	Pipeline pipeline;
+	pipeline.Create(pipelineLayout, { PolygonMode::Fill }, { vertexShader, fragmentShader }, inputs, attributes);
+	material.Create(pipelineLayout, pipeline, { Resources::DummyDescriptorSet(), Resources::BindlessTexturesDescriptorSet() },
+		{ PushConstant{ Renderer::GetGlobalPushConstant(), sizeof(GlobalPushConstant), 0, VK_SHADER_STAGE_VERTEX_BIT } });
+
+	SpriteVertex vertices[4] = {
+		{ { -1.0f, -1.0f }, { 0.0f, 1.0f } },
+		{ { -1.0f,  1.0f }, { 0.0f, 0.0f } },
+		{ {  1.0f,  1.0f }, { 1.0f, 0.0f } },
+		{ {  1.0f, -1.0f }, { 1.0f, 1.0f } }
+	};
+
+	U32 indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+	material.UploadVertices(vertices, sizeof(SpriteVertex) * 4, 0);
+	material.UploadIndices(indices, sizeof(U32) * 6, 0);
+
+	return true;
+}
+
+void Particles::Shutdown()
 {
-	ComponentRef<Projectile> p = Projectile::GetRef(entity);
+	if (!initialized) { return; }
+
+	initialized = false;
+
+	for (U32 i = 0; i < emitters.Size(); ++i) { DestroyEmitter(i); }
 
-	if (hitVertical) { p->velocity.y *= -0.25f; }
-	else { p->velocity.x *= -0.25f; }
+	emitters.Destroy();
+	instances.Destroy();
+	spawnEmitters.Destroy();
 
-	return false;
+	vertexShader.Destroy();
+	fragmentShader.Destroy();
+	material.Destroy();
 }
 
-bool OnUpdate(const EntityRef& entity)
+U32 Particles::CreateEmitter(const ParticleEmitterInfo& info)
 {
-	ComponentRef<Projectile> p = Projectile::GetRef(entity);
-	ComponentRef<Sprite> s = Sprite::GetRef(entity);
-	s->SetColor({1.0f, 1.0f, 1.0f, p->timer });
+	if (info.capacity == 0 || info.lifetime <= 0.0f) { Logger::Error("Particle Emitters Need A Capacity And A Lifetime!"); return U32_MAX; }
 
-	return false;
+	U32 id = 0;
+	for (; id < emitters.Size(); ++id) { if (!emitters[id].alive) { break; } }
+	if (id == emitters.Size()) { emitters.Push({}); }
+
+	ParticleEmitter& emitter = emitters[id];
+	emitter.info = info;
+	emitter.count = 0;
+	emitter.alive = true;
+
+	Memory::Allocate(&emitter.positionX, info.capacity);
+	Memory::Allocate(&emitter.positionY, info.capacity);
+	Memory::Allocate(&emitter.velocityX, info.capacity);
+	Memory::Allocate(&emitter.velocityY, info.capacity);
+	Memory::Allocate(&emitter.rotationX, info.capacity);
+	Memory::Allocate(&emitter.rotationY, info.capacity);
+	Memory::Allocate(&emitter.age, info.capacity);
+
+	return id;
 }
 
-bool OnExpire(const EntityRef& entity)
+void Particles::DestroyEmitter(U32 id)
 {
-	Sprite::RemoveFrom(entity);
-	Projectile::RemoveFrom(entity);
-	World::DestroyEntity(entity);
+	if (id >= emitters.Size() || !emitters[id].alive) { return; }
 
-	return false;
+	ParticleEmitter& emitter = emitters[id];
+
+	Memory::Free(&emitter.positionX);
+	Memory::Free(&emitter.positionY);
+	Memory::Free(&emitter.velocityX);
+	Memory::Free(&emitter.velocityY);
+	Memory::Free(&emitter.rotationX);
+	Memory::Free(&emitter.rotationY);
+	Memory::Free(&emitter.age);
+
+	emitter.info.texture.Destroy();
+	emitter.count = 0;
+	emitter.alive = false;
+}
+
+void Particles::Emit(U32 id, const Vector2& position, U32 count)
+{
+	if (id >= emitters.Size() || !emitters[id].alive) { return; }
+
+	ParticleEmitter& emitter = emitters[id];
+	const ParticleEmitterInfo& info = emitter.info;
+
+	U32 end = Math::Min(emitter.count + count, info.capacity);
+
+	for (U32 i = emitter.count; i < end; ++i)
+	{
+		Quaternion2 rotation = Quaternion2::Random();
+		Quaternion2 direction = Quaternion2::Random();
+		F32 speed = info.minSpeed + (info.maxSpeed - info.minSpeed) * (F32)Random::RandomUniform();
+
+		emitter.positionX[i] = position.x;
+		emitter.positionY[i] = position.y;
+		emitter.velocityX[i] = direction.x * speed;
+		emitter.velocityY[i] = direction.y * speed;
+		emitter.rotationX[i] = rotation.x;
+		emitter.rotationY[i] = rotation.y;
+		emitter.age[i] = 0.0f;
+	}
+
+	emitter.count = end;
 }
 
 void Particles::Spawn(const Vector2& position, ResourceRef<Texture> texture)
 {
-	for (U32 i = 0; i < 5; i++)
+	for (U32 id : spawnEmitters)
 	{
-		Quaternion2 rot = Quaternion2::Random();
-		Quaternion2 dir = Quaternion2::Random();
+		if (emitters[id].info.texture.Handle() == texture.Handle()) { Emit(id, position, 5); return; }
+	}
+
+	ParticleEmitterInfo info{};
+	info.texture = texture;
+	info.scale = 0.25f;
+	info.minSpeed = 2.0f;
+	info.maxSpeed = 2.0f;
+	info.gravity = 50.0f;
+	info.bounce = 0.25f;
+	info.collideWithTiles = true;
+
+	U32 id = CreateEmitter(info);
+	if (id == U32_MAX) { return; }
+
+	spawnEmitters.Push(id);
+	Emit(id, position, 5);
+}
+
+U32 Particles::LiveCount()
+{
+	return liveCount;
+}
+
+void Particles::Update()
+{
+	ZoneScopedN("Particles");
+
+	F32 dt = (F32)Time::DeltaTimeStable();
+
+	liveCount = 0;
+	for (ParticleEmitter& emitter : emitters)
+	{
+		if (!emitter.alive || !emitter.count) { continue; }
+
+		Simulate(emitter, dt);
+		if (emitter.info.collideWithTiles) { Collide(emitter, dt); }
+		Kill(emitter);
+
+		liveCount += emitter.count;
+	}
 
-		EntityRef entity = World::CreateEntity(position, 0.25f, rot);
+	material.ClearInstances();
 
-		ComponentRef<Sprite> s = Sprite::AddTo(entity, texture);
-		ComponentRef<Projectile> p = Projectile::AddTo(entity, Vector2{ dir.x, dir.y } * 2.0f, 1.0f, 0.0f, 50.0f);
+	if (!liveCount) { return; }
 
-		if (s && p)
+	instances.Resize(liveCount);
+
+	SpriteInstance* instance = instances.Data();
+	for (const ParticleEmitter& emitter : emitters)
+	{
+		if (!emitter.alive || !emitter.count) { continue; }
+
+		WriteInstances(emitter, instance);
+		instance += emitter.count;
+	}
+
+	material.UploadInstances(instances.Data(), liveCount * sizeof(SpriteInstance), 0);
+}
+
+void Particles::Render(CommandBuffer commandBuffer)
+{
+	if (liveCount) { material.Bind(commandBuffer); }
+}
+
+void Particles::Simulate(ParticleEmitter& emitter, F32 dt)
+{
+	ZoneScopedN("Particles Simulate");
+
+	F32* x = emitter.positionX;
+	F32* y = emitter.positionY;
+	F32* vx = emitter.velocityX;
+	F32* vy = emitter.velocityY;
+	F32* age = emitter.age;
+	U32 count = emitter.count;
+	F32 gravity = emitter.info.gravity * dt;
+
+	//Colliding emitters move in Collide so each axis can be blocked separately
+	bool move = !emitter.info.collideWithTiles;
+
+	U32 i = 0;
+
+#ifdef NH_PARTICLES_SSE
+	__m128 delta = _mm_set1_ps(dt);
+	__m128 fall = _mm_set1_ps(gravity);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 velocityY = _mm_sub_ps(_mm_loadu_ps(vy + i), fall);
+		_mm_storeu_ps(vy + i, velocityY);
+		_mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), delta));
+
+		if (move)
+		{
+			_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), delta)));
+			_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(velocityY, delta)));
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		vy[i] -= gravity;
+		age[i] += dt;
+
+		if (move)
 		{
-			p->OnHit += OnHit;
-			p->OnUpdate += OnUpdate;
-			p->OnExpire += OnExpire;
+			x[i] += vx[i] * dt;
+			y[i] += vy[i] * dt;
 		}
 	}
+}
+
+void Particles::Collide(ParticleEmitter& emitter, F32 dt)
+{
+	ZoneScopedN("Particles Collide");
+
+	F32 bounce = -emitter.info.bounce;
+
+	for (U32 i = 0; i < emitter.count; ++i)
+	{
+		F32 x = emitter.positionX[i] + emitter.velocityX[i] * dt;
+		if (Physics::CheckTile({ x, emitter.positionY[i] })) { emitter.velocityX[i] *= bounce; }
+		else { emitter.positionX[i] = x; }
+
+		F32 y = emitter.positionY[i] + emitter.velocityY[i] * dt;
+		if (Physics::CheckTile({ emitter.positionX[i], y })) { emitter.velocityY[i] *= bounce; }
+		else { emitter.positionY[i] = y; }
+	}
+}
+
+void Particles::Kill(ParticleEmitter& emitter)
+{
+	F32 lifetime = emitter.info.lifetime;
+
+	//Swap the last live particle into each dead slot so the pool stays packed
+	for (U32 i = 0; i < emitter.count;)
+	{
+		if (emitter.age[i] < lifetime) { ++i; continue; }
+
+		U32 last = --emitter.count;
+		emitter.positionX[i] = emitter.positionX[last];
+		emitter.positionY[i] = emitter.positionY[last];
+		emitter.velocityX[i] = emitter.velocityX[last];
+		emitter.velocityY[i] = emitter.velocityY[last];
+		emitter.rotationX[i] = emitter.rotationX[last];
+		emitter.rotationY[i] = emitter.rotationY[last];
+		emitter.age[i] = emitter.age[last];
+	}
+}
+
+void Particles::WriteInstances(const ParticleEmitter& emitter, SpriteInstance* output)
+{
+	ZoneScopedN("Particles Instances");
+
+	const ParticleEmitterInfo& info = emitter.info;
+	F32 inverseLifetime = 1.0f / info.lifetime;
+	U32 textureIndex = info.texture.Handle();
+
+#ifdef NH_PARTICLES_SSE
+	__m128 startColor = _mm_loadu_ps(info.startColor.Data());
+	__m128 colorRange = _mm_sub_ps(_mm_loadu_ps(info.endColor.Data()), startColor);
+#else
+	Vector4 colorRange = info.endColor - info.startColor;
+#endif
+
+	for (U32 i = 0; i < emitter.count; ++i)
+	{
+		SpriteInstance& instance = output[i];
+		F32 life = emitter.age[i] * inverseLifetime;
+
+		instance.position = { emitter.positionX[i], emitter.positionY[i] };
+		instance.scale = info.scale;
+		instance.rotation = { emitter.rotationX[i], emitter.rotationY[i] };
+
+#ifdef NH_PARTICLES_SSE
+		_mm_storeu_ps(instance.instColor.Data(), _mm_add_ps(startColor, _mm_mul_ps(colorRange, _mm_set1_ps(life))));
+#else
+		instance.instColor = info.startColor + colorRange * life;
+#endif
+
+		instance.instTexcoord = Vector2::Zero;
+		instance.instTexcoordScale = Vector2::One;
+		instance.textureIndex = textureIndex;
+		instance.spriteIndex = i;
+	}
 }
\ No newline at end of file
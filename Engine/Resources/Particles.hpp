@@ -2,13 +2,88 @@
 
 #include "ResourceDefines.hpp"
 #include "Texture.hpp"
+#include "Material.hpp"
+#include "SpriteComponent.hpp"
 
-struct Vector2;
+#include "Math/Math.hpp"
+#include "Containers/Vector.hpp"
 
+struct NH_API ParticleEmitterInfo
+{
+	ResourceRef<Texture> texture = nullptr;
+	Vector4 startColor = Vector4::One;
+	Vector4 endColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+	Vector2 scale = Vector2::One;
+	F32 lifetime = 1.0f;
+	F32 minSpeed = 0.0f;
+	F32 maxSpeed = 1.0f;
+	F32 gravity = 0.0f;
+	F32 bounce = 0.0f;			//Fraction of velocity kept when bouncing off of a tile
+	U32 capacity = 4096;
+	bool collideWithTiles = false;
+};
+
+struct ParticleEmitter
+{
+	ParticleEmitterInfo info;
+
+	U32 count = 0;
+	bool alive = false;
+
+	F32* positionX = nullptr;
+	F32* positionY = nullptr;
+	F32* velocityX = nullptr;
+	F32* velocityY = nullptr;
+	F32* rotationX = nullptr;	//Each particle keeps the random rotation it was emitted with
+	F32* rotationY = nullptr;
+	F32* age = nullptr;
+};
+
+/// <summary>
+/// Pooled CPU particles, every emitter owns a struct of arrays pool that is updated in one vectorized pass,
+/// live particles are kept packed so dead ones cost nothing, instances are written straight into one sprite instance buffer
+/// </summary>
 class NH_API Particles
 {
 public:
+	/// <returns>The id of the emitter, U32_MAX on failure</returns>
+	static U32 CreateEmitter(const ParticleEmitterInfo& info);
+	static void DestroyEmitter(U32 emitter);
+
+	/// <summary>
+	/// Spawns count particles at position moving in random directions, particles past the emitter's capacity are dropped
+	/// </summary>
+	static void Emit(U32 emitter, const Vector2& position, U32 count);
+
+	/// <summary>
+	/// Emits a small burst from a shared emitter for texture
+	/// </summary>
 	static void Spawn(const Vector2& position, ResourceRef<Texture> texture);
 
+	static U32 LiveCount();
+
+private:
+	static bool Initialize();
+	static void Shutdown();
+	static void Update();
+	static void Render(CommandBuffer commandBuffer);
+
+	static void Simulate(ParticleEmitter& emitter, F32 dt);
+	static void Collide(ParticleEmitter& emitter, F32 dt);
+	static void Kill(ParticleEmitter& emitter);
+	static void WriteInstances(const ParticleEmitter& emitter, SpriteInstance* instances);
+
+	static Material material;
+	static Shader vertexShader;
+	static Shader fragmentShader;
+	static Vector<ParticleEmitter> emitters;
+	static Vector<SpriteInstance> instances;
+	static Vector<U32> spawnEmitters;
+	static U32 liveCount;
+	static bool initialized;
+
 	STATIC_CLASS(Particles);
+	friend class Engine;
+	friend class Renderer;
+	friend class Benchmarks;
 };
\ No newline at end of file
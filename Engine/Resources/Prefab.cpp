@@ -0,0 +1,18 @@
+#include "Prefab.hpp"
+
+Prefab::Prefab(const Vector2& position, const Vector2& scale, const Quaternion2& rotation) : position(position), scale(scale), rotation(rotation) {}
+
+Prefab::~Prefab()
+{
+	Destroy();
+}
+
+void Prefab::Destroy()
+{
+	for (PrefabComponent& component : components)
+	{
+		component.destroy(component.prototype);
+	}
+
+	components.Destroy();
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Entity.hpp"
+
+#include "Containers/Vector.hpp"
+#include "Platform/Memory.hpp"
+
+using PrefabInstantiateFn = void(*)(const U32* entityIds, U32 count, const void* prototype);
+using PrefabAvailableFn = U32(*)();
+using PrefabDestroyFn = void(*)(void* prototype);
+
+struct PrefabComponent
+{
+	PrefabInstantiateFn instantiate;
+	PrefabAvailableFn available;
+	PrefabDestroyFn destroy;
+	void* prototype;
+};
+
+/// <summary>
+/// A default transform plus a set of components with default values, used by World::Instantiate to spawn many entities at once,
+/// a component can be added to a prefab if it declares a Prototype struct and a static AddToBatch(const U32*, U32, const Prototype&)
+/// </summary>
+class NH_API Prefab
+{
+public:
+	Prefab(const Vector2& position = Vector2::Zero, const Vector2& scale = Vector2::One, const Quaternion2& rotation = Quaternion2::Identity);
+	~Prefab();
+	void Destroy();
+
+	template<class Component>
+	Prefab& Add(const typename Component::Prototype& prototype);
+
+	Vector2 position;
+	Vector2 scale;
+	Quaternion2 rotation;
+
+private:
+	Vector<PrefabComponent> components;
+
+	Prefab(const Prefab&) = delete;
+	Prefab& operator=(const Prefab&) = delete;
+
+	friend class World;
+};
+
+template<class Component>
+inline Prefab& Prefab::Add(const typename Component::Prototype& prototype)
+{
+	using Prototype = typename Component::Prototype;
+
+	Prototype* copy = nullptr;
+	Memory::Allocate(&copy);
+	Construct<Prototype>(copy, prototype);
+
+	components.Push({
+		[](const U32* entityIds, U32 count, const void* data) { Component::AddToBatch(entityIds, count, *(const Prototype*)data); },
+		[]() { return Component::FreeCount(); },
+		[](void* data) { Prototype* p = (Prototype*)data; p->~Prototype(); Memory::Free(&p); },
+		copy
+	});
+
+	return *this;
+}
\ No newline at end of file
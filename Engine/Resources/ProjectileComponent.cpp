@@ -4,8 +4,37 @@
 
 #include "Core/Time.hpp"
 
-Vector<Projectile> Projectile::components(10000, {});
-Freelist Projectile::freeComponents(10000);
+#include "tracy/Tracy.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define NH_PROJECTILE_SSE
+#	include <immintrin.h>
+#endif
+
+Vector<Projectile> Projectile::components(MaxProjectiles, {});
+Freelist Projectile::freeComponents(MaxProjectiles);
+Vector<U32> Projectile::entityLookup;
+U32 Projectile::version = 0;
+
+Vector<F32> Projectile::positionX(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::positionY(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::velocityX(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::velocityY(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::deltaX(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::deltaY(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::accelerations(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::gravities(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::timers(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::extentX(MaxProjectiles, 0.0f);
+Vector<F32> Projectile::extentY(MaxProjectiles, 0.0f);
+Vector<U8> Projectile::flags(MaxProjectiles, 0);
+Vector<ProjectileEvents> Projectile::events(MaxProjectiles, {});
+Vector<U32> Projectile::active;
+Vector<AABB> Projectile::queries;
+Vector<Vector2> Projectile::displacements;
+Vector<RaycastHit> Projectile::results;
+U32 Projectile::collisionMask = Physics::AllCategories;
+
 bool Projectile::initialized = false;
 
 bool Projectile::Initialize()
@@ -23,38 +52,76 @@ bool Projectile::Initialize()
 
 bool Projectile::Shutdown()
 {
-	if (initialized) { initialized = false; }
+	if (initialized)
+	{
+		initialized = false;
+
+		active.Destroy();
+		queries.Destroy();
+		displacements.Destroy();
+		results.Destroy();
+	}
 
 	return false;
 }
 
+void Projectile::Setup(U32 index, const Entity& entity, const Vector2& velocity, F32 duration, F32 acceleration, F32 gravity)
+{
+	positionX[index] = entity.position.x;
+	positionY[index] = entity.position.y;
+	velocityX[index] = velocity.x;
+	velocityY[index] = velocity.y;
+	deltaX[index] = 0.0f;
+	deltaY[index] = 0.0f;
+	accelerations[index] = acceleration;
+	gravities[index] = gravity;
+	timers[index] = duration;
+	extentX[index] = entity.scale.x;
+	extentY[index] = entity.scale.y;
+	flags[index] = duration > 0.0f ? FlagExpire : 0;
+}
+
 ComponentRef<Projectile> Projectile::AddTo(const EntityRef& entity, const Vector2& velocity, F32 duration, F32 acceleration, F32 gravity)
 {
 	if (freeComponents.Full()) { Logger::Error("Max Projectile Instances Reached!"); return nullptr; }
 
 	U32 instanceId;
-	Projectile& projectile = Create(instanceId);
-	projectile.entityIndex = entity.EntityId();
-	projectile.position = entity->position;
-	projectile.velocity = velocity;
-	projectile.collider = { entity->scale, -entity->scale };
-	projectile.acceleration = acceleration;
-	projectile.gravity = gravity;
-	projectile.timer = duration;
-	projectile.expire = duration > 0.0f;
-	projectile.hit = false;
+	Create(instanceId, entity.EntityId());
+	Setup(instanceId, *entity, velocity, duration, acceleration, gravity);
 
 	return { entity.EntityId(), instanceId };
 }
 
+void Projectile::AddToBatch(const U32* entityIds, U32 count, const Prototype& prototype)
+{
+	Vector<U32> indexStorage(count);
+	U32* indices = indexStorage.Data();
+	U32 created = CreateBatch(entityIds, count, indices);
+	if (created < count) { Logger::Error("Max Projectile Instances Reached!"); }
+
+	for (U32 i = 0; i < created; ++i)
+	{
+		Setup(indices[i], World::GetEntity(entityIds[i]), prototype.velocity, prototype.duration, prototype.acceleration, prototype.gravity);
+	}
+}
+
 void Projectile::RemoveFrom(const EntityRef& entity)
 {
 	ComponentRef<Projectile> projectile = GetRef(entity);
 	if (projectile)
 	{
-		projectile->OnHit.Destroy();
-		projectile->OnUpdate.Destroy();
-		projectile->OnExpire.Destroy();
+		U32 index = projectile->Index();
+
+		ProjectileEvents& e = events[index];
+		e.OnHit.Destroy();
+		e.OnUpdate.Destroy();
+		e.OnExpire.Destroy();
+
+		velocityX[index] = 0.0f;
+		velocityY[index] = 0.0f;
+		accelerations[index] = 0.0f;
+		gravities[index] = 0.0f;
+		flags[index] = 0;
 
 		Destroy(*projectile);
 	}
@@ -62,30 +129,57 @@ void Projectile::RemoveFrom(const EntityRef& entity)
 
 bool Projectile::Update(Camera& camera, Vector<Entity>& entities)
 {
-	for (Projectile* projectile = components.begin(); projectile != components.end(); ++projectile)
+	ZoneScopedN("Projectile Update");
+
+	U32 slotCount = SlotCount();
+
+	Integrate(0, slotCount, (F32)Time::DeltaTimeStable());
+
+	active.Clear();
+	for (U32 i = 0; i < slotCount; ++i)
 	{
-		if (projectile->entityIndex == U32_MAX) { continue; }
-		Entity& entity = entities[projectile->entityIndex];
-		projectile->Simulate();
+		if (components[i].entityIndex != U32_MAX) { active.Push(i); }
+	}
 
-		if (projectile->hit && projectile->OnHit)
-		{
-			projectile->OnHit({ projectile->entityIndex }, projectile->hitVertical);
-			projectile->hit = false;
-		}
+	if (active.Empty()) { return false; }
 
-		if (projectile->OnUpdate)
-		{
-			projectile->OnUpdate({ projectile->entityIndex });
-		}
+	queries.Resize(active.Size());
+	displacements.Resize(active.Size());
+	results.Resize(active.Size());
+
+	Resolve();
 
-		if (projectile->OnExpire && projectile->timer <= 0.0f && projectile->expire)
+	{
+		ZoneScopedN("Projectile Callbacks");
+
+		for (U32 index : active)
 		{
-			projectile->expire = false;
-			projectile->OnExpire({ projectile->entityIndex });
-		}
+			Projectile& projectile = components[index];
+			ProjectileEvents& e = events[index];
+
+			//A hit usually records the projectile's removal, which only happens at the next flush, so nothing else fires for it this frame
+			bool hit = (flags[index] & FlagHit) && e.OnHit;
+			flags[index] &= ~FlagHit;
+
+			if (hit)
+			{
+				e.OnHit({ projectile.entityIndex }, (flags[index] & FlagHitVertical) != 0);
+			}
 
-		entity.position = projectile->position;
+			if (!hit && e.OnUpdate)
+			{
+				e.OnUpdate({ projectile.entityIndex });
+			}
+
+			if (!hit && e.OnExpire && timers[index] <= 0.0f && (flags[index] & FlagExpire))
+			{
+				flags[index] &= ~FlagExpire;
+				e.OnExpire({ projectile.entityIndex });
+			}
+
+			//Callbacks can spawn entities which may reallocate entities, so don't hold a reference across them
+			if (projectile.entityIndex != U32_MAX) { entities[projectile.entityIndex].position = { positionX[index], positionY[index] }; }
+		}
 	}
 
 	return false;
@@ -96,35 +190,152 @@ bool Projectile::Render(CommandBuffer commandBuffer)
 	return false;
 }
 
-void Projectile::Simulate()
+void Projectile::Integrate(U32 start, U32 end, F32 dt)
 {
-	F32 dt = (F32)Time::DeltaTimeStable();
+	ZoneScopedN("Projectile Integrate");
 
-	timer -= dt;
-	Vector2 dir = velocity.Normalized();
+	F32* vx = velocityX.Data();
+	F32* vy = velocityY.Data();
+	F32* dx = deltaX.Data();
+	F32* dy = deltaY.Data();
+	F32* t = timers.Data();
+	const F32* acc = accelerations.Data();
+	const F32* grav = gravities.Data();
 
-	velocity += (dir * acceleration - Vector2{ 0.0f, gravity }) * dt;
-	Vector2 frameVelocity = velocity * dt;
-	Vector2 target = position + frameVelocity;
-	Collision collision;
+	U32 i = start;
 
-	if (collision = Physics::CheckCollision(collider + position + Vector2{ frameVelocity.x, 0.0f }))
+#ifdef NH_PROJECTILE_SSE
+	__m128 delta = _mm_set1_ps(dt);
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+
+	for (; i + 4 <= end; i += 4)
 	{
-		hit = true;
-		hitVertical = false;
+		__m128 x = _mm_loadu_ps(vx + i);
+		__m128 y = _mm_loadu_ps(vy + i);
+
+		//velocity += (velocity.Normalized() * acceleration - { 0, gravity }) * dt, zero length velocities get no acceleration
+		__m128 lengthSq = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+		__m128 nonZero = _mm_cmpgt_ps(lengthSq, zero);
+		__m128 inverse = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(lengthSq)), nonZero);
+		__m128 scale = _mm_mul_ps(_mm_mul_ps(inverse, _mm_loadu_ps(acc + i)), delta);
+
+		x = _mm_add_ps(x, _mm_mul_ps(x, scale));
+		y = _mm_sub_ps(_mm_add_ps(y, _mm_mul_ps(y, scale)), _mm_mul_ps(_mm_loadu_ps(grav + i), delta));
+
+		_mm_storeu_ps(vx + i, x);
+		_mm_storeu_ps(vy + i, y);
+		_mm_storeu_ps(dx + i, _mm_mul_ps(x, delta));
+		_mm_storeu_ps(dy + i, _mm_mul_ps(y, delta));
+		_mm_storeu_ps(t + i, _mm_sub_ps(_mm_loadu_ps(t + i), delta));
 	}
-	else
+#endif
+
+	for (; i < end; ++i)
 	{
-		position.x = target.x;
+		F32 lengthSq = vx[i] * vx[i] + vy[i] * vy[i];
+		F32 scale = lengthSq > 0.0f ? acc[i] * dt / Math::Sqrt(lengthSq) : 0.0f;
+
+		vx[i] += vx[i] * scale;
+		vy[i] += vy[i] * scale - grav[i] * dt;
+		dx[i] = vx[i] * dt;
+		dy[i] = vy[i] * dt;
+		t[i] -= dt;
 	}
+}
 
-	if (collision = Physics::CheckCollision(collider + position + Vector2{ 0.0f, frameVelocity.y }))
+void Projectile::Resolve()
+{
+	ZoneScopedN("Projectile Collisions");
+
+	U32 count = (U32)active.Size();
+
+	for (U32 j = 0; j < count; ++j)
 	{
-		hit = true;
-		hitVertical = true;
+		U32 i = active[j];
+		F32 x = positionX[i];
+		F32 y = positionY[i];
+
+		queries[j] = { { x + extentX[i], y + extentY[i] }, { x - extentX[i], y - extentY[i] } };
+		displacements[j] = { deltaX[i], deltaY[i] };
 	}
-	else
+
+	//The whole move is swept at once, so fast projectiles can't skip over thin tiles between frames
+	Physics::ShapeCasts(queries.Data(), displacements.Data(), count, results.Data(), collisionMask);
+
+	for (U32 j = 0; j < count; ++j)
 	{
-		position.y = target.y;
+		U32 i = active[j];
+		const RaycastHit& hit = results[j];
+
+		if (hit)
+		{
+			positionX[i] = hit.point.x;
+			positionY[i] = hit.point.y;
+
+			flags[i] |= FlagHit;
+			if (hit.normal.y != 0.0f) { flags[i] |= FlagHitVertical; }
+			else { flags[i] &= ~FlagHitVertical; }
+		}
+		else
+		{
+			positionX[i] += deltaX[i];
+			positionY[i] += deltaY[i];
+		}
 	}
+}
+
+U32 Projectile::Index() const
+{
+	return (U32)(this - components.Data());
+}
+
+void Projectile::SetCollisionMask(U32 mask)
+{
+	collisionMask = mask;
+}
+
+Vector2 Projectile::Position() const
+{
+	U32 index = Index();
+	return { positionX[index], positionY[index] };
+}
+
+Vector2 Projectile::Velocity() const
+{
+	U32 index = Index();
+	return { velocityX[index], velocityY[index] };
+}
+
+void Projectile::SetVelocity(const Vector2& velocity)
+{
+	U32 index = Index();
+	velocityX[index] = velocity.x;
+	velocityY[index] = velocity.y;
+}
+
+F32 Projectile::Timer() const
+{
+	return timers[Index()];
+}
+
+AABB Projectile::Collider() const
+{
+	U32 index = Index();
+	return { { extentX[index], extentY[index] }, { -extentX[index], -extentY[index] } };
+}
+
+Event<const EntityRef&, bool>& Projectile::OnHit()
+{
+	return events[Index()].OnHit;
+}
+
+Event<const EntityRef&>& Projectile::OnExpire()
+{
+	return events[Index()].OnExpire;
+}
+
+Event<const EntityRef&>& Projectile::OnUpdate()
+{
+	return events[Index()].OnUpdate;
 }
\ No newline at end of file
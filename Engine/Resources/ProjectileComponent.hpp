@@ -5,37 +5,96 @@
 #include "Math/Physics.hpp"
 #include "Core/Events.hpp"
 
-class NH_API Projectile
+struct ProjectileEvents
 {
-public:
-	AABB collider;
-
-	Vector2 position;
-	Vector2 velocity;
-	F32 acceleration = 0.0f;
-	F32 gravity = 0.0f;
-	F32 timer = 0.0f;
-	bool expire = false;
-	bool hit = false;
-	bool hitVertical = false;
 	Event<const EntityRef&, bool> OnHit;
 	Event<const EntityRef&> OnExpire;
 	Event<const EntityRef&> OnUpdate;
+};
+
+/// <summary>
+/// Projectile state is stored as a struct of arrays indexed by component index, the per-frame hot data (position, velocity, timer, extents)
+/// is integrated in one vectorized pass and collisions are resolved in one batched sweep, events are kept apart since few projectiles use them
+/// </summary>
+class NH_API Projectile
+{
+public:
+	static constexpr U32 MaxProjectiles = 100000;
+
+	struct Prototype
+	{
+		Vector2 velocity = Vector2::Zero;
+		F32 duration = 0.0f;
+		F32 acceleration = 0.0f;
+		F32 gravity = 0.0f;
+	};
 
 	static bool Initialize();
 	static bool Shutdown();
 
 	static ComponentRef<Projectile> AddTo(const EntityRef& entity, const Vector2& velocity, F32 duration = 0.0f, F32 acceleration = 0.0f, F32 gravity = 0.0f);
+	static void AddToBatch(const U32* entityIds, U32 count, const Prototype& prototype);
 	static void RemoveFrom(const EntityRef& entity);
 
+	/// <summary>
+	/// Layers every projectile collides with, see CollisionFilter
+	/// </summary>
+	static void SetCollisionMask(U32 mask);
+
+	Vector2 Position() const;
+	Vector2 Velocity() const;
+	void SetVelocity(const Vector2& velocity);
+	F32 Timer() const;
+	AABB Collider() const;
+
+	Event<const EntityRef&, bool>& OnHit();
+	Event<const EntityRef&>& OnExpire();
+	Event<const EntityRef&>& OnUpdate();
+
 private:
+	enum Flags : U8
+	{
+		FlagExpire = 1 << 0,
+		FlagHit = 1 << 1,
+		FlagHitVertical = 1 << 2
+	};
+
 	static bool Update(Camera& camera, Vector<Entity>& entities);
 	static bool Render(CommandBuffer commandBuffer);
 
-	void Simulate();
+	static void Setup(U32 index, const Entity& entity, const Vector2& velocity, F32 duration, F32 acceleration, F32 gravity);
+	static void Integrate(U32 start, U32 end, F32 dt);
+	static void Resolve();
+
+	U32 Index() const;
+
+	//Hot data
+	static Vector<F32> positionX;
+	static Vector<F32> positionY;
+	static Vector<F32> velocityX;
+	static Vector<F32> velocityY;
+	static Vector<F32> deltaX;
+	static Vector<F32> deltaY;
+	static Vector<F32> accelerations;
+	static Vector<F32> gravities;
+	static Vector<F32> timers;
+	static Vector<F32> extentX;
+	static Vector<F32> extentY;
+	static Vector<U8> flags;
+
+	//Cold data
+	static Vector<ProjectileEvents> events;
+
+	//Per-frame scratch for batched queries
+	static Vector<U32> active;
+	static Vector<AABB> queries;
+	static Vector<Vector2> displacements;
+	static Vector<RaycastHit> results;
+	static U32 collisionMask;
 
 	static bool initialized;
 
 	COMPONENT(Projectile);
 	friend struct EntityRef;
+	friend class Benchmarks;
 };
\ No newline at end of file
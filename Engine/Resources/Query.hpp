@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Entity.hpp"
+
+#include "Containers/Vector.hpp"
+
+/// <summary>
+/// A cached view over every entity that has all of the given components, rows are rebuilt only when one of the component pools changes
+/// There is a row for every Primary component, entities with several components of another type are joined with the first of them
+/// </summary>
+template<class Primary, class... Others>
+struct ComponentQuery
+{
+	static constexpr U32 ComponentCount = 1 + sizeof...(Others);
+
+	struct Row
+	{
+		U32 entityId;
+		U32 indices[ComponentCount];
+	};
+
+	/// <summary>
+	/// Rebuilds the rows if any of the component pools has changed since the last call
+	/// </summary>
+	void Refresh();
+
+	/// <summary>
+	/// Calls function with (EntityRef, Primary&, Others&...) for every matching entity
+	/// </summary>
+	template<class Function> void ForEach(Function&& function);
+
+	/// <summary>
+	/// Calls function for every matching entity in a single chunk, chunks don't overlap so they can be handed to separate workers
+	/// </summary>
+	/// <param name="chunk:">The index of the chunk, must be less than ChunkCount(chunkSize)</param>
+	/// <param name="chunkSize:">The amount of rows per chunk</param>
+	template<class Function> void ForEachInChunk(U32 chunk, U32 chunkSize, Function&& function);
+
+	U32 ChunkCount(U32 chunkSize) const;
+	U32 Size() const;
+	const Row* Rows() const;
+
+private:
+	template<U64... Indices>
+	void Refresh(IndexSequence<Indices...>);
+	template<class Function, U64... Indices>
+	void Invoke(const Row& row, Function& function, IndexSequence<Indices...>);
+
+	Vector<Row> rows;
+	U32 versions[ComponentCount]{};
+	bool built = false;
+};
+
+template<class Primary, class... Others>
+inline void ComponentQuery<Primary, Others...>::Refresh()
+{
+	Refresh(MakeIndexSequence<sizeof...(Others)>{});
+}
+
+template<class Primary, class... Others>
+template<U64... Indices>
+inline void ComponentQuery<Primary, Others...>::Refresh(IndexSequence<Indices...>)
+{
+	U32 current[ComponentCount] = { Primary::Version(), Others::Version()... };
+
+	bool changed = !built;
+	for (U32 i = 0; i < ComponentCount; ++i) { changed |= current[i] != versions[i]; versions[i] = current[i]; }
+
+	if (!changed) { return; }
+
+	built = true;
+	rows.Clear();
+
+	U32 slotCount = Primary::SlotCount();
+	for (U32 i = 0; i < slotCount; ++i)
+	{
+		U32 entityId = Primary::Get(i)->EntityIndex();
+		if (entityId == U32_MAX) { continue; }
+
+		Row row{ entityId, { i, Others::IndexOf(entityId)... } };
+
+		bool match = true;
+		for (U32 j = 1; j < ComponentCount; ++j) { match &= row.indices[j] != U32_MAX; }
+
+		if (match) { rows.Push(row); }
+	}
+}
+
+template<class Primary, class... Others>
+template<class Function, U64... Indices>
+inline void ComponentQuery<Primary, Others...>::Invoke(const Row& row, Function& function, IndexSequence<Indices...>)
+{
+	function(EntityRef{ row.entityId }, *Primary::Get(row.indices[0]), *Others::Get(row.indices[Indices + 1])...);
+}
+
+template<class Primary, class... Others>
+template<class Function>
+inline void ComponentQuery<Primary, Others...>::ForEach(Function&& function)
+{
+	Refresh();
+
+	for (const Row& row : rows) { Invoke(row, function, MakeIndexSequence<sizeof...(Others)>{}); }
+}
+
+template<class Primary, class... Others>
+template<class Function>
+inline void ComponentQuery<Primary, Others...>::ForEachInChunk(U32 chunk, U32 chunkSize, Function&& function)
+{
+	U64 start = (U64)chunk * chunkSize;
+	U64 end = start + chunkSize < rows.Size() ? start + chunkSize : rows.Size();
+
+	for (U64 i = start; i < end; ++i) { Invoke(rows[i], function, MakeIndexSequence<sizeof...(Others)>{}); }
+}
+
+template<class Primary, class... Others>
+inline U32 ComponentQuery<Primary, Others...>::ChunkCount(U32 chunkSize) const
+{
+	return (U32)((rows.Size() + chunkSize - 1) / chunkSize);
+}
+
+template<class Primary, class... Others>
+inline U32 ComponentQuery<Primary, Others...>::Size() const
+{
+	return (U32)rows.Size();
+}
+
+template<class Primary, class... Others>
+inline const typename ComponentQuery<Primary, Others...>::Row* ComponentQuery<Primary, Others...>::Rows() const
+{
+	return rows.Data();
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "RigidBodyComponent.hpp"
+
+#include "World.hpp"
+
+Vector<RigidBody> RigidBody::components(1000, {});
+Freelist RigidBody::freeComponents(1000);
+Vector<U32> RigidBody::entityLookup;
+U32 RigidBody::version = 0;
+bool RigidBody::initialized = false;
+
+bool RigidBody::Initialize()
+{
+	if (!initialized)
+	{
+		World::UpdateFns += Update;
+		World::RenderFns += Render;
+
+		initialized = true;
+	}
+
+	return false;
+}
+
+bool RigidBody::Shutdown()
+{
+	if (initialized) { initialized = false; }
+
+	return false;
+}
+
+ComponentRef<RigidBody> RigidBody::AddTo(EntityRef entity, BodyInfo info)
+{
+	U32 instanceId;
+	RigidBody& rigidBody = Create(instanceId, entity.EntityId());
+
+	info.position = entity->position;
+	rigidBody.body = Physics::CreateBody(info);
+
+	return { entity.EntityId(), instanceId };
+}
+
+void RigidBody::RemoveFrom(const EntityRef& entity)
+{
+	ComponentRef<RigidBody> rigidBody = GetRef(entity);
+	if (rigidBody)
+	{
+		Physics::DestroyBody(rigidBody->body);
+		rigidBody->body = U32_MAX;
+
+		Destroy(*rigidBody);
+	}
+}
+
+const Vector2& RigidBody::Velocity() const
+{
+	return Physics::BodyVelocity(body);
+}
+
+void RigidBody::SetVelocity(const Vector2& velocity)
+{
+	Physics::SetBodyVelocity(body, velocity);
+}
+
+void RigidBody::ApplyImpulse(const Vector2& impulse)
+{
+	Physics::ApplyImpulse(body, impulse);
+}
+
+void RigidBody::ApplyForce(const Vector2& force)
+{
+	Physics::ApplyForce(body, force);
+}
+
+bool RigidBody::Awake() const
+{
+	return Physics::BodyAwake(body);
+}
+
+bool RigidBody::Update(Camera& camera, Vector<Entity>& entities)
+{
+	for (const RigidBody& rigidBody : components)
+	{
+		if (rigidBody.entityIndex == U32_MAX) { continue; }
+
+		entities[rigidBody.entityIndex].position = Physics::BodyPosition(rigidBody.body);
+	}
+
+	return false;
+}
+
+bool RigidBody::Render(CommandBuffer commandBuffer)
+{
+	return false;
+}
\ No newline at end of file
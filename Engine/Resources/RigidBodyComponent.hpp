@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Component.hpp"
+
+#include "Math/Physics.hpp"
+
+/// <summary>
+/// Hands an entity's position over to the physics solver, the entity follows its body every frame
+/// </summary>
+class NH_API RigidBody
+{
+public:
+	static bool Initialize();
+	static bool Shutdown();
+
+	/// <summary>
+	/// The body is placed at the entity's position, info.position is ignored
+	/// </summary>
+	static ComponentRef<RigidBody> AddTo(EntityRef entity, BodyInfo info = {});
+	static void RemoveFrom(const EntityRef& entity);
+
+	const Vector2& Velocity() const;
+	void SetVelocity(const Vector2& velocity);
+	void ApplyImpulse(const Vector2& impulse);
+	void ApplyForce(const Vector2& force);
+	bool Awake() const;
+
+private:
+	static bool Update(Camera& camera, Vector<Entity>& entities);
+	static bool Render(CommandBuffer commandBuffer);
+
+	U32 body = U32_MAX;
+
+	static bool initialized;
+
+	COMPONENT(RigidBody);
+	friend struct EntityRef;
+};
\ No newline at end of file
@@ -3,15 +3,21 @@
 #include "Rendering/VulkanInclude.hpp"
 
 #include "Resources.hpp"
+#include "World.hpp"
 
 #include "Rendering/Renderer.hpp"
 
+#include "tracy/Tracy.hpp"
+
 Material Sprite::spriteMaterial;
 Shader Sprite::spriteVertexShader;
 Shader Sprite::spriteFragmentShader;
 Vector<SpriteInstance> Sprite::spriteInstances(10000);
+DirtyRanges Sprite::dirtyInstances;
 Vector<Sprite> Sprite::components(10000, {});
 Freelist Sprite::freeComponents(10000);
+Vector<U32> Sprite::entityLookup;
+U32 Sprite::version = 0;
 bool Sprite::initialized = false;
 
 bool Sprite::Initialize()
@@ -83,6 +89,7 @@ bool Sprite::Shutdown()
 		spriteVertexShader.Destroy();
 		spriteFragmentShader.Destroy();
 		spriteMaterial.Destroy();
+		dirtyInstances.Destroy();
 	}
 
 	return false;
@@ -90,26 +97,31 @@ bool Sprite::Shutdown()
 
 bool Sprite::Update(Camera& camera, Vector<Entity>& entities)
 {
-	int i = 0;
-	for (Sprite& sprite : components)
+	ZoneScopedN("Sprite Update");
+
+	World::Query<Sprite>().ForEach([&](const EntityRef& ref, Sprite& sprite)
 	{
-		if (sprite.entityIndex == U32_MAX) { continue; }
-		const Entity& entity = entities[sprite.entityIndex];
+		const Entity& entity = entities[ref.EntityId()];
 		SpriteInstance& instance = spriteInstances[sprite.instanceIndex];
 
+		if (instance.position == entity.position && instance.scale == entity.scale &&
+			instance.rotation.x == entity.rotation.x && instance.rotation.y == entity.rotation.y) { return; }
+
 		instance.position = entity.position;
 		instance.scale = entity.scale;
 		instance.rotation = entity.rotation;
-		++i;
-	}
+		dirtyInstances.Mark(sprite.instanceIndex);
+	});
 
 	spriteMaterial.ClearInstances();
 
 	if (spriteInstances.Size())
 	{
-		spriteMaterial.UploadInstances(spriteInstances.Data(), (U32)(spriteInstances.Size() * sizeof(SpriteInstance)), 0);
+		spriteMaterial.UploadInstanceRanges(spriteInstances.Data(), (U32)spriteInstances.Size(), dirtyInstances);
 	}
 
+	dirtyInstances.Clear();
+
 	return false;
 }
 
@@ -125,8 +137,7 @@ ComponentRef<Sprite> Sprite::AddTo(const EntityRef& entity, const ResourceRef<Te
 	if (freeComponents.Full()) { Logger::Error("Max Sprite Instances Reached!"); return nullptr; }
 
 	U32 instanceId;
-	Sprite& sprite = Create(instanceId);
-	sprite.entityIndex = entity.EntityId();
+	Sprite& sprite = Create(instanceId, entity.EntityId());
 	sprite.instanceIndex = instanceId;
 	
 	SpriteInstance& instance = instanceId == spriteInstances.Size() ? spriteInstances.Push({}) : spriteInstances[instanceId];
@@ -136,10 +147,39 @@ ComponentRef<Sprite> Sprite::AddTo(const EntityRef& entity, const ResourceRef<Te
 	instance.instTexcoordScale = textureScale;
 	instance.textureIndex = texture.Handle();
 	instance.spriteIndex = instanceId;
+	dirtyInstances.Mark(instanceId);
 
 	return { entity.EntityId(), instanceId };
 }
 
+void Sprite::AddToBatch(const U32* entityIds, U32 count, const Prototype& prototype)
+{
+	Vector<U32> indexStorage(count);
+	U32* indices = indexStorage.Data();
+	U32 created = CreateBatch(entityIds, count, indices);
+	if (created < count) { Logger::Error("Max Sprite Instances Reached!"); }
+
+	SpriteInstance instance{};
+	instance.instColor = prototype.color;
+	instance.instTexcoord = prototype.textureCoord;
+	instance.instTexcoordScale = prototype.textureScale;
+	instance.textureIndex = prototype.texture.Handle();
+
+	U32 last = 0;
+	for (U32 i = 0; i < created; ++i) { last = Math::Max(last, indices[i]); }
+	if (created && last >= spriteInstances.Size()) { spriteInstances.Resize(last + 1); }
+
+	for (U32 i = 0; i < created; ++i)
+	{
+		U32 index = indices[i];
+		components[index].instanceIndex = index;
+
+		instance.spriteIndex = index;
+		spriteInstances[index] = instance;
+		dirtyInstances.Mark(index);
+	}
+}
+
 void Sprite::RemoveFrom(const EntityRef& entity)
 {
 	 ComponentRef<Sprite> sprite = GetRef(entity);
@@ -147,6 +187,7 @@ void Sprite::RemoveFrom(const EntityRef& entity)
 	 {
 		 spriteInstances[sprite->instanceIndex].textureIndex = U16_MAX;
 		 spriteInstances[sprite->instanceIndex].scale = Vector2::Zero;
+		 dirtyInstances.Mark(sprite->instanceIndex);
 
 		 Destroy(*sprite);
 	 }
@@ -155,6 +196,7 @@ void Sprite::RemoveFrom(const EntityRef& entity)
 void Sprite::SetColor(const Vector4& color)
 {
 	spriteInstances[instanceIndex].instColor = color;
+	dirtyInstances.Mark(instanceIndex);
 }
 
 void Sprite::SetTexture(const ResourceRef<Texture>& texture, const Vector2& textureCoord, const Vector2& textureScale)
@@ -162,4 +204,5 @@ void Sprite::SetTexture(const ResourceRef<Texture>& texture, const Vector2& text
 	spriteInstances[instanceIndex].textureIndex = texture.Handle();
 	spriteInstances[instanceIndex].instTexcoord = textureCoord;
 	spriteInstances[instanceIndex].instTexcoordScale = textureScale;
+	dirtyInstances.Mark(instanceIndex);
 }
\ No newline at end of file
@@ -24,10 +24,19 @@ struct SpriteInstance
 class NH_API Sprite
 {
 public:
+	struct Prototype
+	{
+		ResourceRef<Texture> texture = nullptr;
+		Vector4 color = Vector4::One;
+		Vector2 textureCoord = Vector2::Zero;
+		Vector2 textureScale = Vector2::One;
+	};
+
 	static bool Initialize();
 	static bool Shutdown();
 
 	static ComponentRef<Sprite> AddTo(const EntityRef& entity, const ResourceRef<Texture>& texture = nullptr, const Vector4& color = Vector4::One, const Vector2& textureCoord = Vector2::Zero, const Vector2& textureScale = Vector2::One);
+	static void AddToBatch(const U32* entityIds, U32 count, const Prototype& prototype);
 	static void RemoveFrom(const EntityRef& entity);
 
 	void SetColor(const Vector4& color);
@@ -43,9 +52,11 @@ private:
 	static Shader spriteVertexShader;
 	static Shader spriteFragmentShader;
 	static Vector<SpriteInstance> spriteInstances;
+	static DirtyRanges dirtyInstances;
 	static bool initialized;
 
 	COMPONENT(Sprite);
 
 	friend struct EntityRef;
+	friend class Benchmarks;
 };
\ No newline at end of file
@@ -0,0 +1,375 @@
+#include "TileGrid.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Logger.hpp"
+#include "Platform/Memory.hpp"
+
+//nhtm layout: "NHTM", version, width, height, chunk size, one ChunkEntry per chunk row by row, then the chunk data
+static constexpr U32 TilemapVersion = MakeVersionNumber(1, 0, 0);
+
+TileGrid::~TileGrid()
+{
+	Destroy();
+}
+
+void TileGrid::Create(const Vector2Int& size)
+{
+	Destroy();
+
+	dimensions = size;
+	chunkCount = { (size.x + ChunkSize - 1) >> ChunkShift, (size.y + ChunkSize - 1) >> ChunkShift };
+	chunks.Resize((U64)chunkCount.x * chunkCount.y, UniformFlag | (U32)TileType::Air);
+}
+
+void TileGrid::Destroy()
+{
+	chunks.Destroy();
+	blocks.Destroy();
+	freeBlocks.Destroy();
+	dirtyChunks.Destroy();
+
+	dimensions = Vector2Int::Zero;
+	chunkCount = Vector2Int::Zero;
+}
+
+bool TileGrid::Set(I32 x, I32 y, TileType type)
+{
+	if ((U32)x >= (U32)dimensions.x || (U32)y >= (U32)dimensions.y) { return false; }
+
+	U32 index = (x >> ChunkShift) + (y >> ChunkShift) * chunkCount.x;
+	U32 chunk = chunks[index];
+
+	if (chunk & UniformFlag)
+	{
+		TileType uniform = (TileType)(chunk & 0xFF);
+		if (uniform == type) { return false; }
+
+		U32 block = AllocateBlock();
+		TileType* tiles = blocks.Data() + (U64)block * ChunkArea;
+		for (I32 i = 0; i < ChunkArea; ++i) { tiles[i] = uniform; }
+
+		chunk = block | (chunk & DirtyFlag);
+	}
+
+	TileType& tile = blocks[(U64)(chunk & BlockMask) * ChunkArea + (x & (ChunkSize - 1)) + (y & (ChunkSize - 1)) * ChunkSize];
+	if (tile == type) { return false; }
+
+	tile = type;
+
+	if (!(chunk & DirtyFlag))
+	{
+		chunk |= DirtyFlag;
+		dirtyChunks.Push(index);
+	}
+
+	chunks[index] = chunk;
+
+	return true;
+}
+
+bool TileGrid::Uniform(I32 chunkX, I32 chunkY, TileType& type) const
+{
+	if ((U32)chunkX >= (U32)chunkCount.x || (U32)chunkY >= (U32)chunkCount.y)
+	{
+		type = TileType::Air;
+		return true;
+	}
+
+	U32 chunk = chunks[chunkX + chunkY * chunkCount.x];
+	if (!(chunk & UniformFlag)) { return false; }
+
+	type = (TileType)(chunk & 0xFF);
+	return true;
+}
+
+const Vector2Int& TileGrid::Dimensions() const
+{
+	return dimensions;
+}
+
+const Vector2Int& TileGrid::ChunkCount() const
+{
+	return chunkCount;
+}
+
+const Vector<U32>& TileGrid::DirtyChunks() const
+{
+	return dirtyChunks;
+}
+
+void TileGrid::CleanChunks()
+{
+	for (U32 index : dirtyChunks)
+	{
+		U32& chunk = chunks[index];
+		chunk &= ~DirtyFlag;
+
+		if (chunk & UniformFlag) { continue; }
+
+		const TileType* tiles = blocks.Data() + (U64)chunk * ChunkArea;
+
+		I32 i = 1;
+		while (i < ChunkArea && tiles[i] == tiles[0]) { ++i; }
+
+		if (i == ChunkArea)
+		{
+			freeBlocks.Push(chunk);
+			chunk = UniformFlag | (U32)tiles[0];
+		}
+	}
+
+	dirtyChunks.Clear();
+}
+
+U64 TileGrid::MemoryUsage() const
+{
+	return chunks.Capacity() * sizeof(U32) + blocks.Capacity() * sizeof(TileType) + freeBlocks.Capacity() * sizeof(U32) + dirtyChunks.Capacity() * sizeof(U32);
+}
+
+U32 TileGrid::AllocateBlock()
+{
+	U32 block;
+	if (!freeBlocks.Empty())
+	{
+		freeBlocks.Pop(block);
+		return block;
+	}
+
+	block = (U32)(blocks.Size() / ChunkArea);
+
+	U64 size = blocks.Size() + ChunkArea;
+	if (size > blocks.Capacity()) { blocks.Reserve(Math::Max(size, blocks.Capacity() * 2)); }
+	blocks.Resize(size);
+
+	return block;
+}
+
+bool TileGrid::Save(const String& path) const
+{
+	Vector<ChunkEntry> table;
+	table.Resize(chunks.Size());
+
+	Vector<U8> data;
+	U8 encoded[ChunkArea * 2];
+
+	for (U32 i = 0; i < chunks.Size(); ++i)
+	{
+		U32 chunk = chunks[i];
+		if (chunk & UniformFlag)
+		{
+			table[i] = { chunk & 0xFF, 0 };
+			continue;
+		}
+
+		const TileType* tiles = blocks.Data() + (U64)(chunk & BlockMask) * ChunkArea;
+
+		I32 same = 1;
+		while (same < ChunkArea && tiles[same] == tiles[0]) { ++same; }
+
+		if (same == ChunkArea)
+		{
+			table[i] = { (U32)tiles[0], 0 };
+			continue;
+		}
+
+		//Noisy chunks that don't shrink are stored as they are, a size of ChunkArea means raw tiles
+		U32 size = Encode(tiles, encoded);
+		const U8* source = encoded;
+		if (size >= ChunkArea)
+		{
+			size = ChunkArea;
+			source = (const U8*)tiles;
+		}
+
+		table[i] = { (U32)data.Size(), size };
+
+		U64 start = data.Size();
+		if (start + size > data.Capacity()) { data.Reserve(Math::Max(start + size, data.Capacity() * 2)); }
+		data.Resize(start + size);
+		CopyData(data.Data() + start, source, size);
+	}
+
+	File file(path, FILE_OPEN_RESOURCE_WRITE);
+	if (!file.Opened())
+	{
+		Logger::Error("Failed To Open File: ", path, '!');
+		return false;
+	}
+
+	file.Write("NHTM");
+	file.Write(TilemapVersion);
+	file.Write(dimensions.x);
+	file.Write(dimensions.y);
+	file.Write(ChunkSize);
+	file.Write(table.Data(), table.Size() * sizeof(ChunkEntry));
+	file.Write(data.Data(), data.Size());
+	file.Close();
+
+	return true;
+}
+
+bool TileGrid::Load(const String& path)
+{
+	Destroy();
+
+	return LoadRegion(path, Vector2Int::Zero, { I32_MAX, I32_MAX });
+}
+
+bool TileGrid::LoadRegion(const String& path, const Vector2Int& min, const Vector2Int& max)
+{
+	File file(path, FILE_OPEN_RESOURCE_READ);
+	if (!file.Opened())
+	{
+		Logger::Error("Failed To Open File: ", path, '!');
+		return false;
+	}
+
+	if (!file.ReadString().Compare("NHTM"))
+	{
+		Logger::Error("Asset '", path, "' Is Not A Nihility Tilemap!");
+		return false;
+	}
+
+	U32 version;
+	Vector2Int size;
+	I32 chunkSize;
+	file.Read(version);
+	file.Read(size.x);
+	file.Read(size.y);
+	file.Read(chunkSize);
+
+	if (version > TilemapVersion || chunkSize != ChunkSize || size.x < 0 || size.y < 0)
+	{
+		Logger::Error("Tilemap '", path, "' Has An Unsupported Version Or Chunk Size!");
+		return false;
+	}
+
+	if (size != dimensions) { Create(size); }
+
+	I32 minX = Math::Max(min.x, 0) >> ChunkShift;
+	I32 minY = Math::Max(min.y, 0) >> ChunkShift;
+	I32 maxX = Math::Min(max.x, dimensions.x - 1) >> ChunkShift;
+	I32 maxY = Math::Min(max.y, dimensions.y - 1) >> ChunkShift;
+
+	if (minX > maxX || minY > maxY) { return true; }
+
+	I64 tableStart = file.Pointer();
+	I64 dataStart = tableStart + (I64)chunks.Size() * sizeof(ChunkEntry);
+	U32 count = maxX - minX + 1;
+
+	Vector<ChunkEntry> entries;
+	entries.Resize(count);
+	Vector<U8> data;
+
+	for (I32 y = minY; y <= maxY; ++y)
+	{
+		U32 first = minX + y * chunkCount.x;
+
+		file.SeekFromStart(tableStart + (I64)first * sizeof(ChunkEntry));
+		if (file.Read(entries.Data(), count * sizeof(ChunkEntry)) != count * sizeof(ChunkEntry))
+		{
+			Logger::Error("Tilemap '", path, "' Is Truncated!");
+			return false;
+		}
+
+		//Chunks are written in order, so a row's chunks are one contiguous read
+		U32 start = U32_MAX;
+		U32 end = 0;
+		for (const ChunkEntry& entry : entries)
+		{
+			if (!entry.size) { continue; }
+
+			start = Math::Min(start, entry.offset);
+			end = Math::Max(end, entry.offset + entry.size);
+		}
+
+		if (start < end)
+		{
+			data.Resize(end - start);
+			file.SeekFromStart(dataStart + start);
+			if (file.Read(data.Data(), end - start) != end - start)
+			{
+				Logger::Error("Tilemap '", path, "' Is Truncated!");
+				return false;
+			}
+		}
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			const ChunkEntry& entry = entries[i];
+			if (!ReadChunk(first + i, entry, entry.size ? data.Data() + entry.offset - start : nullptr))
+			{
+				Logger::Error("Tilemap '", path, "' Is Corrupted!");
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TileGrid::ReadChunk(U32 index, const ChunkEntry& entry, const U8* data)
+{
+	U32 chunk = chunks[index];
+
+	if (!entry.size)
+	{
+		if (!(chunk & UniformFlag)) { freeBlocks.Push(chunk & BlockMask); }
+		chunk = UniformFlag | (entry.offset & 0xFF) | (chunk & DirtyFlag);
+	}
+	else
+	{
+		if (chunk & UniformFlag) { chunk = AllocateBlock() | (chunk & DirtyFlag); }
+		if (!Decode(data, entry.size, blocks.Data() + (U64)(chunk & BlockMask) * ChunkArea)) { return false; }
+	}
+
+	if (!(chunk & DirtyFlag))
+	{
+		chunk |= DirtyFlag;
+		dirtyChunks.Push(index);
+	}
+
+	chunks[index] = chunk;
+
+	return true;
+}
+
+U32 TileGrid::Encode(const TileType* tiles, U8* output)
+{
+	//Runs of up to 256 tiles as a type followed by the length minus one
+	U32 size = 0;
+	for (I32 i = 0; i < ChunkArea;)
+	{
+		TileType type = tiles[i];
+		I32 run = 1;
+		while (run < 256 && i + run < ChunkArea && tiles[i + run] == type) { ++run; }
+
+		output[size++] = (U8)type;
+		output[size++] = (U8)(run - 1);
+		i += run;
+	}
+
+	return size;
+}
+
+bool TileGrid::Decode(const U8* data, U32 size, TileType* tiles)
+{
+	if (size == ChunkArea)
+	{
+		CopyData(tiles, (const TileType*)data, ChunkArea);
+		return true;
+	}
+
+	I32 count = 0;
+	for (U32 i = 0; i + 1 < size; i += 2)
+	{
+		TileType type = (TileType)data[i];
+		I32 run = data[i + 1] + 1;
+		if (count + run > ChunkArea) { return false; }
+
+		for (I32 j = 0; j < run; ++j) { tiles[count + j] = type; }
+		count += run;
+	}
+
+	return count == ChunkArea;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Math/Math.hpp"
+#include "Containers/Vector.hpp"
+#include "Containers/String.hpp"
+
+enum class NH_API TileType : U8
+{
+	Air,
+	Full,
+	HalfLeft,
+	HalfRight,
+	HalfTop,
+	HalfBottom,
+	SlopeTL,
+	SlopeTR,
+	SlopeBL,
+	SlopeBR
+};
+
+/// <summary>
+/// Tiles stored as square chunks of ChunkSize tiles, every chunk starts out as a single uniform type in the chunk table
+/// and only gets a block of tiles once a tile in it differs, blocks that end up uniform again are dropped by CleanChunks,
+/// so empty sky costs four bytes per chunk no matter how large the map is
+/// </summary>
+class NH_API TileGrid
+{
+public:
+	static constexpr I32 ChunkShift = 5;
+	static constexpr I32 ChunkSize = 1 << ChunkShift;		//Tiles along each side of a chunk
+	static constexpr I32 ChunkArea = ChunkSize * ChunkSize;
+
+	~TileGrid();
+	void Create(const Vector2Int& dimensions);
+	void Destroy();
+
+	/// <returns>The tile at x, y, Air outside of the grid</returns>
+	TileType Get(I32 x, I32 y) const;
+
+	/// <returns>true if the tile changed, its chunk is then marked dirty</returns>
+	bool Set(I32 x, I32 y, TileType type);
+
+	/// <returns>true if every tile of the chunk is the same, written to type, chunks outside of the grid are uniform Air</returns>
+	bool Uniform(I32 chunkX, I32 chunkY, TileType& type) const;
+
+	const Vector2Int& Dimensions() const;
+	const Vector2Int& ChunkCount() const;
+
+	/// <summary>
+	/// Chunks with tiles set since the last CleanChunks, as chunkX + chunkY * ChunkCount().x, in the order they were first set
+	/// </summary>
+	const Vector<U32>& DirtyChunks() const;
+
+	/// <summary>
+	/// Clears the dirty chunks, the ones whose tiles all became the same go back to being uniform
+	/// </summary>
+	void CleanChunks();
+
+	/// <returns>Bytes used by the chunk table and tile blocks</returns>
+	U64 MemoryUsage() const;
+
+	/// <summary>
+	/// Writes the grid to a .nhtm file, each chunk is run length encoded on its own and found through a table,
+	/// so any region can be read back without reading the rest of the file
+	/// </summary>
+	bool Save(const String& path) const;
+
+	/// <summary>
+	/// Replaces the grid with the contents of a .nhtm file
+	/// </summary>
+	bool Load(const String& path);
+
+	/// <summary>
+	/// Reads only the chunks of a .nhtm file overlapping the tiles from min to max, inclusive, straight into their blocks,
+	/// the grid is recreated empty first if it isn't the size of the file, every chunk read is marked dirty
+	/// </summary>
+	bool LoadRegion(const String& path, const Vector2Int& min, const Vector2Int& max);
+
+private:
+	static constexpr U32 UniformFlag = 1u << 31;		//The chunk is its low byte's type, otherwise the low bits are its block
+	static constexpr U32 DirtyFlag = 1u << 30;
+	static constexpr U32 BlockMask = DirtyFlag - 1;
+
+	//Where a chunk's data is relative to the end of the table, uniform chunks have no data and keep their type in offset
+	struct ChunkEntry
+	{
+		U32 offset;
+		U32 size;
+	};
+
+	U32 AllocateBlock();
+	bool ReadChunk(U32 index, const ChunkEntry& entry, const U8* data);
+
+	static U32 Encode(const TileType* tiles, U8* output);
+	static bool Decode(const U8* data, U32 size, TileType* tiles);
+
+	Vector2Int dimensions = Vector2Int::Zero;
+	Vector2Int chunkCount = Vector2Int::Zero;
+	Vector<U32> chunks;
+	Vector<TileType> blocks;		//ChunkArea tiles per block, row by row
+	Vector<U32> freeBlocks;
+	Vector<U32> dirtyChunks;
+};
+
+inline TileType TileGrid::Get(I32 x, I32 y) const
+{
+	if ((U32)x >= (U32)dimensions.x || (U32)y >= (U32)dimensions.y) { return TileType::Air; }
+
+	U32 chunk = chunks[(x >> ChunkShift) + (y >> ChunkShift) * chunkCount.x];
+	if (chunk & UniformFlag) { return (TileType)(chunk & 0xFF); }
+
+	return blocks[(U64)(chunk & BlockMask) * ChunkArea + (x & (ChunkSize - 1)) + (y & (ChunkSize - 1)) * ChunkSize];
+}
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 Vector<TilemapCollider> TilemapCollider::components(16, {});
 Freelist TilemapCollider::freeComponents(16);
+Vector<U32> TilemapCollider::entityLookup;
+U32 TilemapCollider::version = 0;
 bool TilemapCollider::initialized = false;
 
 bool TilemapCollider::Initialize()
@@ -29,778 +31,183 @@ bool TilemapCollider::Shutdown()
 	return false;
 }
 
-ComponentRef<TilemapCollider> TilemapCollider::AddTo(EntityRef entity, const ComponentRef<Tilemap>& tilemap)
+ComponentRef<TilemapCollider> TilemapCollider::AddTo(EntityRef entity, const ComponentRef<Tilemap>& tilemap, const CollisionFilter& filter)
 {
 	U32 instanceId;
-	TilemapCollider& collider = Create(instanceId);
-	collider.entityIndex = entity.EntityId();
+	TilemapCollider& collider = Create(instanceId, entity.EntityId());
 	collider.tilemap = tilemap;
 	collider.dimensions = tilemap->GetDimensions();
 	collider.offset = (tilemap->GetOffset() - Vector2{ 0.5f, 0.5f }) * 2.0f * 1.03092783505f;
 	collider.tileSize = tilemap->GetTileSize() * 2.0f * 1.03092783505f;
-	collider.tiles = tilemap->GetTiles();
-	collider.points.Reserve(524288);
 
-	Physics::AddTilemapCollider({ entity.EntityId(), instanceId });
+	//The last row and column of chunks also own the outline along the bottom and right of the map
+	collider.chunkCount = { collider.dimensions.x / ChunkSize + 1, collider.dimensions.y / ChunkSize + 1 };
+	collider.chunks.Destroy();
+	collider.chunks.Resize(collider.chunkCount.x * collider.chunkCount.y, {});
+	collider.dirtyChunks.Clear();
+	collider.MarkDirty(Vector2Int::Zero, collider.dimensions);
+
+	collider.gridIndex = Physics::AddTilemapCollider({ entity.EntityId(), instanceId }, filter);
 
 	return { entity.EntityId(), instanceId };
 }
 
-bool TilemapCollider::Update(Camera& camera, Vector<Entity>& entities)
+void TilemapCollider::RemoveFrom(const EntityRef& entity)
 {
-	for (TilemapCollider& collider : components)
+	ComponentRef<TilemapCollider> collider = GetRef(entity);
+	if (collider)
 	{
-		if (collider.entityIndex == U32_MAX) { continue; }
-#ifdef NH_DEBUG
-		collider.GenerateCollision();
-		LineRenderer::DrawLine(collider.points, false, { 0.0f, 1.0f, 0.0f, 1.0f });
-#endif
-	}
+		collider->Detach();
 
-	return false;
+		Destroy(*collider);
+	}
 }
 
-bool TilemapCollider::Render(CommandBuffer commandBuffer)
+void TilemapCollider::Detach()
 {
-	return false;
+	if (gridIndex != U32_MAX) { Physics::RemoveTilemapCollider(gridIndex); }
+
+	tilemap = nullptr;
+	gridIndex = U32_MAX;
+	chunks.Destroy();
+	dirtyChunks.Destroy();
 }
 
-void TilemapCollider::GenerateCollision()
+bool TilemapCollider::Update(Camera& camera, Vector<Entity>& entities)
 {
-	if (tilemap->GetDirty())
+	for (TilemapCollider& collider : components)
 	{
-		tilemap->Clean();
+		if (collider.entityIndex == U32_MAX || !collider.tilemap) { continue; }
 
-		const TileType* tile = tiles;
-
-		points.Clear();
-
-		startPos = { I32_MAX, I32_MAX };
-
-		for (I32 y = 0; y < dimensions.y && startPos.x == I32_MAX; ++y)
+		//The tilemap was removed first, nothing is left to outline
+		if (collider.tilemap->EntityIndex() == U32_MAX)
 		{
-			for (I32 x = 0; x < dimensions.x; ++x, ++tile)
-			{
-				if (*tile == TileType::Full)
-				{
-					startPos = { x, y };
-					break;
-				}
-			}
+			collider.Detach();
+			continue;
 		}
 
-		if (startPos.x != I32_MAX)
+		if (collider.tilemap->GetDirty())
 		{
-			current = startPos;
-			dir = Right;
-			start = false;
-
-			position = Vector2{ (F32)startPos.x, -(F32)startPos.y } * 2.0f * 1.03092783505f + offset;
+			Vector2Int min, max;
+			collider.tilemap->GetDirtyRegion(min, max);
+			Physics::UpdateTilemapCollider(collider.gridIndex, min, max);
+			collider.MarkDirty(min, max);
 
-			points.Push({ position.x, position.y + tileSize.y });
-			points.Push({ position.x + tileSize.x, position.y + tileSize.y });
-
-			position = points.Back();
-
-			while (true)
-			{
-				switch (dir)
-				{
-				case Right: {
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-				} break;
-				case DownRight: {
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-				} break;
-				case Down: {
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-				} break;
-				case DownLeft: {
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-				} break;
-				case Left: {
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-				} break;
-				case UpLeft: {
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-				} break;
-				case Up: {
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-				} break;
-				case UpRight: {
-					if (CheckUpLeft()) { if (start) { break; } continue; }
-					if (CheckUp()) { if (start) { break; } continue; }
-					if (CheckUpRight()) { if (start) { break; } continue; }
-					if (CheckRight()) { if (start) { break; } continue; }
-					if (CheckDownRight()) { if (start) { break; } continue; }
-					if (CheckDown()) { if (start) { break; } continue; }
-					if (CheckDownLeft()) { if (start) { break; } continue; }
-					if (CheckLeft()) { if (start) { break; } continue; }
-				} break;
-				}
-
-				if (start || current == startPos)
-				{
-					switch (endDir)
-					{
-					case UpLeft: {
-						if (dir == DownRight)
-						{
-							position += Vector2{ 0.0f, -tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == Down || dir == DownLeft)
-						{
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == Left || dir == UpLeft)
-						{
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == Up || dir == UpRight)
-						{
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-					} break;
-					case Up: {
-						if (dir == Down || dir == DownLeft)
-						{
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y * 2.0f };
-							points.Push(position);
-						}
-						else if (dir == Left || dir == UpLeft)
-						{
-							position += Vector2{ 0.0f, tileSize.y * 2.0f };
-							points.Push(position);
-						}
-						else if (dir == Up || dir == UpRight)
-						{
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-					} break;
-					case UpRight: {
-						if (dir == Up || dir == UpRight)
-						{
-							position += Vector2{ tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == DownLeft)
-						{
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == Left || dir == UpLeft)
-						{
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == Right)
-						{
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-					} break;
-					case Left: {
-						if (dir == Right)
-						{
-							position += Vector2{ 0.0f, -tileSize.y };
-							points.Push(position);
-
-							position += Vector2{ -tileSize.x * 2.0f, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-						else if (dir == UpLeft || dir == Left)
-						{
-							position += Vector2{ -tileSize.x, 0.0f };
-							points.Push(position);
-
-							position += Vector2{ 0.0f, tileSize.y };
-							points.Push(position);
-						}
-					} break;
-					case Right: {
-						position += Vector2{ 0.0f, -tileSize.y };
-						points.Push(position);
-
-						position += Vector2{ -tileSize.x, 0.0f };
-						points.Push(position);
-
-						position += Vector2{ 0.0f, tileSize.y };
-						points.Push(position);
-					}
-					}
-
-					break;
-				}
-			}
+			collider.tilemap->Clean();
 		}
-	}
-}
 
-bool TilemapCollider::CheckRight()
-{
-	if ((current.x + 1) < dimensions.x)
-	{
-		if (current + Vector2Int::Right == startPos)
-		{
-			start = true;
-			endDir = Right;
-			return true;
-		}
-
-		if (tiles[(current.x + 1) + current.y * dimensions.x] == TileType::Full)
-		{
-			current += Vector2Int::Right;
-
-			if (dir == Right)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Back() = position;
-			}
-			else if (dir == UpRight || dir == Up)
-			{
-				position += Vector2{ tileSize.x * 2.0f, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == Left || dir == UpLeft)
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
+		for (U32 chunk : collider.dirtyChunks) { collider.GenerateChunk(chunk); }
+		collider.dirtyChunks.Clear();
 
-				position += Vector2{ tileSize.x * 2.0f, 0.0f };
-				points.Push(position);
-			}
-			else
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-
-			dir = Right;
-			return true;
-		}
+#ifdef NH_DEBUG
+		for (const ContourChunk& chunk : collider.chunks) { LineRenderer::DrawLines(chunk.edges, { 0.0f, 1.0f, 0.0f, 1.0f }); }
+#endif
 	}
 
 	return false;
 }
 
-bool TilemapCollider::CheckDownRight()
+bool TilemapCollider::Render(CommandBuffer commandBuffer)
 {
-	if ((current.x + 1) < dimensions.x && (current.y + 1) < dimensions.y)
-	{
-		if (current + Vector2Int::Right + Vector2Int::Up == startPos)
-		{
-			start = true;
-			endDir = DownRight;
-			return true;
-		}
-
-		if (tiles[(current.x + 1) + (current.y + 1) * dimensions.x] == TileType::Full)
-		{
-			current += Vector2Int::Right + Vector2Int::Up;
-
-			if (dir == Right || dir == DownRight)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == Down)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == UpRight || dir == Up)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == DownLeft)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == UpLeft)
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-
-			dir = DownRight;
-			return true;
-		}
-	}
-
 	return false;
 }
 
-bool TilemapCollider::CheckDown()
+U32 TilemapCollider::ChunkCount() const
 {
-	if ((current.y + 1) < dimensions.y)
-	{
-		if (current + Vector2Int::Up == startPos)
-		{
-			start = true;
-			endDir = Down;
-			return true;
-		}
-
-		if (tiles[current.x + (current.y + 1) * dimensions.x] == TileType::Full)
-		{
-			current += Vector2Int::Up;
-
-			if (dir == Down)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Back() = position;
-			}
-			else if (dir == Right || dir == DownRight)
-			{
-				position += Vector2{ 0.0f, -tileSize.y * 2.0f };
-				points.Push(position);
-			}
-			else if (dir == UpRight || dir == Up)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y * 2.0f };
-				points.Push(position);
-			}
-			else
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-
-			dir = Down;
-			return true;
-		}
-	}
-
-	return false;
+	return (U32)chunks.Size();
 }
 
-bool TilemapCollider::CheckDownLeft()
+const Vector<Vector2>& TilemapCollider::ChunkEdges(U32 chunk) const
 {
-	if ((current.x - 1) >= 0 && (current.y + 1) < dimensions.y)
-	{
-		if (current + Vector2Int::Left + Vector2Int::Up == startPos)
-		{
-			start = true;
-			endDir = DownLeft;
-			return true;
-		}
-
-		if (tiles[(current.x - 1) + (current.y + 1) * dimensions.x] == TileType::Full)
-		{
-			current += Vector2Int::Left + Vector2Int::Up;
-
-			if (dir == Down || dir == DownLeft)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-			else if (dir == Left)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-			else if (dir == UpRight)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-			else if (dir == UpLeft)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-			else
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-			}
-
-			dir = DownLeft;
-			return true;
-		}
-	}
-
-	return false;
+	return chunks[chunk].edges;
 }
 
-bool TilemapCollider::CheckLeft()
+void TilemapCollider::MarkDirty(const Vector2Int& min, const Vector2Int& max)
 {
-	if ((current.x - 1) >= 0)
-	{
-		if (current + Vector2Int::Left == startPos)
-		{
-			start = true;
-			endDir = Left;
-			return true;
-		}
+	//A tile's bottom and right edges belong to the tiles below and to the right of it
+	I32 minX = Math::Max(min.x, 0) / ChunkSize;
+	I32 minY = Math::Max(min.y, 0) / ChunkSize;
+	I32 maxX = Math::Min(max.x + 1, dimensions.x) / ChunkSize;
+	I32 maxY = Math::Min(max.y + 1, dimensions.y) / ChunkSize;
 
-		if (tiles[(current.x - 1) + current.y * dimensions.x] == TileType::Full)
+	for (I32 y = minY; y <= maxY; ++y)
+	{
+		for (I32 x = minX; x <= maxX; ++x)
 		{
-			current += Vector2Int::Left;
-
-			if (dir == Left)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Back() = position;
-			}
-			else if (dir == UpLeft)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == DownRight || dir == Right)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x * 2.0f, 0.0f };
-				points.Push(position);
-			}
-			else
+			U32 chunk = x + y * chunkCount.x;
+			if (!chunks[chunk].dirty)
 			{
-				position += Vector2{ -tileSize.x * 2.0f, 0.0f };
-				points.Push(position);
+				chunks[chunk].dirty = true;
+				dirtyChunks.Push(chunk);
 			}
-
-			dir = Left;
-			return true;
 		}
 	}
-
-	return false;
 }
 
-bool TilemapCollider::CheckUpLeft()
+bool TilemapCollider::Solid(const TileGrid& tiles, I32 x, I32 y)
 {
-	if ((current.x - 1) >= 0 && (current.y - 1) >= 0)
-	{
-		if (current + Vector2Int::Left + Vector2Int::Down == startPos)
-		{
-			start = true;
-			endDir = UpLeft;
-			return true;
-		}
-
-		if (tiles[(current.x - 1) + (current.y - 1) * dimensions.x] == TileType::Full)
-		{
-			current += Vector2Int::Left + Vector2Int::Down;
-
-			if (dir == Left || dir == UpLeft)
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == DownRight)
-			{
-				position += Vector2{ 0.0f, -tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == UpRight)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else if (dir == Up)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-			else
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-			}
-
-			dir = UpLeft;
-			return true;
-		}
-	}
-
-	return false;
+	return tiles.Get(x, y) == TileType::Full;
 }
 
-bool TilemapCollider::CheckUp()
+void TilemapCollider::GenerateChunk(U32 index)
 {
-	if ((current.y - 1) >= 0)
+	ContourChunk& chunk = chunks[index];
+	chunk.edges.Clear();
+	chunk.dirty = false;
+
+	//Contour chunks line up with tile chunks, one that's all one solidity like the chunks above and left of it owns no outline
+	const TileGrid& tiles = tilemap->GetTiles();
+	I32 chunkX = index % chunkCount.x;
+	I32 chunkY = index / chunkCount.x;
+	TileType type, above, left;
+	if (tiles.Uniform(chunkX, chunkY, type) && tiles.Uniform(chunkX, chunkY - 1, above) && tiles.Uniform(chunkX - 1, chunkY, left) &&
+		(type == TileType::Full) == (above == TileType::Full) && (type == TileType::Full) == (left == TileType::Full)) { return; }
+
+	//Tiles in this chunk, the lines it owns go one further on the far border of the map
+	I32 startX = (index % chunkCount.x) * ChunkSize;
+	I32 startY = (index / chunkCount.x) * ChunkSize;
+	I32 tilesX = Math::Min(startX + ChunkSize, dimensions.x);
+	I32 tilesY = Math::Min(startY + ChunkSize, dimensions.y);
+	I32 linesX = Math::Min(startX + ChunkSize, dimensions.x + 1);
+	I32 linesY = Math::Min(startY + ChunkSize, dimensions.y + 1);
+
+	//Horizontal lines, the top of row y separates it from row y - 1, runs stop at the chunk so neighbours never share a segment
+	for (I32 y = startY; y < linesY; ++y)
 	{
-		if (current + Vector2Int::Down == startPos)
-		{
-			start = true;
-			endDir = Up;
-			return true;
-		}
+		F32 lineY = offset.y - (y - 1) * tileSize.y;
 
-		if (tiles[current.x + (current.y - 1) * dimensions.x] == TileType::Full)
+		I32 runStart = -1;
+		for (I32 x = startX; x <= tilesX; ++x)
 		{
-			current += Vector2Int::Down;
-
-			if (dir == Up)
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-
-				points.Back() = position;
-			}
-			else if (dir == DownLeft || dir == Down)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
+			bool edge = x < tilesX && Solid(tiles, x, y) != Solid(tiles, x, y - 1);
 
-				position += Vector2{ 0.0f, tileSize.y * 2.0f };
-				points.Push(position);
-			}
-			else if (dir == Left || dir == UpLeft)
+			if (edge && runStart < 0) { runStart = x; }
+			else if (!edge && runStart >= 0)
 			{
-				position += Vector2{ 0.0f, tileSize.y * 2.0f };
-				points.Push(position);
+				chunk.edges.Push({ offset.x + runStart * tileSize.x, lineY });
+				chunk.edges.Push({ offset.x + x * tileSize.x, lineY });
+				runStart = -1;
 			}
-			else
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-
-				points.Push(position);
-			}
-
-			dir = Up;
-			return true;
 		}
 	}
 
-	return false;
-}
-
-bool TilemapCollider::CheckUpRight()
-{
-	if ((current.x + 1) < dimensions.x && (current.y - 1) >= 0)
+	//Vertical lines, the left of column x separates it from column x - 1
+	for (I32 x = startX; x < linesX; ++x)
 	{
-		if (current + Vector2Int::Right + Vector2Int::Down == startPos)
-		{
-			start = true;
-			endDir = UpRight;
-			return true;
-		}
+		F32 lineX = offset.x + x * tileSize.x;
 
-		if (tiles[(current.x + 1) + (current.y - 1) * dimensions.x] == TileType::Full)
+		I32 runStart = -1;
+		for (I32 y = startY; y <= tilesY; ++y)
 		{
-			current += Vector2Int::Right + Vector2Int::Down;
-
-			if (dir == Up || dir == UpRight)
-			{
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-			}
-			else if (dir == DownRight || dir == Right)
-			{
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-			}
-			else if (dir == DownLeft)
-			{
-				position += Vector2{ -tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
+			bool edge = y < tilesY && Solid(tiles, x, y) != Solid(tiles, x - 1, y);
 
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-			}
-			else
+			if (edge && runStart < 0) { runStart = y; }
+			else if (!edge && runStart >= 0)
 			{
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
-
-				position += Vector2{ tileSize.x, 0.0f };
-				points.Push(position);
-
-				position += Vector2{ 0.0f, tileSize.y };
-				points.Push(position);
+				chunk.edges.Push({ lineX, offset.y - (runStart - 1) * tileSize.y });
+				chunk.edges.Push({ lineX, offset.y - (y - 1) * tileSize.y });
+				runStart = -1;
 			}
-
-			dir = UpRight;
-			return true;
 		}
 	}
-
-	return false;
 }
\ No newline at end of file
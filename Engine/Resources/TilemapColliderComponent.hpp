@@ -3,6 +3,8 @@
 #include "Component.hpp"
 #include "TilemapComponent.hpp"
 
+#include "Math/Physics.hpp"
+
 struct ChainId
 {
 	I32 index;
@@ -10,49 +12,45 @@ struct ChainId
 	U16 generation;
 };
 
-class NH_API TilemapCollider
+struct ContourChunk
 {
-	enum Dir
-	{
-		Right,
-		DownRight,
-		Down,
-		DownLeft,
-		Left,
-		UpLeft,
-		Up,
-		UpRight,
-	};
+	Vector<Vector2> edges;		//Pairs of points, one pair per straight run of outline
+	bool dirty = false;
+};
 
+/// <summary>
+/// Outlines every island and hole of a tilemap, the map is split into chunks of ChunkSize tiles that each own the edges along
+/// the top and left sides of their tiles, so an edit only regenerates the chunks around it
+/// </summary>
+class NH_API TilemapCollider
+{
 public:
+	static constexpr I32 ChunkSize = TileGrid::ChunkSize;
+
 	ComponentRef<Tilemap> tilemap;
-	Vector<Vector2> points;
 	Vector2Int dimensions;
 	Vector2 offset;
 	Vector2 tileSize;
-	Vector2Int current;
-	Vector2Int startPos;
-	Vector2 position;
-	const TileType* tiles;
-	Dir dir;
-	Dir endDir;
-	bool start;
+	U32 gridIndex;
 
 	static bool Initialize();
 	static bool Shutdown();
 
-	static ComponentRef<TilemapCollider> AddTo(EntityRef entity, const ComponentRef<Tilemap>& tilemap);
+	static ComponentRef<TilemapCollider> AddTo(EntityRef entity, const ComponentRef<Tilemap>& tilemap, const CollisionFilter& filter = {});
+	static void RemoveFrom(const EntityRef& entity);
+
+	U32 ChunkCount() const;
+	const Vector<Vector2>& ChunkEdges(U32 chunk) const;
 
 private:
-	void GenerateCollision();
-	bool CheckRight();
-	bool CheckDownRight();
-	bool CheckDown();
-	bool CheckDownLeft();
-	bool CheckLeft();
-	bool CheckUpLeft();
-	bool CheckUp();
-	bool CheckUpRight();
+	void MarkDirty(const Vector2Int& min, const Vector2Int& max);
+	void GenerateChunk(U32 chunk);
+	void Detach();
+	static bool Solid(const TileGrid& tiles, I32 x, I32 y);
+
+	Vector<ContourChunk> chunks;
+	Vector<U32> dirtyChunks;
+	Vector2Int chunkCount;
 
 	static bool Update(Camera& camera, Vector<Entity>& entities);
 	static bool Render(CommandBuffer commandBuffer);
@@ -61,4 +59,5 @@ private:
 
 	COMPONENT(TilemapCollider);
 	friend struct EntityRef;
+	friend class Benchmarks;
 };
\ No newline at end of file
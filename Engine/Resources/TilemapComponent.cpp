@@ -14,8 +14,14 @@ Buffer Tilemap::tilemapData;
 Buffer Tilemap::tilesData;
 Vector<Tilemap> Tilemap::components(16, {});
 Freelist Tilemap::freeComponents(16);
+Vector<U32> Tilemap::entityLookup;
+U32 Tilemap::version = 0;
 Vector<TilemapInstance> Tilemap::instanceData;
 Vector<TilemapData> Tilemap::tilemapDatas;
+Vector<U16> Tilemap::tileHandles;
+Vector<DirtyRange> Tilemap::tileRanges;
+DirtyRanges Tilemap::dirtyInstances;
+DirtyRanges Tilemap::dirtyDatas;
 U32 Tilemap::nextOffset = 0;
 bool Tilemap::initialized = false;
 
@@ -80,9 +86,13 @@ bool Tilemap::Shutdown()
 		for (Tilemap& tilemap : components)
 		{
 			if (tilemap.entityIndex == U32_MAX) { continue; }
-			Memory::Free(&tilemap.tileArray);
+			tilemap.tiles.Destroy();
+			tilemap.uploads.Destroy();
 		}
 
+		tileHandles.Destroy();
+		tileRanges.Destroy();
+
 		tilemapData.Destroy();
 		tilesData.Destroy();
 
@@ -90,6 +100,9 @@ bool Tilemap::Shutdown()
 		tilemapFragmentShader.Destroy();
 		tilemapMaterial.Destroy();
 		tilemapDescriptor.Destroy();
+
+		dirtyInstances.Destroy();
+		dirtyDatas.Destroy();
 	}
 
 	return false;
@@ -103,21 +116,46 @@ bool Tilemap::Update(Camera& camera, Vector<Entity>& entities)
 	{
 		if (tilemap.entityIndex == U32_MAX) { continue; }
 
+		//Edited chunks that ended up all one type drop their tiles
+		tilemap.tiles.CleanChunks();
+
 		TilemapData& tmd = tilemapDatas[tilemap.instance];
 
-		Vector4Int area = Renderer::RenderSize();
+		//Tiles edited this frame go up as one range per dirty row, not the whole map
+		tilemap.uploads.Ranges(tmd.width, instanceData[tilemap.instance].tileOffset, tileRanges);
+		tilemap.uploads.Clear();
+
+		Vector2 eye = camera.Eye().xy() * (renderSize.z / 132.0f) * tilemap.parallax;
+		Vector2 offset = (Vector2{ tilemap.offset.x, -tilemap.offset.y } + ScreenOffset) * (renderSize.z / 64.0f);
+		Vector2 tileSize = tilemap.tileSize * (renderSize.z / 64.0f);
 
-		tmd.eye = camera.Eye().xy() * (renderSize.z / 132.0f) * tilemap.parallax;
-		tmd.offset = (Vector2{ tilemap.offset.x, -tilemap.offset.y } + ScreenOffset) * (renderSize.z / 64.0f);
-		tmd.tileSize = tilemap.tileSize * (renderSize.z / 64.0f);
+		if (tmd.eye == eye && tmd.offset == offset && tmd.tileSize == tileSize) { continue; }
+
+		tmd.eye = eye;
+		tmd.offset = offset;
+		tmd.tileSize = tileSize;
+		dirtyDatas.Mark(tilemap.instance);
 	}
 
 	if (instanceData.Size())
 	{
-		tilemapMaterial.UploadInstances(instanceData.Data(), (U32)(instanceData.Size() * sizeof(TilemapInstance)), 0);
-		tilemapData.UploadUniformData(tilemapDatas.Data(), (U32)(tilemapDatas.Size() * sizeof(TilemapData)), 0);
+		tilemapMaterial.UploadInstanceRanges(instanceData.Data(), (U32)instanceData.Size(), dirtyInstances);
+
+		for (const DirtyRange& range : dirtyDatas)
+		{
+			tilemapData.UploadUniformData(tilemapDatas.Data() + range.start, (range.end - range.start) * sizeof(TilemapData), range.start * sizeof(TilemapData));
+		}
+	}
+
+	if (tileRanges.Size())
+	{
+		tilesData.UploadStorageRanges(tileHandles.Data(), tileHandles.Size() * sizeof(U16), tileRanges, sizeof(U16));
+		tileRanges.Clear();
 	}
 
+	dirtyInstances.Clear();
+	dirtyDatas.Clear();
+
 	return false;
 }
 
@@ -174,8 +212,7 @@ ComponentRef<Tilemap> Tilemap::AddTo(const EntityRef& entity, U32 width, U32 hei
 	Vector4Int renderSize = Renderer::RenderSize();
 
 	U32 instanceId;
-	Tilemap& tilemap = Create(instanceId);
-	tilemap.entityIndex = entity.EntityId();
+	Tilemap& tilemap = Create(instanceId, entity.EntityId());
 	tilemap.parallax = parallax;
 	tilemap.instance = (U32)tilemapDatas.Size();
 	tilemap.tileSize = tileSize;
@@ -188,41 +225,122 @@ ComponentRef<Tilemap> Tilemap::AddTo(const EntityRef& entity, U32 width, U32 hei
 	tmd.offset = offset * (renderSize.z / 64.0f);
 	
 	instanceData.Push({ depth, nextOffset });
+	dirtyInstances.Mark(tilemap.instance);
+	dirtyDatas.Mark(tilemap.instance);
+
+	tilemap.tiles.Create({ (I32)width, (I32)height });
+
+	U64 tileCount = nextOffset + (U64)width * height;
+	if (tileCount > tileHandles.Capacity()) { tileHandles.Reserve(Math::Max(tileCount, tileHandles.Capacity() * 2)); }
+	tileHandles.Resize(tileCount);
 
-	Memory::Allocate(&tilemap.tileArray, tmd.width * tmd.height);
+	for (U64 i = nextOffset; i < tileCount; ++i) { tileHandles[i] = U16_MAX; }
 
-	U16* tiles;
-	Memory::Allocate(&tiles, tmd.width * tmd.height);
+	tilemap.uploads.Mark(Vector2Int::Zero, { (I32)width - 1, (I32)height - 1 });
 
-	for (U32 i = 0; i < tmd.width * tmd.height; ++i)
+	nextOffset = (U32)tileCount;
+
+	return { entity.EntityId(), instanceId };
+}
+
+void Tilemap::RemoveFrom(const EntityRef& entity)
+{
+	ComponentRef<Tilemap> tilemap = GetRef(entity);
+	if (tilemap)
 	{
-		tiles[i] = U16_MAX;
+		const TilemapData& tmd = tilemapDatas[tilemap->instance];
+		U32 start = instanceData[tilemap->instance].tileOffset;
+		U32 end = start + tmd.width * tmd.height;
+
+		for (U32 i = start; i < end; ++i) { tileHandles[i] = U16_MAX; }
+		tileRanges.Push({ start, end });
+
+		tilemap->tiles.Destroy();
+		tilemap->uploads.Destroy();
+		tilemap->dirty = false;
+
+		Destroy(*tilemap);
 	}
+}
 
-	tilemapData.UploadUniformData(tiles, tmd.width * tmd.height * sizeof(U16), nextOffset * sizeof(U16));
+void Tilemap::SetTile(const ResourceRef<Texture>& texture, const Vector2Int& position, TileType type)
+{
+	const TilemapData& tmd = tilemapDatas[instance];
+	const TilemapInstance& tmi = instanceData[instance];
 
-	nextOffset += tmd.width * tmd.height;
+	if (tiles.Set(position.x, position.y, type))
+	{
+		MarkDirty(position, position);
 
-	Memory::Free(&tiles);
+		tileHandles[tmi.tileOffset + position.x + position.y * tmd.width] = type == TileType::Air ? U16_MAX : texture.Handle();
+		uploads.Mark(position);
+	}
+}
 
-	return { entity.EntityId(), instanceId };
+void Tilemap::MarkDirty(const Vector2Int& min, const Vector2Int& max)
+{
+	if (!dirty)
+	{
+		dirtyMin = min;
+		dirtyMax = max;
+	}
+	else
+	{
+		dirtyMin = { Math::Min(dirtyMin.x, min.x), Math::Min(dirtyMin.y, min.y) };
+		dirtyMax = { Math::Max(dirtyMax.x, max.x), Math::Max(dirtyMax.y, max.y) };
+	}
+
+	dirty = true;
 }
 
-void Tilemap::SetTile(const ResourceRef<Texture>& texture, const Vector2Int& position, TileType type)
+bool Tilemap::Save(const String& path) const
 {
-	TilemapData& tmd = tilemapDatas[instance];
-	TilemapInstance& tmi = instanceData[instance];
+	return tiles.Save(path);
+}
 
-	if ((U32)position.x < tmd.width && (U32)position.y < tmd.height && tileArray[position.x + position.y * tmd.width] != type)
+bool Tilemap::Load(const String& path, const ResourceRef<Texture>& texture)
+{
+	return LoadRegion(path, texture, Vector2Int::Zero, { I32_MAX, I32_MAX });
+}
+
+bool Tilemap::LoadRegion(const String& path, const ResourceRef<Texture>& texture, const Vector2Int& min, const Vector2Int& max)
+{
+	const TilemapData& tmd = tilemapDatas[instance];
+	const TilemapInstance& tmi = instanceData[instance];
+	Vector2Int dimensions = { (I32)tmd.width, (I32)tmd.height };
+
+	bool loaded = tiles.LoadRegion(path, min, max);
+
+	Vector2Int start = { Math::Max(min.x, 0), Math::Max(min.y, 0) };
+	Vector2Int end = { Math::Min(max.x, dimensions.x - 1), Math::Min(max.y, dimensions.y - 1) };
+
+	//The GPU side was sized when the tilemap was added, a file of another size recreated the grid so the tilemap is cleared
+	if (tiles.Dimensions() != dimensions)
 	{
-		dirty = true;
-		U16 handle = texture.Handle();
+		Logger::Error("Tilemap '", path, "' Doesn't Match The Size Of The Tilemap It's Loaded Into!");
+		tiles.Create(dimensions);
+		start = Vector2Int::Zero;
+		end = dimensions - Vector2Int::One;
+		loaded = false;
+	}
+	else if (!loaded || start.x > end.x || start.y > end.y) { return loaded; }
 
-		U32 i = (tmi.tileOffset + position.x + position.y * tmd.width);
+	MarkDirty(start, end);
+	uploads.Mark(start, end);
+
+	U16 handle = texture.Handle();
+
+	for (I32 y = start.y; y <= end.y; ++y)
+	{
+		U16* row = tileHandles.Data() + tmi.tileOffset + y * tmd.width;
 
-		tilesData.UploadUniformData(&handle, sizeof(U16), (tmi.tileOffset + position.x + position.y * tmd.width) * sizeof(U16));
-		tileArray[position.x + position.y * tmd.width] = type;
+		for (I32 x = start.x; x <= end.x; ++x)
+		{
+			row[x] = tiles.Get(x, y) == TileType::Air ? U16_MAX : handle;
+		}
 	}
+
+	return loaded;
 }
 
 Vector2Int Tilemap::ScreenToTilemap(const Camera& camera, const Vector2& position)
@@ -251,9 +369,9 @@ const Vector2& Tilemap::GetTileSize() const
 	return tileSize;
 }
 
-const TileType* Tilemap::GetTiles() const
+const TileGrid& Tilemap::GetTiles() const
 {
-	return tileArray;
+	return tiles;
 }
 
 const TilemapData& Tilemap::GetData() const
@@ -266,6 +384,12 @@ bool Tilemap::GetDirty() const
 	return dirty;
 }
 
+void Tilemap::GetDirtyRegion(Vector2Int& min, Vector2Int& max) const
+{
+	min = dirtyMin;
+	max = dirtyMax;
+}
+
 void Tilemap::Clean()
 {
 	dirty = false;
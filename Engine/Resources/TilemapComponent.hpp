@@ -2,6 +2,9 @@
 
 #include "Component.hpp"
 #include "Material.hpp"
+#include "TileGrid.hpp"
+
+#include "Containers/DirtyRects.hpp"
 
 #include "Rendering/Camera.hpp"
 
@@ -20,21 +23,6 @@ struct TilemapInstance
 	U32 tileOffset;
 };
 
-enum class NH_API TileType
-{
-	Air,
-	Full,
-	HalfLeft,
-	HalfRight,
-	HalfTop,
-	HalfBottom,
-	SlopeTL,
-	SlopeTR,
-	SlopeBL,
-	SlopeBR
-};
-
-//TODO: saving and loading
 class NH_API Tilemap
 {
 public:
@@ -43,23 +31,53 @@ public:
 	Vector2Int GetDimensions() const;
 	const Vector2& GetOffset() const;
 	const Vector2& GetTileSize() const;
-	const TileType* GetTiles() const;
+	const TileGrid& GetTiles() const;
 	const TilemapData& GetData() const;
 	bool GetDirty() const;
+
+	/// <summary>
+	/// Gets the smallest rectangle containing every tile set since the last Clean, inclusive
+	/// </summary>
+	void GetDirtyRegion(Vector2Int& min, Vector2Int& max) const;
 	void Clean();
 
+	/// <summary>
+	/// Saves the tile types to a .nhtm file, textures aren't part of the file
+	/// </summary>
+	bool Save(const String& path) const;
+
+	/// <summary>
+	/// Loads the tile types of a .nhtm file the size of this tilemap, every tile that isn't air is drawn with texture
+	/// </summary>
+	bool Load(const String& path, const ResourceRef<Texture>& texture);
+
+	/// <summary>
+	/// Like Load but only reads the tiles from min to max, inclusive, the rest of the file is never read
+	/// </summary>
+	bool LoadRegion(const String& path, const ResourceRef<Texture>& texture, const Vector2Int& min, const Vector2Int& max);
+
 	static bool Initialize();
 	static bool Shutdown();
 
 	static ComponentRef<Tilemap> AddTo(const EntityRef& entity, U32 width, U32 height, const Vector2& offset = Vector2::Zero, const Vector2& parallax = Vector2::One, F32 depth = 0.0f, const Vector2& tileSize = Vector2::One);
 
+	/// <summary>
+	/// Frees the tiles and clears what's drawn, the tilemap's slot of the tile buffer isn't handed out again
+	/// </summary>
+	static void RemoveFrom(const EntityRef& entity);
+
 private:
 	bool dirty;
+	Vector2Int dirtyMin;
+	Vector2Int dirtyMax;
 	Vector2 parallax;
 	U32 instance;
 	Vector2 tileSize;
 	Vector2 offset;
-	TileType* tileArray;
+	TileGrid tiles;
+	DirtyRects uploads;
+
+	void MarkDirty(const Vector2Int& min, const Vector2Int& max);
 
 	static bool Update(Camera& camera, Vector<Entity>& entities);
 	static bool Render(CommandBuffer commandBuffer);
@@ -72,6 +90,10 @@ private:
 	static Buffer tilesData;
 	static Vector<TilemapInstance> instanceData;
 	static Vector<TilemapData> tilemapDatas;
+	static Vector<U16> tileHandles;
+	static Vector<DirtyRange> tileRanges;
+	static DirtyRanges dirtyInstances;
+	static DirtyRanges dirtyDatas;
 	static U32 nextOffset;
 	static bool initialized;
 
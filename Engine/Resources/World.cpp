@@ -3,6 +3,7 @@
 #include "Resources.hpp"
 
 #include "Rendering/Renderer.hpp"
+#include "Core/Logger.hpp"
 
 #include "tracy/Tracy.hpp"
 
@@ -12,7 +13,10 @@ Event<> World::InitializeFns;
 Event<> World::ShutdownFns;
 Vector<Entity> World::entities(256, {});
 Freelist World::freeEntities(256);
+Vector<U64> World::liveEntities;
 Camera World::camera;
+Vector<EntityCommandBuffer*> World::commandBuffers;
+SpinLock World::commandLock;
 
 Hashmap<StringView, void*> World::componentRegistry;
 
@@ -26,6 +30,7 @@ bool World::Initialize()
 void World::Shutdown()
 {
 	ShutdownFns();
+	Hierarchy::Shutdown();
 }
 
 void World::Update()
@@ -33,7 +38,9 @@ void World::Update()
 	ZoneScopedN("Scene");
 
 	camera.Update();
+	Hierarchy::Update(entities);
 	UpdateFns(camera, entities);
+	FlushCommands();
 }
 
 void World::Register(const StringView& name, void* init, void* shutdown, void* create)
@@ -68,6 +75,8 @@ EntityRef World::CreateEntity(Vector2 position, Vector2 scale, Quaternion2 rotat
 		index = freeEntities.GetFree();
 	}
 
+	MarkLive(index);
+
 	Entity& entity = entities[index];
 	entity.position = position;
 	entity.scale = scale;
@@ -78,6 +87,70 @@ EntityRef World::CreateEntity(Vector2 position, Vector2 scale, Quaternion2 rotat
 	return { index };
 }
 
+void World::CreateEntities(U32 count, U32* entityIds, const Vector2& position, const Vector2& scale, const Quaternion2& rotation)
+{
+	U32 obtained = freeEntities.GetFree(count, entityIds);
+
+	if (obtained < count)
+	{
+		entities.Resize(entities.Size() + (count - obtained));
+		entities.Resize(entities.Capacity());
+		freeEntities.Resize((U32)entities.Capacity());
+
+		obtained += freeEntities.GetFree(count - obtained, entityIds + obtained);
+	}
+
+	Entity prototype{ position, scale, rotation, position, rotation };
+
+	for (U32 i = 0; i < count; ++i)
+	{
+		MarkLive(entityIds[i]);
+		entities[entityIds[i]] = prototype;
+	}
+}
+
+void World::MarkLive(U32 id)
+{
+	while (liveEntities.Size() <= id / 64) { liveEntities.Push(0); }
+
+	liveEntities[id / 64] |= 1ull << (id % 64);
+}
+
+U32 World::Instantiate(const Prefab& prefab, U32 count)
+{
+	Vector<U32> entityIds;
+	return InstantiateInternal(prefab, count, entityIds);
+}
+
+U32 World::InstantiateInternal(const Prefab& prefab, U32 count, Vector<U32>& entityIds)
+{
+	ZoneScopedN("Instantiate");
+
+	U32 available = count;
+	for (const PrefabComponent& component : prefab.components)
+	{
+		available = Math::Min(available, component.available());
+	}
+
+	if (available < count)
+	{
+		Logger::Error("Prefab Instantiation Limited By Component Capacity, Spawning ", available, " Of ", count, "!");
+		count = available;
+	}
+
+	if (count == 0) { return 0; }
+
+	entityIds.Resize(count);
+	CreateEntities(count, entityIds.Data(), prefab.position, prefab.scale, prefab.rotation);
+
+	for (const PrefabComponent& component : prefab.components)
+	{
+		component.instantiate(entityIds.Data(), count, component.prototype);
+	}
+
+	return count;
+}
+
 Entity& World::GetEntity(U32 id)
 {
 	return entities[id];
@@ -85,7 +158,124 @@ Entity& World::GetEntity(U32 id)
 
 void World::DestroyEntity(const EntityRef& ref)
 {
-	freeEntities.Release(ref.EntityId());
+	U32 id = ref.EntityId();
+
+	//Deferred commands can destroy the same entity twice, releasing its id twice would hand it to two new entities
+	if (id / 64 >= liveEntities.Size() || !(liveEntities[id / 64] & (1ull << (id % 64)))) { return; }
+
+	liveEntities[id / 64] &= ~(1ull << (id % 64));
+	Hierarchy::RemoveEntity(id);
+	freeEntities.Release(id);
+}
+
+EntityCommandBuffer& World::Commands()
+{
+	thread_local EntityCommandBuffer buffer;
+
+	if (buffer.index == U32_MAX)
+	{
+		LockGuard lock(commandLock);
+		buffer.index = (U32)commandBuffers.Size();
+		commandBuffers.Push(&buffer);
+	}
+
+	return buffer;
+}
+
+struct PlaybackEntry
+{
+	U64 sortKey;
+	U64 index;
+	U64 order;
+	EntityCommand* command;
+};
+
+static bool PlaybackBefore(const PlaybackEntry& a, const PlaybackEntry& b)
+{
+	if (a.sortKey != b.sortKey) { return a.sortKey < b.sortKey; }
+	if (a.index != b.index) { return a.index < b.index; }
+	return a.order < b.order;
+}
+
+static void SortPlayback(Vector<PlaybackEntry>& entries, Vector<PlaybackEntry>& scratch)
+{
+	U64 count = entries.Size();
+	scratch.Resize(count);
+
+	PlaybackEntry* src = entries.Data();
+	PlaybackEntry* dst = scratch.Data();
+
+	for (U64 width = 1; width < count; width *= 2)
+	{
+		for (U64 start = 0; start < count; start += width * 2)
+		{
+			U64 mid = Math::Min(start + width, count);
+			U64 end = Math::Min(start + width * 2, count);
+			U64 i = start, j = mid, k = start;
+
+			while (i < mid && j < end) { dst[k++] = PlaybackBefore(src[j], src[i]) ? src[j++] : src[i++]; }
+			while (i < mid) { dst[k++] = src[i++]; }
+			while (j < end) { dst[k++] = src[j++]; }
+		}
+
+		PlaybackEntry* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if (src != entries.Data()) { memcpy(entries.Data(), src, count * sizeof(PlaybackEntry)); }
+}
+
+void World::FlushCommands()
+{
+	ZoneScopedN("Entity Commands");
+
+	static Vector<PlaybackEntry> entries;
+	static Vector<PlaybackEntry> scratch;
+	static Vector<Vector<EntityCommand>> commands;
+
+	//Commands executed during playback may record more commands, keep going until every buffer is drained
+	for (U32 pass = 0; pass < 8; ++pass)
+	{
+		entries.Clear();
+
+		{
+			LockGuard lock(commandLock);
+
+			while (commands.Size() < commandBuffers.Size()) { commands.Push({}); }
+
+			for (U32 i = 0; i < commandBuffers.Size(); ++i)
+			{
+				EntityCommandBuffer* buffer = commandBuffers[i];
+				if (!buffer || buffer->Empty()) { continue; }
+
+				Swap(commands[i], buffer->commands);
+
+				for (EntityCommand& command : commands[i])
+				{
+					entries.Push({ command.sortKey, command.index, ((U64)i << 32) | command.sequence, &command });
+				}
+			}
+
+			//Every buffer is drained, captures were destroyed as they ran so their pages can be reused
+			if (entries.Empty())
+			{
+				for (EntityCommandBuffer* buffer : commandBuffers) { if (buffer) { buffer->payloads.Reset(); } }
+				return;
+			}
+		}
+
+		SortPlayback(entries, scratch);
+
+		for (PlaybackEntry& entry : entries)
+		{
+			entry.command->execute({ entry.command->entityId }, entry.command->payload);
+		}
+
+		for (Vector<EntityCommand>& executed : commands) { executed.Clear(); }
+	}
+
+	Logger::Warn("Entity commands are still being recorded after playback, remaining commands deferred to next flush");
 }
 
 const Camera& World::GetCamera()
@@ -5,6 +5,10 @@
 #include "ResourceDefines.hpp"
 
 #include "Entity.hpp"
+#include "Query.hpp"
+#include "EntityCommandBuffer.hpp"
+#include "Prefab.hpp"
+#include "Hierarchy.hpp"
 
 #include "Rendering/Camera.hpp"
 #include "Rendering/CommandBuffer.hpp"
@@ -13,6 +17,7 @@
 #include "Containers/Hashmap.hpp"
 #include "Containers/Freelist.hpp"
 #include "Core/Events.hpp"
+#include "Multithreading/ThreadSafety.hpp"
 
 class NH_API World
 {
@@ -25,6 +30,22 @@ public:
 	static EntityRef CreateEntity(Vector2 position = Vector2::Zero, Vector2 scale = Vector2::One, Quaternion2 rotation = Quaternion2::Identity);
 	static Entity& GetEntity(U32 id);
 	static void DestroyEntity(const EntityRef& ref);
+	static void CreateEntities(U32 count, U32* entityIds, const Vector2& position = Vector2::Zero, const Vector2& scale = Vector2::One, const Quaternion2& rotation = Quaternion2::Identity);
+
+	/// <summary>
+	/// Spawns count copies of prefab, entity and component slots are reserved in one step per pool,
+	/// initializer is then called with (const EntityRef&, U32 index) for every new entity
+	/// </summary>
+	/// <returns>The amount of entities spawned, less than count if a component pool is full</returns>
+	template<class Initializer>
+	static U32 Instantiate(const Prefab& prefab, U32 count, Initializer&& initializer);
+	static U32 Instantiate(const Prefab& prefab, U32 count);
+
+	template<class... Components>
+	static ComponentQuery<Components...>& Query();
+
+	static EntityCommandBuffer& Commands();
+	static void FlushCommands();
 
 	static const Camera& GetCamera();
 	static Vector2 ScreenToWorld(const Vector2& position);
@@ -40,11 +61,17 @@ private:
 	static void Render(CommandBuffer commandBuffer);
 
 	static void Register(const StringView& name, void* init, void* shutdown, void* create);
+	static U32 InstantiateInternal(const Prefab& prefab, U32 count, Vector<U32>& entityIds);
+	static void MarkLive(U32 id);
 
 	static Vector<Entity> entities;
 	static Freelist freeEntities;
+	static Vector<U64> liveEntities;	//One bit per entity id, set while the id is handed out
 	static Camera camera;
 
+	static Vector<EntityCommandBuffer*> commandBuffers;
+	static SpinLock commandLock;
+
 	static Event<> InitializeFns;
 	static Event<> ShutdownFns;
 
@@ -53,10 +80,32 @@ private:
 	STATIC_CLASS(World);
 	friend class Renderer;
 	friend class Engine;
+	friend class EntityCommandBuffer;
+	friend class Benchmarks;
 };
 
 template<class Component>
 inline void World::RegisterComponent()
 {
 	Register(NameOf<Component>, Component::Initialize, Component::Shutdown, Component::AddTo);
+}
+
+template<class... Components>
+inline ComponentQuery<Components...>& World::Query()
+{
+	static ComponentQuery<Components...> query;
+	query.Refresh();
+
+	return query;
+}
+
+template<class Initializer>
+inline U32 World::Instantiate(const Prefab& prefab, U32 count, Initializer&& initializer)
+{
+	Vector<U32> entityIds;
+	count = InstantiateInternal(prefab, count, entityIds);
+
+	for (U32 i = 0; i < count; ++i) { initializer(EntityRef{ entityIds[i] }, i); }
+
+	return count;
 }
\ No newline at end of file